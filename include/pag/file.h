@@ -1802,12 +1802,31 @@ class PAG_API Composition {
 
   virtual bool verify() const;
 
+  /**
+   * Decodes the sequences of this composition and the compositions it references if they were
+   * deferred by lazy decoding, see File::SetLazyDecoding(), and then updates the static time ranges
+   * of this composition. Does nothing otherwise. It is called automatically the first time the
+   * composition is referenced for rendering. This method is thread-safe.
+   */
+  void decodeDeferredContent();
+
  protected:
   // Called by Codec.
   virtual void updateStaticTimeRanges();
 
+  /**
+   * Returns true if the sequences of this composition, or of the compositions it references, have
+   * not been decoded yet. It returns false while decodeDeferredContent() updates the static time
+   * ranges, since the sequences are available by then.
+   */
+  bool hasDeferredContent() const;
+
  private:
   bool staticTimeRangeUpdated = false;
+  std::shared_ptr<ByteData> deferredContent = nullptr;
+  std::atomic_bool deferredContentPending = {false};
+  // Guarded by locker, only set while decodeDeferredContent() is running.
+  bool decodingDeferredContent = false;
 
   friend class Codec;
 
@@ -2130,6 +2149,23 @@ class PAG_API File {
    */
   static std::shared_ptr<File> Load(const std::string& filePath);
 
+  /**
+   * Sets whether Load(filePath) decodes the sequences of bitmap and video compositions lazily. If
+   * true, the sequence tags are only indexed on load, and each composition decodes them the first
+   * time it is referenced for rendering. Until then, the composition is treated as having no static
+   * time ranges. Only bitmap and video sequences are deferred: the layers of vector compositions
+   * are always decoded on load, since the layer tree, the editable indices and the static time
+   * ranges of the file depend on them. Files made mostly of vector content therefore load at about
+   * the same speed either way. Lazy decoding only applies to uncompressed files. The default value
+   * is false.
+   */
+  static void SetLazyDecoding(bool enabled);
+
+  /**
+   * Returns true if Load(filePath) decodes the sequences of bitmap and video compositions lazily.
+   */
+  static bool LazyDecoding();
+
   ~File();
 
   /**
@@ -2232,6 +2268,31 @@ class PAG_API File {
  */
 int64_t PAG_API CalculateGraphicsMemory(std::shared_ptr<File> file);
 
+/**
+ * Returns the estimated CPU memory in bytes currently held by the frame caches of the layers in the
+ * file, such as the paths, glyphs and transforms created for each distinct frame.
+ */
+int64_t PAG_API CalculateFrameCacheMemory(std::shared_ptr<File> file);
+
+/**
+ * Defines the compression algorithms that can be applied to the body of a pag file when encoding.
+ */
+class PAG_API CompressionType {
+ public:
+  /**
+   * The body is stored as it is. This is the default value.
+   */
+  static const Enum None = 0;
+  /**
+   * The body is compressed by the deflate algorithm of zlib, which decodes fast.
+   */
+  static const Enum Zlib = 1;
+  /**
+   * The body is compressed by the LZMA2 algorithm, which has the best compression ratio.
+   */
+  static const Enum Lzma = 2;
+};
+
 class PAG_API Codec {
  public:
   /**
@@ -2267,6 +2328,28 @@ class PAG_API Codec {
   static std::shared_ptr<File> Decode(const void* bytes, uint32_t byteLength,
                                       const std::string& path);
 
+  /**
+   * Decode a pag file from the specified byte data. Unlike the method above, the embedded blobs of
+   * the file such as images and bitmap frames are not copied, they reference the byte data
+   * directly and keep it alive. If lazyDecoding is true, the sequences of bitmap and video
+   * compositions are decoded the first time they are referenced, while vector compositions are
+   * still decoded immediately, see File::SetLazyDecoding().
+   */
+  static std::shared_ptr<File> Decode(std::shared_ptr<ByteData> byteData, const std::string& path,
+                                      bool lazyDecoding = false);
+
+  /**
+   * Sets whether the compositions and image blocks of an uncompressed pag file are decoded in
+   * parallel on the thread pool. The decoded file is identical to the one decoded sequentially.
+   * Small files are always decoded on the calling thread. The default value is false.
+   */
+  static void SetParallelDecoding(bool enabled);
+
+  /**
+   * Returns true if the compositions and image blocks of pag files are decoded in parallel.
+   */
+  static bool ParallelDecoding();
+
   /**
    * Encode a pag file to byte data, return null if the file is null.
    */
@@ -2279,11 +2362,25 @@ class PAG_API Codec {
   static std::unique_ptr<ByteData> Encode(std::shared_ptr<File> pagFile,
                                           std::shared_ptr<PerformanceData> performanceData);
 
+  /**
+   * Encode a pag file with the corresponding performance data to byte data, and compress the body
+   * with the specified compression type. The performanceData can be null. Return null if the file
+   * is null or the compression type is not supported on current platform.
+   */
+  static std::unique_ptr<ByteData> Encode(std::shared_ptr<File> pagFile,
+                                          std::shared_ptr<PerformanceData> performanceData,
+                                          Enum compressionType);
+
   /**
    * Read the performance data from the specified byte data, return null if the byte data contains
    * no performance data.
    */
   static std::shared_ptr<PerformanceData> ReadPerformanceData(const void* bytes,
                                                               uint32_t byteLength);
+
+ private:
+  static std::shared_ptr<File> DecodeFile(const void* bytes, uint32_t byteLength,
+                                          const std::string& path,
+                                          std::shared_ptr<ByteData> sourceData, bool lazyDecoding);
 };
 }  // namespace pag
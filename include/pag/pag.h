@@ -19,6 +19,7 @@
 #pragma once
 
 #include <functional>  // for windows
+#include <future>
 #include <unordered_map>
 #include "pag/decoder.h"
 #include "pag/gpu.h"
@@ -448,7 +449,7 @@ class PAG_API PAGLayer : public Content {
   virtual Frame stretchedContentFrame() const;
   virtual int64_t durationInternal() const;
   virtual int64_t startTimeInternal() const;
-  virtual Content* getContent();
+  virtual std::shared_ptr<Content> getContent();
   virtual void invalidateCacheScale();
   virtual void onAddToStage(PAGStage* pagStage);
   virtual void onRemoveFromStage();
@@ -496,6 +497,8 @@ class PAG_API PAGLayer : public Content {
   friend class FileReporter;
 
   friend class PAGImageLayer;
+
+  friend class DamageTracker;
 };
 
 class SolidLayer;
@@ -520,7 +523,7 @@ class PAG_API PAGSolidLayer : public PAGLayer {
   void setSolidColor(const Color& value);
 
  protected:
-  Content* getContent() override;
+  std::shared_ptr<Content> getContent() override;
   bool contentModified() const override;
 
  private:
@@ -606,7 +609,7 @@ class PAG_API PAGTextLayer : public PAGLayer {
 
  protected:
   void setMatrixInternal(const Matrix& matrix) override;
-  Content* getContent() override;
+  std::shared_ptr<Content> getContent() override;
   bool contentModified() const override;
 
  private:
@@ -729,7 +732,7 @@ class PAG_API PAGImageLayer : public PAGLayer {
   int64_t getCurrentContentTime(int64_t layerTime);
   Property<float>* getContentTimeRemap();
   bool contentVisible();
-  Content* getContent() override;
+  std::shared_ptr<Content> getContent() override;
   bool contentModified() const override;
   bool cacheFilters() const override;
   void onAddToRootFile(PAGFile* pagFile) override;
@@ -769,6 +772,8 @@ class PreComposeLayer;
 
 class VectorComposition;
 
+class BoundsIndex;
+
 class PAG_API PAGComposition : public PAGLayer {
  public:
   /**
@@ -926,6 +931,8 @@ class PAG_API PAGComposition : public PAGLayer {
 
  private:
   VectorComposition* emptyComposition = nullptr;
+  BoundsIndex* childBoundsIndex = nullptr;
+  uint32_t childBoundsVersion = 0;
 
   static void FindLayers(std::function<bool(PAGLayer* pagLayer)> filterFunc,
                          std::vector<std::shared_ptr<PAGLayer>>* result,
@@ -936,9 +943,11 @@ class PAG_API PAGComposition : public PAGLayer {
                                         std::vector<std::shared_ptr<PAGLayer>>* results);
   static bool GetChildLayerAtPoint(PAGLayer* childLayer, float x, float y,
                                    std::vector<std::shared_ptr<PAGLayer>>* results);
+  static bool HasTrackMatteLayer(PAGLayer* pagLayer);
 
   bool getLayersUnderPointInternal(float x, float y,
                                    std::vector<std::shared_ptr<PAGLayer>>* results);
+  void findChildIndicesAt(float x, float y, std::vector<int>* results);
   int getLayerIndexInternal(std::shared_ptr<PAGLayer> child) const;
   void doSwapLayerAt(int index1, int index2);
   void doSetLayerIndex(std::shared_ptr<PAGLayer> pagLayer, int index);
@@ -958,6 +967,8 @@ class PAG_API PAGComposition : public PAGLayer {
   friend class PAGImageLayer;
 
   friend class FileReporter;
+
+  friend class DamageTracker;
 };
 
 class PAG_API PAGFile : public PAGComposition {
@@ -1137,10 +1148,22 @@ class Drawable {
    */
   virtual void setTimeStamp(int64_t) {
   }
+
+  /**
+   * Returns true if the pixels of the drawable stay unchanged after presenting, which allows the
+   * PAGSurface to redraw only the changed region of the next frame directly into the drawable.
+   * Otherwise, the PAGSurface keeps an extra back buffer of the same size to redraw the changed
+   * region into, and copies it to the drawable for every frame. The default is false.
+   */
+  virtual bool preservesContents() const {
+    return false;
+  }
 };
 
 class Graphic;
 
+class DamageTracker;
+
 class PAG_API PAGSurface {
  public:
   /**
@@ -1205,6 +1228,17 @@ class PAG_API PAGSurface {
    */
   bool readPixels(ColorType colorType, AlphaType alphaType, void* dstPixels, size_t dstRowBytes);
 
+  /**
+   * Starts copying pixels from current PAGSurface asynchronously and returns immediately. The GPU
+   * transfers the pixels into a pixel buffer object in the background, so the next frame can be
+   * rendered while this one is still being read back. The pixels are copied to dstPixels with
+   * specified color type, alpha type and row bytes when get() or wait() is called on the returned
+   * future, which then returns true if pixels are copied. dstPixels must stay valid until then.
+   * Falls back to a synchronous readPixels() if the GPU doesn't support pixel buffer objects.
+   */
+  std::future<bool> readPixelsAsync(ColorType colorType, AlphaType alphaType, void* dstPixels,
+                                    size_t dstRowBytes);
+
  private:
   uint32_t contentVersion = 0;
   PAGPlayer* pagPlayer = nullptr;
@@ -1212,12 +1246,16 @@ class PAG_API PAGSurface {
   std::shared_ptr<Drawable> drawable = nullptr;
   std::shared_ptr<Device> device = nullptr;
   std::shared_ptr<Surface> surface = nullptr;
+  std::shared_ptr<Surface> backBuffer = nullptr;
 
   explicit PAGSurface(std::shared_ptr<Drawable> drawable);
 
   bool draw(RenderCache* cache, std::shared_ptr<Graphic> graphic, BackendSemaphore* signalSemaphore,
-            bool autoClear = true);
+            bool autoClear = true, const DamageTracker* damageTracker = nullptr);
   bool hitTest(RenderCache* cache, std::shared_ptr<Graphic> graphic, float x, float y);
+  bool drawFrames(RenderCache* cache, size_t frameCount, int columns,
+                  const std::function<std::shared_ptr<Graphic>(size_t)>& makeGraphic,
+                  ColorType colorType, AlphaType alphaType, void* dstPixels, size_t dstRowBytes);
   Context* lockContext();
   void unlockContext();
   bool wait(const BackendSemaphore& waitSemaphore);
@@ -1403,6 +1441,31 @@ class PAG_API PAGPlayer {
    */
   bool flushAndSignalSemaphore(BackendSemaphore* signalSemaphore);
 
+  /**
+   * Renders the specified frames of the composition in one call and copies their pixels to
+   * dstPixels, which is much faster than calling setProgress(), flush() and readPixels() for each
+   * frame. The frames are laid out in a grid that has the specified number of columns, each cell
+   * has the size of the PAGSurface, and the cells are filled row by row. So dstPixels must hold
+   * (columns * surface width) x (ceil(frames.size() / columns) * surface height) pixels with the
+   * specified color type, alpha type and row bytes, a strip of frames can be read by passing 1 or
+   * frames.size() as columns. The grid can be larger than the max texture size of the GPU, it is
+   * then rendered and read back in several parts. The frames are in the frame rate of the
+   * composition, and the progress of the composition is restored after rendering. The content of
+   * the PAGSurface is not changed. Returns true if pixels are copied to dstPixels.
+   */
+  bool renderFrames(const std::vector<Frame>& frames, int columns, ColorType colorType,
+                    AlphaType alphaType, void* dstPixels, size_t dstRowBytes);
+
+  /**
+   * Compiles the GPU programs that the composition needs before it is displayed, which moves the
+   * shader compiling stalls out of the first flush() calls. It draws the first frame and the first
+   * frame of each layer offscreen, then creates the filters of all layers. Call it once after
+   * setting the surface and the composition, e.g. during a loading screen. The progress of the
+   * composition and the content of the PAGSurface are not changed. Returns false if there is no
+   * surface or composition to warm up.
+   */
+  bool warmUp();
+
   /**
    * Returns a rectangle that defines the displaying area of the specified layer, which is in the
    * coordinate of the PAGSurface.
@@ -1459,6 +1522,7 @@ class PAG_API PAGPlayer {
 
  private:
   FileReporter* reporter = nullptr;
+  DamageTracker* damageTracker = nullptr;
   float _maxFrameRate = 60;
   int _scaleMode = PAGScaleMode::LetterBox;
   bool _autoClear = true;
@@ -1466,6 +1530,8 @@ class PAG_API PAGPlayer {
   void updateStageSize();
   void setSurfaceInternal(std::shared_ptr<PAGSurface> newSurface);
   int64_t getTimeStampInternal();
+  bool renderFramesInternal(const std::vector<Frame>& frames, int columns, ColorType colorType,
+                            AlphaType alphaType, void* dstPixels, size_t dstRowBytes);
 
   friend class PAGSurface;
 };
@@ -1485,6 +1551,13 @@ class PAG_API PAGVideoDecoder {
    * decoding video sequences from a pag file, if hardware decoders are not available.
    */
   static void RegisterSoftwareDecoderFactory(SoftwareDecoderFactory* decoderFactory);
+
+  /**
+   * Set the number of CPU cores that the embedded software decoder (libavc) can use to decode one
+   * video sequence. The default value is the number of CPU cores of current device. Passing a value
+   * less than 1 restores the default value. It only affects the decoders created afterwards.
+   */
+  static void SetSoftwareDecoderCores(int count);
 };
 
 class PAG_API PAG {
@@ -1493,6 +1566,61 @@ class PAG_API PAG {
    * Get SDK version information.
    */
   static std::string SDKVersion();
+
+  /**
+   * Sets the maximum number of threads in the shared thread pool, which is used to decode images,
+   * bitmap sequences and video sequences asynchronously. The threads are created on demand, and
+   * the ones that are already created will not be destroyed if the count is decreased later. The
+   * default value is the number of CPU cores, but no more than 16.
+   */
+  static void SetMaxThreadCount(int count);
+
+  /**
+   * Sets the maximum graphics memory in bytes that the internal caches of all PAGPlayers in the
+   * process can use together. The default value is 300MB.
+   */
+  static void SetMaxGraphicsMemory(size_t bytes);
+
+  /**
+   * Releases the internal caches of all PAGPlayers until their total graphics memory drops to the
+   * specified bytes. It is usually called when the system reports memory pressure. The caches
+   * that the current frames do not use are released first. The caches of all PAGPlayers,
+   * including the idle ones, are released right away.
+   */
+  static void TrimGraphicsMemory(size_t targetBytes);
+
+  /**
+   * Sets the maximum CPU memory in bytes that the frame caches of all layers in the process can
+   * use together. The frame caches hold the paths, glyphs and transforms created for each distinct
+   * frame. Once the budget is used up, the least recently used frames are released, except the
+   * ones standing for static time ranges. The default value is 64MB.
+   */
+  static void SetMaxFrameCacheMemory(size_t bytes);
+
+  /**
+   * Sets the directory where the linked GPU shader programs are saved as driver binaries. Programs
+   * found there in a later launch are loaded directly instead of being compiled again, which
+   * removes most of the shader compiling stalls of the first frames. The directory must exist and
+   * be writable, an app cache directory is a good choice. Pass an empty string to disable the
+   * cache, which is the default. Only takes effect on OpenGL 4.1, OpenGL ES 3.0 or the contexts
+   * with the get_program_binary extension.
+   */
+  static void SetProgramCacheDirectory(const std::string& directory);
+
+  /**
+   * Sets whether the large blurs of Fast Blur and Drop Shadow effects are drawn at a reduced
+   * resolution. It makes large blurs several times faster, but the result differs slightly from
+   * the full resolution one around sharp edges. The default value is false.
+   */
+  static void SetBlurDownsamplingEnabled(bool enabled);
+
+  /**
+   * Sets whether the coverage masks of large or complex paths are rasterized on the GPU with
+   * multisampled stencil buffers instead of on the CPU. It speeds up drawing large vector shapes,
+   * but the anti-aliased edges differ slightly from the CPU rasterized ones. The default value is
+   * false.
+   */
+  static void SetPathTessellationEnabled(bool enabled);
 };
 
 }  // namespace pag
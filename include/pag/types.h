@@ -1498,7 +1498,9 @@ struct Marker {
 class PAG_API ByteData {
  public:
   /**
-   * Creates a ByteData object from the specified file path.
+   * Creates a ByteData object from the specified file path. The file is memory-mapped on platforms
+   * that support it, so its pages are only read from disk when they are accessed. Writes to the
+   * returned data are private to the process and never reach the file.
    */
   static std::unique_ptr<ByteData> FromPath(const std::string& filePath);
   /**
@@ -62,7 +62,8 @@ static TimeRange MakeTimeRange(Frame start, Frame end, float timeScale) {
 
 void BitmapComposition::updateStaticTimeRanges() {
   staticTimeRanges = {};
-  if (duration <= 1) {
+  // The sequences are not decoded yet, treat every frame as changed until they are.
+  if (duration <= 1 || hasDeferredContent()) {
     return;
   }
   if (!sequences.empty()) {
@@ -108,7 +109,7 @@ bool BitmapComposition::verify() const {
     VerifyFailed();
     return false;
   }
-  if (sequences.empty()) {
+  if (sequences.empty() && !hasDeferredContent()) {
     VerifyFailed();
     return false;
   }
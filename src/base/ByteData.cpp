@@ -19,8 +19,45 @@
 #include "core/Stream.h"
 #include "pag/file.h"
 
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PAG_USE_MMAP
+#endif
+
 namespace pag {
+#ifdef PAG_USE_MMAP
+static std::unique_ptr<ByteData> MapFile(const std::string& filePath) {
+  auto fd = open(filePath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat fileStat = {};
+  if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+    close(fd);
+    return nullptr;
+  }
+  auto length = static_cast<size_t>(fileStat.st_size);
+  // MAP_PRIVATE makes the mapping copy-on-write, writing to it never modifies the file.
+  auto data = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+  return ByteData::MakeAdopted(reinterpret_cast<uint8_t*>(data), length,
+                               [length](uint8_t* bytes) { munmap(bytes, length); });
+}
+#endif
+
 std::unique_ptr<ByteData> ByteData::FromPath(const std::string& filePath) {
+#ifdef PAG_USE_MMAP
+  auto mappedData = MapFile(filePath);
+  if (mappedData != nullptr) {
+    return mappedData;
+  }
+#endif
   auto stream = Stream::MakeFromFile(filePath);
   if (stream == nullptr) {
     return nullptr;
@@ -19,6 +19,7 @@
 #include <unordered_map>
 #include "base/utils/UniqueID.h"
 #include "base/utils/Verify.h"
+#include "codec/tags/FileTags.h"
 #include "pag/file.h"
 
 namespace pag {
@@ -58,4 +59,44 @@ bool Composition::verify() const {
   }
   VerifyAndReturn(width > 0 && height > 0 && duration > 0 && frameRate > 0);
 }
+
+void Composition::decodeDeferredContent() {
+  if (!deferredContentPending) {
+    return;
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (!deferredContentPending) {
+    return;
+  }
+  decodingDeferredContent = true;
+  if (type() == CompositionType::Vector) {
+    // The static time ranges of a vector composition depend on the compositions it references,
+    // they must be decoded before the ranges are updated.
+    for (auto layer : static_cast<VectorComposition*>(this)->layers) {
+      if (layer->type() != LayerType::PreCompose) {
+        continue;
+      }
+      auto composition = static_cast<PreComposeLayer*>(layer)->composition;
+      if (composition != nullptr) {
+        composition->decodeDeferredContent();
+      }
+    }
+  }
+  if (deferredContent != nullptr) {
+    auto content = std::move(deferredContent);
+    deferredContent = nullptr;
+    if (!ReadDeferredContent(this, content)) {
+      LOGE("Composition::decodeDeferredContent() The deferred content is corrupted!");
+    }
+  }
+  // The static time ranges are updated before other threads can see the decoded content, which
+  // they only read after decodeDeferredContent() returns.
+  updateStaticTimeRanges();
+  decodingDeferredContent = false;
+  deferredContentPending = false;
+}
+
+bool Composition::hasDeferredContent() const {
+  return deferredContentPending && !decodingDeferredContent;
+}
 }  // namespace pag
\ No newline at end of file
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <atomic>
 #include <unordered_map>
 
 #include "pag/file.h"
@@ -24,6 +25,7 @@
 namespace pag {
 
 static std::mutex globalLocker = {};
+static std::atomic_bool lazyDecoding = {false};
 static std::unordered_map<std::string, std::weak_ptr<File>> weakFileMap =
     std::unordered_map<std::string, std::weak_ptr<File>>();
 
@@ -55,12 +57,36 @@ static std::shared_ptr<File> FindFileByPath(const std::string& filePath) {
   return nullptr;
 }
 
+static void CacheFile(const std::string& filePath, std::shared_ptr<File> file) {
+  if (file == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> autoLock(globalLocker);
+  std::weak_ptr<File> weak = file;
+  weakFileMap.insert(std::make_pair(filePath, std::move(weak)));
+}
+
 std::shared_ptr<File> File::Load(const std::string& filePath) {
-  auto byteData = ByteData::FromPath(filePath);
+  auto file = FindFileByPath(filePath);
+  if (file != nullptr) {
+    return file;
+  }
+  std::shared_ptr<ByteData> byteData = ByteData::FromPath(filePath);
   if (byteData == nullptr) {
     return nullptr;
   }
-  return pag::File::Load(byteData->data(), byteData->length(), filePath);
+  // The embedded blobs of the file keep referencing byteData, so they are not copied again.
+  file = Codec::Decode(byteData, filePath, lazyDecoding);
+  CacheFile(filePath, file);
+  return file;
+}
+
+void File::SetLazyDecoding(bool enabled) {
+  lazyDecoding = enabled;
+}
+
+bool File::LazyDecoding() {
+  return lazyDecoding;
 }
 
 uint16_t File::MaxSupportedTagLevel() {
@@ -73,11 +99,7 @@ std::shared_ptr<File> File::Load(const void* bytes, size_t length, const std::st
     return file;
   }
   file = Codec::Decode(bytes, static_cast<uint32_t>(length), filePath);
-  if (file != nullptr) {
-    std::lock_guard<std::mutex> autoLock(globalLocker);
-    std::weak_ptr<File> weak = file;
-    weakFileMap.insert(std::make_pair(filePath, std::move(weak)));
-  }
+  CacheFile(filePath, file);
   return file;
 }
 
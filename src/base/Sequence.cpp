@@ -23,11 +23,16 @@ namespace pag {
 Sequence* Sequence::Get(Composition* composition) {
   // Currently, we use the last one for best rendering quality, ignore all others.
   if (composition != nullptr) {
+    composition->decodeDeferredContent();
     switch (composition->type()) {
-      case CompositionType::Video:
-        return static_cast<VideoComposition*>(composition)->sequences.back();
-      case CompositionType::Bitmap:
-        return static_cast<BitmapComposition*>(composition)->sequences.back();
+      case CompositionType::Video: {
+        auto& sequences = static_cast<VideoComposition*>(composition)->sequences;
+        return sequences.empty() ? nullptr : sequences.back();
+      }
+      case CompositionType::Bitmap: {
+        auto& sequences = static_cast<BitmapComposition*>(composition)->sequences;
+        return sequences.empty() ? nullptr : sequences.back();
+      }
       default:
         break;
     }
@@ -32,7 +32,8 @@ CompositionType VideoComposition::type() const {
 
 void VideoComposition::updateStaticTimeRanges() {
   staticTimeRanges = {};
-  if (duration <= 1) {
+  // The sequences are not decoded yet, treat every frame as changed until they are.
+  if (duration <= 1 || hasDeferredContent()) {
     return;
   }
   if (!sequences.empty()) {
@@ -60,7 +61,7 @@ bool VideoComposition::hasImageContent() const {
 }
 
 bool VideoComposition::verify() const {
-  if (!Composition::verify() || sequences.empty()) {
+  if (!Composition::verify() || (sequences.empty() && !hasDeferredContent())) {
     VerifyFailed();
     return false;
   }
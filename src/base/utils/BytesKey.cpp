@@ -57,6 +57,16 @@ void BytesKey::write(float value) {
   values.push_back(converter.uintValue);
 }
 
+void BytesKey::write(const std::string& value) {
+  auto size = value.size();
+  values.push_back(static_cast<uint32_t>(size));
+  auto offset = values.size();
+  values.resize(offset + (size + 3) / 4, 0);
+  if (size > 0) {
+    memcpy(&values[offset], value.data(), size);
+  }
+}
+
 size_t BytesHasher::operator()(const BytesKey& key) const {
   auto hash = key.values.size();
   for (auto& value : key.values) {
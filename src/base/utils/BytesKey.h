@@ -19,6 +19,7 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
 #include <vector>
 
 namespace pag {
@@ -54,6 +55,11 @@ class BytesKey {
    */
   void write(float value);
 
+  /**
+   * Writes the length and the bytes of a string into the key.
+   */
+  void write(const std::string& value);
+
   friend bool operator==(const BytesKey& a, const BytesKey& b) {
     return a.values == b.values;
   }
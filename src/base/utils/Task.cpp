@@ -28,6 +28,10 @@
 #endif
 
 namespace pag {
+// The upper bound of SetMaxThreads(). Each worker thread owns a queue that is allocated up front,
+// and more threads than this only add contention to the stealing loop.
+static constexpr int MAX_THREAD_COUNT = 64;
+static constexpr int DEFAULT_MAX_THREADS = 16;
 
 int GetCPUCores() {
   int cpuCores = 0;
@@ -56,13 +60,21 @@ Task::~Task() {
   cancel();
 }
 
-void Task::run() {
-  std::lock_guard<std::mutex> autoLock(locker);
-  if (running) {
-    return;
+void Task::run(TaskPriority taskPriority) {
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (running) {
+      return;
+    }
+    running = true;
+    priority = taskPriority;
+    if (taskGroup->pushTask(this)) {
+      return;
+    }
   }
-  running = true;
-  taskGroup->pushTask(this);
+  // The thread pool has already exited, e.g. during static teardown. Runs the task inline so that
+  // the later wait() or cancel() calls never block forever.
+  execute();
 }
 
 bool Task::isRunning() {
@@ -75,7 +87,8 @@ Executor* Task::wait() {
   if (!running) {
     return executor.get();
   }
-  condition.wait(autoLock);
+  taskGroup->promoteTask(this);
+  condition.wait(autoLock, [this] { return !running; });
   return executor.get();
 }
 
@@ -88,7 +101,7 @@ void Task::cancel() {
     running = false;
     return;
   }
-  condition.wait(autoLock);
+  condition.wait(autoLock, [this] { return !running; });
 }
 
 void Task::execute() {
@@ -98,14 +111,75 @@ void Task::execute() {
   condition.notify_all();
 }
 
+void TaskQueue::push(Task* task) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto& list = tasks[static_cast<int>(task->priority)];
+  task->position = list.insert(list.end(), task);
+  task->queue = this;
+  taskCount++;
+}
+
+Task* TaskQueue::pop(TaskPriority priority) {
+  if (taskCount == 0) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto& list = tasks[static_cast<int>(priority)];
+  // The owner takes the oldest task (FIFO) while the thieves take the newest one, see TaskQueue.
+  return list.empty() ? nullptr : take(list.front());
+}
+
+Task* TaskQueue::steal(TaskPriority priority) {
+  if (taskCount == 0) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto& list = tasks[static_cast<int>(priority)];
+  return list.empty() ? nullptr : take(list.back());
+}
+
+bool TaskQueue::remove(Task* task) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (task->queue != this) {
+    return false;
+  }
+  take(task);
+  return true;
+}
+
+bool TaskQueue::promote(Task* task) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (task->queue != this || task->priority == TaskPriority::High) {
+    return false;
+  }
+  tasks[static_cast<int>(task->priority)].erase(task->position);
+  task->priority = TaskPriority::High;
+  // Someone is blocked by the task, move it to the very front of the queue.
+  auto& list = tasks[static_cast<int>(TaskPriority::High)];
+  task->position = list.insert(list.begin(), task);
+  return true;
+}
+
+Task* TaskQueue::take(Task* task) {
+  tasks[static_cast<int>(task->priority)].erase(task->position);
+  task->position = {};
+  task->queue = nullptr;
+  taskCount--;
+  return task;
+}
+
 TaskGroup* TaskGroup::GetInstance() {
   static TaskGroup taskGroup = {};
   return &taskGroup;
 }
 
-void TaskGroup::RunLoop(TaskGroup* taskGroup) {
+void TaskGroup::SetMaxThreads(int count) {
+  GetInstance()->setMaxThreads(count);
+}
+
+void TaskGroup::RunLoop(TaskGroup* taskGroup, size_t index) {
   while (true) {
-    auto task = taskGroup->popTask();
+    auto task = taskGroup->popTask(index);
     if (!task) {
       break;
     }
@@ -115,11 +189,13 @@ void TaskGroup::RunLoop(TaskGroup* taskGroup) {
 
 TaskGroup::TaskGroup() {
   static const int CPUCores = GetCPUCores();
-  auto maxThreads = CPUCores > 16 ? 16 : CPUCores;
-  activeThreads = maxThreads;
-  for (int i = 0; i < maxThreads; i++) {
-    threads.emplace_back(&TaskGroup::RunLoop, this);
+  maxThreads = static_cast<size_t>(std::min(CPUCores, DEFAULT_MAX_THREADS));
+  // The queues are allocated up front, so that the worker threads can steal tasks from each other
+  // without locking the whole group.
+  for (int i = 0; i < MAX_THREAD_COUNT; i++) {
+    queues.push_back(new TaskQueue());
   }
+  threads.reserve(MAX_THREAD_COUNT);
 }
 
 TaskGroup::~TaskGroup() {
@@ -129,43 +205,96 @@ TaskGroup::~TaskGroup() {
       thread.join();
     }
   }
+  for (auto queue : queues) {
+    delete queue;
+  }
+}
+
+void TaskGroup::setMaxThreads(int count) {
+  maxThreads = static_cast<size_t>(std::max(1, std::min(count, MAX_THREAD_COUNT)));
 }
 
-void TaskGroup::pushTask(Task* task) {
+void TaskGroup::startThreadIfNeeded() {
+  if (waitingThreads > 0 || threadCount >= maxThreads) {
+    return;
+  }
   std::lock_guard<std::mutex> autoLock(locker);
-  tasks.push_back(task);
-  condition.notify_one();
+  if (exited || threadCount >= maxThreads) {
+    return;
+  }
+  threads.emplace_back(&TaskGroup::RunLoop, this, threadCount.load());
+  threadCount++;
 }
 
-Task* TaskGroup::popTask() {
-  std::unique_lock<std::mutex> autoLock(locker);
-  activeThreads--;
+bool TaskGroup::pushTask(Task* task) {
+  startThreadIfNeeded();
+  auto count = threadCount.load();
+  if (count == 0 || exited) {
+    return false;
+  }
+  queues[nextQueue++ % count]->push(task);
+  pendingTasks++;
+  if (waitingThreads > 0) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    condition.notify_one();
+  }
+  return true;
+}
+
+Task* TaskGroup::popTask(size_t index) {
   while (true) {
-    if (tasks.empty()) {
-      condition.wait(autoLock);
-      if (exited) {
-        return nullptr;
-      }
-    } else {
-      auto task = tasks.front();
-      tasks.pop_front();
-      activeThreads++;
-      // LOGI("TaskGroup.activeThreads : %d", activeThreads);
+    auto task = findTask(index);
+    if (task != nullptr) {
+      pendingTasks--;
+      return task;
+    }
+    std::unique_lock<std::mutex> autoLock(locker);
+    if (exited) {
+      return nullptr;
+    }
+    waitingThreads++;
+    condition.wait(autoLock, [this] { return exited || pendingTasks > 0; });
+    waitingThreads--;
+    if (exited) {
+      return nullptr;
+    }
+  }
+}
+
+Task* TaskGroup::findTask(size_t index) {
+  auto count = threadCount.load();
+  for (auto priority : {TaskPriority::High, TaskPriority::Low}) {
+    auto task = queues[index]->pop(priority);
+    if (task != nullptr) {
       return task;
     }
+    for (size_t i = 1; i < count; i++) {
+      task = queues[(index + i) % count]->steal(priority);
+      if (task != nullptr) {
+        return task;
+      }
+    }
   }
+  return nullptr;
 }
 
 bool TaskGroup::removeTask(Task* task) {
-  std::lock_guard<std::mutex> autoLock(locker);
-  auto position = std::find(tasks.begin(), tasks.end(), task);
-  if (position == tasks.end()) {
+  // The queue of a task can only be changed from non-null to null, so there is no need to retry.
+  auto queue = task->queue.load();
+  if (queue == nullptr || !queue->remove(task)) {
     return false;
   }
-  tasks.erase(position);
+  pendingTasks--;
   return true;
 }
 
+void TaskGroup::promoteTask(Task* task) {
+  auto queue = task->queue.load();
+  if (queue != nullptr) {
+    queue->promote(task);
+  }
+}
+
 void TaskGroup::exit() {
   std::lock_guard<std::mutex> autoLock(locker);
   exited = true;
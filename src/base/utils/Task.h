@@ -18,8 +18,26 @@
 
 #pragma once
 
+namespace pag {
+/**
+ * Defines the priority classes of tasks. A task with higher priority is always picked up before
+ * the tasks with lower priority that are still waiting in the thread pool.
+ */
+enum class TaskPriority {
+  /**
+   * The result of the task is needed by the frame being rendered or the next one.
+   */
+  High = 0,
+  /**
+   * The task is speculatively prefetching the content of a future frame.
+   */
+  Low = 1
+};
+}  // namespace pag
+
 #ifndef PAG_BUILD_FOR_WEB
 
+#include <atomic>
 #include <condition_variable>
 #include <list>
 #include <mutex>
@@ -27,6 +45,11 @@
 #include <vector>
 
 namespace pag {
+/**
+ * Returns the number of CPU cores available on current device.
+ */
+int GetCPUCores();
+
 class Executor {
  public:
   virtual ~Executor() = default;
@@ -38,14 +61,23 @@ class Executor {
 };
 
 class TaskGroup;
+class TaskQueue;
 
 class Task {
  public:
   static std::shared_ptr<Task> Make(std::unique_ptr<Executor> executor);
   ~Task();
 
-  void run();
+  /**
+   * Pushes the task to the thread pool with the specified priority. Does nothing if the task is
+   * already running.
+   */
+  void run(TaskPriority priority = TaskPriority::High);
   bool isRunning();
+  /**
+   * Blocks the current thread until the task is finished. A waiting task is promoted to the high
+   * priority since someone is blocked by it.
+   */
   Executor* wait();
   void cancel();
 
@@ -55,32 +87,76 @@ class Task {
   bool running = false;
   TaskGroup* taskGroup = nullptr;
   std::unique_ptr<Executor> executor = nullptr;
+  TaskPriority priority = TaskPriority::High;
+  // The queue holding the task while it is waiting to be executed, guarded by the lock of the
+  // queue itself.
+  std::atomic<TaskQueue*> queue = {nullptr};
+  std::list<Task*>::iterator position = {};
 
   explicit Task(std::unique_ptr<Executor> executor);
   void execute();
 
   friend class TaskGroup;
+  friend class TaskQueue;
+};
+
+/**
+ * TaskQueue is the queue owned by a worker thread of TaskGroup. Other worker threads steal tasks
+ * from its back when their own queues are empty. Unlike a standard work-stealing deque, the owner
+ * also pops from the front: tasks are pushed by the rendering threads rather than spawned by the
+ * tasks themselves, and they are expected to start in the order they were pushed, e.g. the
+ * upcoming frames of a sequence are decoded before the later ones.
+ */
+class TaskQueue {
+ public:
+  void push(Task* task);
+  Task* pop(TaskPriority priority);
+  Task* steal(TaskPriority priority);
+  bool remove(Task* task);
+  bool promote(Task* task);
+
+ private:
+  std::mutex locker = {};
+  std::atomic<int> taskCount = {0};
+  std::list<Task*> tasks[2] = {};
+
+  Task* take(Task* task);
 };
 
 class TaskGroup {
  public:
   ~TaskGroup();
 
+  /**
+   * Sets the maximum number of worker threads. The count is clamped to the range [1, 64], since
+   * the queues of all worker threads are allocated up front. Worker threads are created on
+   * demand, the ones that are already created are kept alive until the process exits.
+   */
+  static void SetMaxThreads(int count);
+
  private:
   std::mutex locker = {};
   std::condition_variable condition = {};
-  int activeThreads = 0;
-  bool exited = false;
-  std::list<Task*> tasks = {};
+  std::atomic<int> pendingTasks = {0};
+  std::atomic<int> waitingThreads = {0};
+  std::atomic<size_t> nextQueue = {0};
+  std::atomic<size_t> threadCount = {0};
+  std::atomic<size_t> maxThreads = {0};
+  std::atomic_bool exited = {false};
+  std::vector<TaskQueue*> queues = {};
   std::vector<std::thread> threads = {};
 
   static TaskGroup* GetInstance();
-  static void RunLoop(TaskGroup* taskGroup);
+  static void RunLoop(TaskGroup* taskGroup, size_t index);
 
   TaskGroup();
-  void pushTask(Task* task);
-  Task* popTask();
+  void setMaxThreads(int count);
+  void startThreadIfNeeded();
+  bool pushTask(Task* task);
+  Task* popTask(size_t index);
+  Task* findTask(size_t index);
   bool removeTask(Task* task);
+  void promoteTask(Task* task);
   void exit();
 
   friend class Task;
@@ -107,7 +183,7 @@ class Task {
     return std::shared_ptr<Task>(new Task(std::move(executor)));
   }
 
-  void run() {
+  void run(TaskPriority = TaskPriority::High) {
   }
 
   bool isRunning() const {
@@ -16,6 +16,7 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 #include "Compression.h"
@@ -29,6 +30,7 @@
 namespace pag {
 
 static const uint8_t CompatibleVersion = 2;
+static std::atomic_bool parallelDecoding = {false};
 
 static bool HasTrackMatte(Enum type) {
   switch (type) {
@@ -165,7 +167,12 @@ std::shared_ptr<File> Codec::VerifyAndMake(const std::vector<pag::Composition*>&
   return std::shared_ptr<File>(file);
 }
 
-DecodeStream ReadBodyBytes(DecodeStream* stream) {
+static bool IsValidCompression(char compression) {
+  return compression == CompressionAlgorithm::UNCOMPRESSED ||
+         compression == CompressionAlgorithm::ZLIB || compression == CompressionAlgorithm::LZMA;
+}
+
+static DecodeStream ReadBodyBytes(DecodeStream* stream, char* compression) {
   DecodeStream emptyStream(stream->context);
   if (stream->length() < 11) {
     Throw(stream->context, "Length of PAG file is too short.");
@@ -184,8 +191,8 @@ DecodeStream ReadBodyBytes(DecodeStream* stream) {
     return emptyStream;
   }
   auto bodyLength = stream->readUint32();
-  auto compression = stream->readInt8();
-  if (compression != CompressionAlgorithm::UNCOMPRESSED) {
+  *compression = stream->readInt8();
+  if (!IsValidCompression(*compression)) {
     Throw(stream->context, "Invalid PAG file header.");
     return emptyStream;
   }
@@ -193,19 +200,126 @@ DecodeStream ReadBodyBytes(DecodeStream* stream) {
   return stream->readBytes(bodyLength);
 }
 
-std::shared_ptr<File> Codec::Decode(const void* bytes, uint32_t byteLength,
-                                    const std::string& filePath) {
+/**
+ * Reads the tags of a compressed body. The compressed body starts with the length of the
+ * decompressed body, followed by the compressed bytes. Only one tag is decompressed at a time,
+ * and the tag buffer is reused by the next tag, so the decompressed body is never materialized
+ * as a whole.
+ */
+template <typename T>
+static void ReadCompressedTags(DecodeStream* stream, char compression, T parameter,
+                               void (*reader)(DecodeStream*, TagCode, T)) {
+  auto context = stream->context;
+  auto bytesRemaining = stream->readUint32();
+  if (context->hasException()) {
+    return;
+  }
+  auto decompressor = Decompressor::Make(compression, context, stream->data() + stream->position(),
+                                         stream->bytesAvailable());
+  if (decompressor == nullptr) {
+    Throw(context, "Unsupported compression algorithm of PAG file.");
+    return;
+  }
+  std::vector<uint8_t> tagBuffer = {};
+  while (bytesRemaining >= 2) {
+    // The length of a tag header is 2 bytes, or 6 bytes if the tag is longer than 62 bytes.
+    uint8_t headerBuffer[6] = {};
+    uint32_t headerLength = 2;
+    if (!decompressor->read(headerBuffer, headerLength)) {
+      return;
+    }
+    if ((headerBuffer[0] & 63) == 63) {
+      if (bytesRemaining < 6 || !decompressor->read(headerBuffer + 2, 4)) {
+        Throw(context, "End of file was encountered.");
+        return;
+      }
+      headerLength = 6;
+    }
+    bytesRemaining -= headerLength;
+    DecodeStream headerBytes(context, headerBuffer, headerLength);
+    auto header = ReadTagHeader(&headerBytes);
+    if (header.code == TagCode::End) {
+      return;
+    }
+    if (header.length > bytesRemaining) {
+      Throw(context, "End of file was encountered.");
+      return;
+    }
+    if (tagBuffer.size() < header.length) {
+      tagBuffer.resize(header.length);
+    }
+    if (!decompressor->read(tagBuffer.data(), header.length)) {
+      return;
+    }
+    bytesRemaining -= header.length;
+    DecodeStream tagBytes(context, tagBuffer.data(), header.length);
+    reader(&tagBytes, header.code, parameter);
+    if (context->hasException()) {
+      return;
+    }
+  }
+  Throw(context, "End of file was encountered.");
+}
+
+template <typename T>
+static void ReadBodyTags(DecodeStream* stream, char compression, T parameter,
+                         void (*reader)(DecodeStream*, TagCode, T)) {
+  if (compression == CompressionAlgorithm::UNCOMPRESSED) {
+    ReadTags(stream, parameter, reader);
+  } else {
+    ReadCompressedTags(stream, compression, parameter, reader);
+  }
+}
+
+std::shared_ptr<File> Codec::DecodeFile(const void* bytes, uint32_t byteLength,
+                                        const std::string& filePath,
+                                        std::shared_ptr<ByteData> sourceData,
+                                        bool lazyDecoding) {
   CodecContext context = {};
+  context.sourceData = std::move(sourceData);
+  context.lazyDecoding = lazyDecoding;
   DecodeStream stream(&context, reinterpret_cast<const uint8_t*>(bytes), byteLength);
-  auto bodyBytes = ReadBodyBytes(&stream);
+  char compression = CompressionAlgorithm::UNCOMPRESSED;
+  auto bodyBytes = ReadBodyBytes(&stream, &compression);
   if (context.hasException()) {
     return nullptr;
   }
-  ReadTags(&bodyBytes, &context, ReadTagsOfFile);
+  if (!parallelDecoding || compression != CompressionAlgorithm::UNCOMPRESSED ||
+      !ReadTagsOfFileInParallel(&bodyBytes, &context)) {
+    ReadBodyTags(&bodyBytes, compression, &context, ReadTagsOfFile);
+  }
+  for (auto& item : context.deferredContents) {
+    item.first->deferredContent = std::move(item.second);
+    item.first->deferredContentPending = true;
+  }
   InstallReferences(context.compositions);
   if (context.hasException()) {
     return nullptr;
   }
+  if (!context.deferredContents.empty()) {
+    // The vector compositions that reference deferred content, directly or not, recompute their
+    // static time ranges once the content is decoded.
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (auto composition : context.compositions) {
+        if (composition->type() != CompositionType::Vector || composition->deferredContentPending) {
+          continue;
+        }
+        for (auto layer : static_cast<VectorComposition*>(composition)->layers) {
+          if (layer->type() != LayerType::PreCompose) {
+            continue;
+          }
+          auto child = static_cast<PreComposeLayer*>(layer)->composition;
+          if (child != nullptr && child->deferredContentPending) {
+            composition->deferredContentPending = true;
+            changed = true;
+            break;
+          }
+        }
+      }
+    }
+  }
 
   // Verify 提前到使用之前，避免未经Verify导致使用时crash
   auto file = VerifyAndMake(context.releaseCompositions(), context.releaseImages());
@@ -231,12 +345,58 @@ std::shared_ptr<File> Codec::Decode(const void* bytes, uint32_t byteLength,
   return file;
 }
 
+std::shared_ptr<File> Codec::Decode(const void* bytes, uint32_t byteLength,
+                                    const std::string& filePath) {
+  return DecodeFile(bytes, byteLength, filePath, nullptr, false);
+}
+
+std::shared_ptr<File> Codec::Decode(std::shared_ptr<ByteData> byteData,
+                                    const std::string& filePath, bool lazyDecoding) {
+  if (byteData == nullptr || byteData->length() > UINT32_MAX) {
+    return nullptr;
+  }
+  auto bytes = byteData->data();
+  auto length = static_cast<uint32_t>(byteData->length());
+  return DecodeFile(bytes, length, filePath, std::move(byteData), lazyDecoding);
+}
+
+void Codec::SetParallelDecoding(bool enabled) {
+  parallelDecoding = enabled;
+}
+
+bool Codec::ParallelDecoding() {
+  return parallelDecoding;
+}
+
 std::unique_ptr<ByteData> Codec::Encode(std::shared_ptr<File> file) {
   return Codec::Encode(file, nullptr);
 }
 
 std::unique_ptr<ByteData> Codec::Encode(std::shared_ptr<File> file,
                                         std::shared_ptr<PerformanceData> performanceData) {
+  return Codec::Encode(file, performanceData, CompressionType::None);
+}
+
+static char ToCompressionAlgorithm(Enum compressionType) {
+  switch (compressionType) {
+    case CompressionType::Zlib:
+      return CompressionAlgorithm::ZLIB;
+    case CompressionType::Lzma:
+      return CompressionAlgorithm::LZMA;
+    default:
+      return CompressionAlgorithm::UNCOMPRESSED;
+  }
+}
+
+std::unique_ptr<ByteData> Codec::Encode(std::shared_ptr<File> file,
+                                        std::shared_ptr<PerformanceData> performanceData,
+                                        Enum compressionType) {
+  if (file == nullptr) {
+    return nullptr;
+  }
+  for (auto composition : file->compositions) {
+    composition->decodeDeferredContent();
+  }
   CodecContext context = {};
   EncodeStream bodyBytes(&context);
   WriteTagsOfFile(&bodyBytes, file.get(), performanceData.get());
@@ -246,20 +406,48 @@ std::unique_ptr<ByteData> Codec::Encode(std::shared_ptr<File> file,
   fileBytes.writeInt8('A');
   fileBytes.writeInt8('G');
   fileBytes.writeUint8(Version);
-  fileBytes.writeUint32(bodyBytes.length());
-  fileBytes.writeInt8(CompressionAlgorithm::UNCOMPRESSED);
-  fileBytes.writeBytes(&bodyBytes);
+  auto compression = ToCompressionAlgorithm(compressionType);
+  if (compression == CompressionAlgorithm::UNCOMPRESSED) {
+    fileBytes.writeUint32(bodyBytes.length());
+    fileBytes.writeInt8(compression);
+    fileBytes.writeBytes(&bodyBytes);
+    return fileBytes.release();
+  }
+  auto body = bodyBytes.release();
+  auto compressedBody = Compress(compression, body->data(), static_cast<uint32_t>(body->length()));
+  if (compressedBody == nullptr) {
+    return nullptr;
+  }
+  auto compressedLength = static_cast<uint32_t>(compressedBody->length());
+  fileBytes.writeUint32(compressedLength + 4);
+  fileBytes.writeInt8(compression);
+  fileBytes.writeUint32(static_cast<uint32_t>(body->length()));
+  fileBytes.writeBytes(compressedBody->data(), compressedLength);
   return fileBytes.release();
 }
 
+static void ReadTagsOfPerformance(DecodeStream* stream, TagCode code,
+                                  std::shared_ptr<PerformanceData>* data) {
+  if (code == TagCode::Performance && *data == nullptr) {
+    *data = std::shared_ptr<PerformanceData>(new PerformanceData());
+    ReadPerformanceTag(stream, data->get());
+  }
+}
+
 std::shared_ptr<PerformanceData> Codec::ReadPerformanceData(const void* bytes,
                                                             uint32_t byteLength) {
   CodecContext context = {};
   DecodeStream stream(&context, reinterpret_cast<const uint8_t*>(bytes), byteLength);
-  auto bodyBytes = ReadBodyBytes(&stream);
+  char compression = CompressionAlgorithm::UNCOMPRESSED;
+  auto bodyBytes = ReadBodyBytes(&stream, &compression);
   if (context.hasException()) {
     return nullptr;
   }
+  if (compression != CompressionAlgorithm::UNCOMPRESSED) {
+    std::shared_ptr<PerformanceData> data = nullptr;
+    ReadCompressedTags(&bodyBytes, compression, &data, ReadTagsOfPerformance);
+    return context.hasException() ? nullptr : data;
+  }
   auto header = ReadTagHeader(&bodyBytes);
   if (context.hasException()) {
     return nullptr;
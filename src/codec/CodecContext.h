@@ -47,5 +47,11 @@ class CodecContext : public StreamContext {
   TimeRange* scaledTimeRange = nullptr;
   FileAttributes fileAttributes = {};
   uint16_t tagLevel = 0;
+  /**
+   * If true, the sequence tags of bitmap and video compositions are indexed rather than decoded,
+   * see File::SetLazyDecoding().
+   */
+  bool lazyDecoding = false;
+  std::vector<std::pair<Composition*, std::shared_ptr<ByteData>>> deferredContents;
 };
 }  // namespace pag
@@ -0,0 +1,258 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Compression.h"
+#include <algorithm>
+#include <new>
+#include <vector>
+#include "base/utils/USE.h"
+#ifdef PAG_USE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef PAG_USE_LZMA
+#include "vendor/lzma/Lzma2Dec.h"
+#include "vendor/lzma/Lzma2Enc.h"
+#endif
+
+namespace pag {
+#ifdef PAG_USE_ZLIB
+class ZlibDecompressor : public Decompressor {
+ public:
+  ZlibDecompressor(StreamContext* context, const uint8_t* data, uint32_t length)
+      : Decompressor(context) {
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = length;
+    initialized = inflateInit(&stream) == Z_OK;
+  }
+
+  ~ZlibDecompressor() override {
+    if (initialized) {
+      inflateEnd(&stream);
+    }
+  }
+
+  bool read(uint8_t* buffer, uint32_t length) override {
+    if (!initialized) {
+      Throw(context, "Failed to initialize the zlib decompressor.");
+      return false;
+    }
+    stream.next_out = buffer;
+    stream.avail_out = length;
+    while (stream.avail_out > 0) {
+      auto result = inflate(&stream, Z_NO_FLUSH);
+      if (result == Z_STREAM_END) {
+        break;
+      }
+      if (result != Z_OK) {
+        Throw(context, "The zlib compressed data is corrupted.");
+        return false;
+      }
+    }
+    if (stream.avail_out > 0) {
+      Throw(context, "End of file was encountered.");
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  z_stream stream = {};
+  bool initialized = false;
+};
+
+static std::unique_ptr<ByteData> ZlibCompress(const uint8_t* data, uint32_t length) {
+  z_stream stream = {};
+  if (deflateInit(&stream, Z_BEST_COMPRESSION) != Z_OK) {
+    return nullptr;
+  }
+  auto capacity = deflateBound(&stream, length);
+  auto buffer = ByteData::Make(capacity);
+  stream.next_in = const_cast<Bytef*>(data);
+  stream.avail_in = length;
+  stream.next_out = buffer->data();
+  stream.avail_out = static_cast<uInt>(capacity);
+  auto result = deflate(&stream, Z_FINISH);
+  auto outputLength = stream.total_out;
+  deflateEnd(&stream);
+  if (result != Z_STREAM_END) {
+    return nullptr;
+  }
+  return ByteData::MakeCopy(buffer->data(), outputLength);
+}
+#endif
+
+#ifdef PAG_USE_LZMA
+// The dictionary of the decoder is allocated at once, so we limit its size to keep the peak
+// memory of decoding small even if the pag body is large. The encoder never writes a larger
+// dictionary, and the decoder rejects the streams that declare one.
+static constexpr UInt32 LZMA_MAX_DICTIONARY_SIZE = 1 << 22;
+
+// Returns the dictionary size declared by the property byte of an LZMA2 stream, or 0 if the
+// property is invalid.
+static uint64_t Lzma2DictionarySize(uint8_t property) {
+  if (property > 40) {
+    return 0;
+  }
+  if (property == 40) {
+    return 0xFFFFFFFF;
+  }
+  return static_cast<uint64_t>(2 | (property & 1)) << (property / 2 + 11);
+}
+
+static void* LzmaAlloc(ISzAllocPtr, size_t size) {
+  return new (std::nothrow) uint8_t[size];
+}
+
+static void LzmaFree(ISzAllocPtr, void* address) {
+  delete[] reinterpret_cast<uint8_t*>(address);
+}
+
+static ISzAlloc LzmaAllocFuncs = {LzmaAlloc, LzmaFree};
+
+class LzmaDecompressor : public Decompressor {
+ public:
+  LzmaDecompressor(StreamContext* context, const uint8_t* data, uint32_t length)
+      : Decompressor(context) {
+    Lzma2Dec_Construct(&decoder);
+    // The first byte is the property of the LZMA2 stream. It comes from the file, so the
+    // dictionary size is checked before anything is allocated.
+    auto dictionarySize = length > 0 ? Lzma2DictionarySize(data[0]) : 0;
+    if (dictionarySize > 0 && dictionarySize <= LZMA_MAX_DICTIONARY_SIZE &&
+        Lzma2Dec_Allocate(&decoder, data[0], &LzmaAllocFuncs) == SZ_OK) {
+      Lzma2Dec_Init(&decoder);
+      input = data + 1;
+      inputLength = length - 1;
+      initialized = true;
+    }
+  }
+
+  ~LzmaDecompressor() override {
+    Lzma2Dec_Free(&decoder, &LzmaAllocFuncs);
+  }
+
+  bool read(uint8_t* buffer, uint32_t length) override {
+    if (!initialized) {
+      Throw(context, "Failed to initialize the LZMA decompressor.");
+      return false;
+    }
+    SizeT remaining = length;
+    while (remaining > 0) {
+      SizeT outputSize = remaining;
+      SizeT inputSize = inputLength;
+      ELzmaStatus status = LZMA_STATUS_NOT_SPECIFIED;
+      auto result = Lzma2Dec_DecodeToBuf(&decoder, buffer, &outputSize, input, &inputSize,
+                                         LZMA_FINISH_ANY, &status);
+      if (result != SZ_OK) {
+        Throw(context, "The LZMA compressed data is corrupted.");
+        return false;
+      }
+      input += inputSize;
+      inputLength -= inputSize;
+      buffer += outputSize;
+      remaining -= outputSize;
+      if (outputSize == 0 && (inputSize == 0 || status == LZMA_STATUS_FINISHED_WITH_MARK)) {
+        break;
+      }
+    }
+    if (remaining > 0) {
+      Throw(context, "End of file was encountered.");
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  CLzma2Dec decoder = {};
+  const uint8_t* input = nullptr;
+  SizeT inputLength = 0;
+  bool initialized = false;
+};
+
+struct LzmaOutStream {
+  ISeqOutStream vt;
+  std::vector<uint8_t>* buffer;
+};
+
+static size_t LzmaWrite(const ISeqOutStream* p, const void* data, size_t size) {
+  auto stream = CONTAINER_FROM_VTBL(p, LzmaOutStream, vt);
+  auto bytes = static_cast<const uint8_t*>(data);
+  stream->buffer->insert(stream->buffer->end(), bytes, bytes + size);
+  return size;
+}
+
+static std::unique_ptr<ByteData> LzmaCompress(const uint8_t* data, uint32_t length) {
+  auto encoder = Lzma2Enc_Create(&LzmaAllocFuncs, &LzmaAllocFuncs);
+  if (encoder == nullptr) {
+    return nullptr;
+  }
+  CLzma2EncProps props;
+  Lzma2EncProps_Init(&props);
+  props.lzmaProps.level = 9;
+  props.lzmaProps.dictSize = std::max(std::min(length, LZMA_MAX_DICTIONARY_SIZE), 1u << 12);
+  props.numTotalThreads = 1;
+  auto result = Lzma2Enc_SetProps(encoder, &props);
+  std::vector<uint8_t> buffer = {Lzma2Enc_WriteProperties(encoder)};
+  LzmaOutStream outStream = {{LzmaWrite}, &buffer};
+  if (result == SZ_OK) {
+    result = Lzma2Enc_Encode2(encoder, &outStream.vt, nullptr, nullptr, nullptr, data, length,
+                              nullptr);
+  }
+  Lzma2Enc_Destroy(encoder);
+  if (result != SZ_OK) {
+    return nullptr;
+  }
+  return ByteData::MakeCopy(buffer.data(), buffer.size());
+}
+#endif
+
+std::unique_ptr<Decompressor> Decompressor::Make(char algorithm, StreamContext* context,
+                                                 const uint8_t* data, uint32_t length) {
+  USE(context);
+  USE(data);
+  USE(length);
+  switch (algorithm) {
+#ifdef PAG_USE_ZLIB
+    case CompressionAlgorithm::ZLIB:
+      return std::make_unique<ZlibDecompressor>(context, data, length);
+#endif
+#ifdef PAG_USE_LZMA
+    case CompressionAlgorithm::LZMA:
+      return std::make_unique<LzmaDecompressor>(context, data, length);
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+std::unique_ptr<ByteData> Compress(char algorithm, const uint8_t* data, uint32_t length) {
+  switch (algorithm) {
+    case CompressionAlgorithm::UNCOMPRESSED:
+      return ByteData::MakeCopy(data, length);
+#ifdef PAG_USE_ZLIB
+    case CompressionAlgorithm::ZLIB:
+      return ZlibCompress(data, length);
+#endif
+#ifdef PAG_USE_LZMA
+    case CompressionAlgorithm::LZMA:
+      return LzmaCompress(data, length);
+#endif
+    default:
+      return nullptr;
+  }
+}
+}  // namespace pag
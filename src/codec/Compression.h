@@ -18,10 +18,49 @@
 
 #pragma once
 
+#include <memory>
+#include "codec/utils/StreamContext.h"
+#include "pag/types.h"
+
 namespace pag {
 namespace CompressionAlgorithm {
 static const char UNCOMPRESSED = 'U';
 static const char ZLIB = 'Z';
 static const char LZMA = 'L';
 };  // namespace CompressionAlgorithm
+
+/**
+ * Decompressor inflates a compressed pag body piece by piece, so that the caller never needs to
+ * hold the whole decompressed body in memory at once.
+ */
+class Decompressor {
+ public:
+  /**
+   * Creates a Decompressor for the specified compression algorithm. Returns nullptr if the
+   * algorithm is not supported on current platform. The Decompressor does not take ownership of
+   * the compressed data, the caller must keep it alive until the Decompressor is released.
+   */
+  static std::unique_ptr<Decompressor> Make(char algorithm, StreamContext* context,
+                                            const uint8_t* data, uint32_t length);
+
+  virtual ~Decompressor() = default;
+
+  /**
+   * Inflates exactly the specified length of bytes into the buffer. Returns false and throws an
+   * exception to the context if the compressed data ends prematurely or is corrupted.
+   */
+  virtual bool read(uint8_t* buffer, uint32_t length) = 0;
+
+ protected:
+  explicit Decompressor(StreamContext* context) : context(context) {
+  }
+
+  StreamContext* context = nullptr;
+};
+
+/**
+ * Compresses the specified data with the compression algorithm. Returns nullptr if the algorithm
+ * is not supported on current platform or the compression is failed.
+ */
+std::unique_ptr<ByteData> Compress(char algorithm, const uint8_t* data, uint32_t length);
 }  // namespace pag
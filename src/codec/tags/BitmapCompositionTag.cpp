@@ -38,13 +38,41 @@ void ReadTagsOfBitmapComposition(DecodeStream* stream, TagCode code,
   }
 }
 
+static void ReadAttributeTagsOfBitmapComposition(DecodeStream* stream, TagCode code,
+                                                 BitmapComposition* composition) {
+  if (code != TagCode::BitmapSequence) {
+    ReadTagsOfComposition(stream, code, composition);
+  }
+}
+
+static void ReadSequenceTagsOfBitmapComposition(DecodeStream* stream, TagCode code,
+                                                BitmapComposition* composition) {
+  if (code == TagCode::BitmapSequence) {
+    ReadTagsOfBitmapComposition(stream, code, composition);
+  }
+}
+
 BitmapComposition* ReadBitmapComposition(DecodeStream* stream) {
   auto composition = new BitmapComposition();
   composition->id = stream->readEncodedUint32();
+  auto context = static_cast<CodecContext*>(stream->context);
+  if (context->lazyDecoding) {
+    std::shared_ptr<ByteData> content = stream->shareRemainingBytes();
+    if (content != nullptr) {
+      // The sequences are read by ReadBitmapSequences() the first time they are referenced.
+      context->deferredContents.emplace_back(composition, std::move(content));
+      ReadTags(stream, composition, ReadAttributeTagsOfBitmapComposition);
+      return composition;
+    }
+  }
   ReadTags(stream, composition, ReadTagsOfBitmapComposition);
   return composition;
 }
 
+void ReadBitmapSequences(DecodeStream* stream, BitmapComposition* composition) {
+  ReadTags(stream, composition, ReadSequenceTagsOfBitmapComposition);
+}
+
 static bool lessFirst(const BitmapSequence* item1, const BitmapSequence* item2) {
   return item1->width < item2->width;
 }
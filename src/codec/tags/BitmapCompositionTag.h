@@ -23,5 +23,11 @@
 namespace pag {
 BitmapComposition* ReadBitmapComposition(DecodeStream* stream);
 
+/**
+ * Reads the sequences of a BitmapComposition that was read lazily from the content deferred by
+ * ReadBitmapComposition().
+ */
+void ReadBitmapSequences(DecodeStream* stream, BitmapComposition* composition);
+
 TagCode WriteBitmapComposition(EncodeStream* stream, BitmapComposition* composition);
 }  // namespace pag
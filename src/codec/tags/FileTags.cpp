@@ -17,8 +17,11 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "FileTags.h"
+#include <algorithm>
+#include <limits>
 #include <unordered_set>
 #include "base/utils/EnumClassHash.h"
+#include "base/utils/Task.h"
 #include "codec/tags/BitmapCompositionTag.h"
 #include "codec/tags/FileAttributes.h"
 #include "codec/tags/FontTables.h"
@@ -96,6 +99,214 @@ void ReadTagsOfFile(DecodeStream* stream, TagCode code, CodecContext* context) {
   }
 }
 
+// Bodies with fewer bytes in compositions and image blocks are faster to decode on one thread.
+static constexpr uint32_t MIN_PARALLEL_BYTES = 256 * 1024;
+
+static bool IsImageBytesTag(TagCode code) {
+  return code == TagCode::ImageBytes || code == TagCode::ImageBytesV2 ||
+         code == TagCode::ImageBytesV3;
+}
+
+static bool IsCompositionTag(TagCode code) {
+  return code == TagCode::VectorCompositionBlock || code == TagCode::BitmapCompositionBlock ||
+         code == TagCode::VideoCompositionBlock;
+}
+
+/**
+ * Decodes one top-level tag into a CodecContext of its own. The fonts are copied from the parent
+ * context, and the images decoded so far are borrowed to resolve the image references.
+ */
+class TagDecodingTask : public Executor {
+ public:
+  TagDecodingTask(CodecContext* parent, TagCode code, const DecodeStream& tagBytes)
+      : code(code), data(tagBytes.data()), length(tagBytes.length()) {
+    context.sourceData = parent->sourceData;
+    context.lazyDecoding = parent->lazyDecoding;
+    for (auto& item : parent->fontIDMap) {
+      context.fontIDMap.insert(std::make_pair(item.first, new FontDescriptor(*item.second)));
+    }
+    context.images = parent->images;
+    borrowedImages = parent->images.size();
+  }
+
+  ~TagDecodingTask() override {
+    if (!executed) {
+      context.images.clear();
+    }
+    for (auto imageBytes : createdImages) {
+      delete imageBytes;
+    }
+  }
+
+  /**
+   * Returns true if the tag created images, which are the image itself for an image block, or
+   * placeholders of the missing images for a composition.
+   */
+  bool hasCreatedImages() const {
+    return !createdImages.empty();
+  }
+
+  /**
+   * Moves the results into the parent context in the same way as decoding the tag sequentially.
+   */
+  void mergeInto(CodecContext* parent) {
+    parent->errorMessages.insert(parent->errorMessages.end(), context.errorMessages.begin(),
+                                 context.errorMessages.end());
+    parent->tagLevel = std::max(parent->tagLevel, context.tagLevel);
+    parent->images.insert(parent->images.end(), createdImages.begin(), createdImages.end());
+    createdImages.clear();
+    auto compositions = context.releaseCompositions();
+    parent->compositions.insert(parent->compositions.end(), compositions.begin(),
+                                compositions.end());
+    for (auto& item : context.deferredContents) {
+      parent->deferredContents.push_back(std::move(item));
+    }
+    context.deferredContents.clear();
+  }
+
+ private:
+  TagCode code = TagCode::End;
+  const uint8_t* data = nullptr;
+  uint32_t length = 0;
+  CodecContext context = {};
+  size_t borrowedImages = 0;
+  std::vector<ImageBytes*> createdImages = {};
+  bool executed = false;
+
+  void execute() override {
+    DecodeStream stream(&context, data, length);
+    ReadTagsOfFile(&stream, code, &context);
+    createdImages.assign(context.images.begin() + borrowedImages, context.images.end());
+    context.images.clear();
+    executed = true;
+  }
+};
+
+using FileTag = std::pair<TagCode, DecodeStream>;
+
+static std::vector<std::shared_ptr<Task>> RunDecodingTasks(CodecContext* context,
+                                                           const std::vector<FileTag>& tags,
+                                                           size_t start, size_t end,
+                                                           bool (*filter)(TagCode)) {
+  std::vector<std::shared_ptr<Task>> tasks = {};
+  for (auto i = start; i < end; i++) {
+    auto& tag = tags[i];
+    if (!filter(tag.first)) {
+      tasks.push_back(nullptr);
+      continue;
+    }
+    auto executor = new TagDecodingTask(context, tag.first, tag.second);
+    auto task = Task::Make(std::unique_ptr<TagDecodingTask>(executor));
+    task->run();
+    tasks.push_back(task);
+  }
+  return tasks;
+}
+
+bool ReadTagsOfFileInParallel(DecodeStream* stream, CodecContext* context) {
+  auto body = *stream;
+  std::vector<FileTag> tags = {};
+  auto firstComposition = std::numeric_limits<size_t>::max();
+  size_t parallelTags = 0;
+  uint32_t parallelBytes = 0;
+  auto header = ReadTagHeader(&body);
+  while (!context->hasException() && header.code != TagCode::End) {
+    if (IsCompositionTag(header.code)) {
+      firstComposition = std::min(firstComposition, tags.size());
+    } else if (tags.size() > firstComposition && handlers.count(header.code) > 0) {
+      // The tags that the compositions may depend on come after them.
+      return false;
+    }
+    if (IsCompositionTag(header.code) || IsImageBytesTag(header.code)) {
+      parallelTags++;
+      parallelBytes += header.length;
+    }
+    tags.emplace_back(header.code, body.readBytes(header.length));
+    if (!context->hasException()) {
+      header = ReadTagHeader(&body);
+    }
+  }
+  if (context->hasException()) {
+    return true;
+  }
+  if (parallelTags < 2 || parallelBytes < MIN_PARALLEL_BYTES) {
+    return false;
+  }
+  firstComposition = std::min(firstComposition, tags.size());
+  auto imageTasks = RunDecodingTasks(context, tags, 0, firstComposition, IsImageBytesTag);
+  for (size_t i = 0; i < firstComposition; i++) {
+    if (imageTasks[i] != nullptr) {
+      static_cast<TagDecodingTask*>(imageTasks[i]->wait())->mergeInto(context);
+    } else {
+      ReadTagsOfFile(&tags[i].second, tags[i].first, context);
+    }
+    if (context->hasException()) {
+      return true;
+    }
+  }
+  auto compositionTasks =
+      RunDecodingTasks(context, tags, firstComposition, tags.size(), IsCompositionTag);
+  bool hasMissingImages = false;
+  for (auto& task : compositionTasks) {
+    if (task != nullptr) {
+      hasMissingImages = static_cast<TagDecodingTask*>(task->wait())->hasCreatedImages() ||
+                         hasMissingImages;
+    }
+  }
+  for (size_t i = firstComposition; i < tags.size(); i++) {
+    auto& task = compositionTasks[i - firstComposition];
+    if (task == nullptr) {
+      continue;
+    }
+    if (hasMissingImages) {
+      // The placeholders of missing images are shared by all compositions when decoded
+      // sequentially, so decode them again on this thread to keep the result identical.
+      ReadTagsOfFile(&tags[i].second, tags[i].first, context);
+    } else {
+      static_cast<TagDecodingTask*>(task->wait())->mergeInto(context);
+    }
+    if (context->hasException()) {
+      return true;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+static bool VerifySequences(std::vector<T*>& sequences, bool hasException) {
+  bool valid = !hasException && !sequences.empty();
+  for (auto sequence : sequences) {
+    valid = valid && sequence != nullptr && sequence->verify();
+  }
+  if (!valid) {
+    for (auto sequence : sequences) {
+      delete sequence;
+    }
+    sequences.clear();
+  }
+  return valid;
+}
+
+bool ReadDeferredContent(Composition* composition, std::shared_ptr<ByteData> content) {
+  if (composition == nullptr || content == nullptr) {
+    return false;
+  }
+  CodecContext context = {};
+  context.sourceData = content;
+  DecodeStream stream(&context, content->data(), static_cast<uint32_t>(content->length()));
+  if (composition->type() == CompositionType::Bitmap) {
+    auto bitmapComposition = static_cast<BitmapComposition*>(composition);
+    ReadBitmapSequences(&stream, bitmapComposition);
+    return VerifySequences(bitmapComposition->sequences, context.hasException());
+  }
+  if (composition->type() == CompositionType::Video) {
+    auto videoComposition = static_cast<VideoComposition*>(composition);
+    ReadVideoSequences(&stream, videoComposition);
+    return VerifySequences(videoComposition->sequences, context.hasException());
+  }
+  return false;
+}
+
 void GetFontFromTextDocument(std::vector<FontData>& fontList,
                              std::unordered_set<std::string>& fontSet,
                              const TextDocumentHandle& textDocument) {
@@ -23,5 +23,19 @@
 namespace pag {
 void ReadTagsOfFile(DecodeStream* stream, TagCode code, CodecContext* context);
 
+/**
+ * Reads the tags of an uncompressed file body, decoding the compositions and image blocks in
+ * parallel on the thread pool. Returns false without reading anything if the body is too small or
+ * its tags are not laid out as PAGExporter writes them, in which case the caller should read the
+ * tags sequentially instead.
+ */
+bool ReadTagsOfFileInParallel(DecodeStream* stream, CodecContext* context);
+
+/**
+ * Reads the content of a composition that was deferred during lazy decoding. Returns false if the
+ * content is corrupted, in which case the composition is left without any sequences.
+ */
+bool ReadDeferredContent(Composition* composition, std::shared_ptr<ByteData> content);
+
 void WriteTagsOfFile(EncodeStream* stream, const File* file, PerformanceData* performanceData);
 }  // namespace pag
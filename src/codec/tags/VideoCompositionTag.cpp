@@ -40,15 +40,46 @@ void ReadTagsOfVideoComposition(DecodeStream* stream, TagCode code,
   }
 }
 
+static void ReadAttributeTagsOfVideoComposition(DecodeStream* stream, TagCode code,
+                                                std::pair<VideoComposition*, bool>* parameter) {
+  if (code != TagCode::VideoSequence) {
+    ReadTagsOfComposition(stream, code, parameter->first);
+  }
+}
+
+static void ReadSequenceTagsOfVideoComposition(DecodeStream* stream, TagCode code,
+                                               std::pair<VideoComposition*, bool>* parameter) {
+  if (code == TagCode::VideoSequence) {
+    ReadTagsOfVideoComposition(stream, code, parameter);
+  }
+}
+
 VideoComposition* ReadVideoComposition(DecodeStream* stream) {
   auto composition = new VideoComposition();
   composition->id = stream->readEncodedUint32();
+  auto context = static_cast<CodecContext*>(stream->context);
+  std::shared_ptr<ByteData> content = nullptr;
+  if (context->lazyDecoding) {
+    content = stream->shareRemainingBytes();
+  }
   auto hasAlpha = stream->readBoolean();
   auto parameter = std::make_pair(composition, hasAlpha);
+  if (content != nullptr) {
+    // The sequences are read by ReadVideoSequences() the first time they are referenced.
+    context->deferredContents.emplace_back(composition, std::move(content));
+    ReadTags(stream, &parameter, ReadAttributeTagsOfVideoComposition);
+    return composition;
+  }
   ReadTags(stream, &parameter, ReadTagsOfVideoComposition);
   return composition;
 }
 
+void ReadVideoSequences(DecodeStream* stream, VideoComposition* composition) {
+  auto hasAlpha = stream->readBoolean();
+  auto parameter = std::make_pair(composition, hasAlpha);
+  ReadTags(stream, &parameter, ReadSequenceTagsOfVideoComposition);
+}
+
 static bool lessFirst(const VideoSequence* item1, const VideoSequence* item2) {
   return item1->width < item2->width;
 }
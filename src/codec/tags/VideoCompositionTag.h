@@ -23,5 +23,11 @@
 namespace pag {
 VideoComposition* ReadVideoComposition(DecodeStream* stream);
 
+/**
+ * Reads the sequences of a VideoComposition that was read lazily from the content deferred by
+ * ReadVideoComposition().
+ */
+void ReadVideoSequences(DecodeStream* stream, VideoComposition* composition);
+
 TagCode WriteVideoComposition(EncodeStream* stream, VideoComposition* composition);
 }  // namespace pag
\ No newline at end of file
@@ -59,6 +59,17 @@ DecodeStream DecodeStream::readBytes(uint32_t length) {
   return DecodeStream(context);
 }
 
+static std::unique_ptr<ByteData> MakeSharedByteData(StreamContext* context, const uint8_t* data,
+                                                    uint32_t length) {
+  auto source = context->sourceData;
+  if (source == nullptr || data < source->data() ||
+      data + length > source->data() + source->length()) {
+    return nullptr;
+  }
+  // The slice holds a reference to the source data instead of copying it.
+  return ByteData::MakeAdopted(const_cast<uint8_t*>(data), length, [source](uint8_t*) {});
+}
+
 std::unique_ptr<ByteData> DecodeStream::readByteData() {
   auto length = readEncodedUint32();
   auto bytes = readBytes(length);
@@ -66,9 +77,20 @@ std::unique_ptr<ByteData> DecodeStream::readByteData() {
   if (length == 0 || context->hasException()) {
     return nullptr;
   }
+  auto byteData = MakeSharedByteData(context, bytes.data(), length);
+  if (byteData != nullptr) {
+    return byteData;
+  }
   return ByteData::MakeCopy(bytes.data(), length);
 }
 
+std::unique_ptr<ByteData> DecodeStream::shareRemainingBytes() const {
+  if (_position >= _length) {
+    return nullptr;
+  }
+  return MakeSharedByteData(context, bytes + _position, _length - _position);
+}
+
 std::string DecodeStream::readUTF8String() {
   if (_position < _length) {
     auto text = reinterpret_cast<const char*>(bytes + _position);
@@ -182,6 +182,13 @@ class DecodeStream final {
    */
   std::unique_ptr<ByteData> readByteData();
 
+  /**
+   * Returns a ByteData object that references the bytes from the current position to the end of
+   * the stream without copying them. Returns nullptr if the bytes are not inside of the source data
+   * of the context. The position of the stream is not changed.
+   */
+  std::unique_ptr<ByteData> shareRemainingBytes() const;
+
   /**
    * Reads a UTF-8 string from the byte stream. The string is assumed to be a sequential list of
    * bytes terminated by the null character byte.
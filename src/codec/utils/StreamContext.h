@@ -18,9 +18,11 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 #include "base/utils/Log.h"
+#include "pag/types.h"
 
 namespace pag {
 class StreamContext {
@@ -36,6 +38,13 @@ class StreamContext {
   }
 
   std::vector<std::string> errorMessages;
+
+  /**
+   * The byte data being decoded, if it is owned by a ByteData. Byte data read from inside of it
+   * are returned as slices that keep it alive rather than being copied, see
+   * DecodeStream::readByteData().
+   */
+  std::shared_ptr<ByteData> sourceData = nullptr;
 };
 
 #ifdef DEBUG
@@ -108,6 +108,10 @@ class OffscreenDrawable : public Drawable {
   void present(Context*) override {
   }
 
+  bool preservesContents() const override {
+    return true;
+  }
+
  private:
   int _width = 0;
   int _height = 0;
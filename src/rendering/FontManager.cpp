@@ -90,6 +90,7 @@ PAGFont FontManager::registerFont(std::shared_ptr<Typeface> typeface, const std:
     registeredFontMap.erase(iter);
   }
   registeredFontMap[key] = std::move(typeface);
+  generation++;
   return {family, style};
 }
 
@@ -103,6 +104,7 @@ void FontManager::unregisterFont(const PAGFont& font) {
     return;
   }
   registeredFontMap.erase(iter);
+  generation++;
 }
 
 static std::shared_ptr<Typeface> MakeTypefaceWithName(const std::string& fontFamily,
@@ -155,6 +157,7 @@ void FontManager::setFallbackFontNames(const std::vector<std::string>& fontNames
     auto holder = TypefaceHolder::MakeFromName(fontFamily, "");
     fallbackFontList.push_back(holder);
   }
+  generation++;
 }
 
 void FontManager::setFallbackFontPaths(const std::vector<std::string>& fontPaths,
@@ -167,6 +170,7 @@ void FontManager::setFallbackFontPaths(const std::vector<std::string>& fontPaths
     fallbackFontList.push_back(holder);
     index++;
   }
+  generation++;
 }
 
 std::shared_ptr<Typeface> FontManager::getTypefaceFromCache(const std::string& fontFamily,
@@ -222,4 +226,8 @@ void FontManager::SetFallbackFontPaths(const std::vector<std::string>& fontPaths
                                        const std::vector<int>& ttcIndices) {
   fontManager.setFallbackFontPaths(fontPaths, ttcIndices);
 }
+
+uint32_t FontManager::Generation() {
+  return fontManager.generation;
+}
 }  // namespace pag
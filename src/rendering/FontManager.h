@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <unordered_map>
 #include "pag/pag.h"
 #include "raster/Typeface.h"
@@ -61,6 +62,12 @@ class FontManager {
   static void SetFallbackFontPaths(const std::vector<std::string>& fontPaths,
                                    const std::vector<int>& ttcIndices);
 
+  /**
+   * Returns a number that changes each time the registered fonts or the fallback fonts change, so
+   * the caches of text layouts know when to shape the texts again.
+   */
+  static uint32_t Generation();
+
   ~FontManager();
 
   bool hasFallbackFonts();
@@ -90,6 +97,7 @@ class FontManager {
   std::unordered_map<std::string, std::shared_ptr<Typeface>> registeredFontMap;
   std::vector<std::shared_ptr<TypefaceHolder>> fallbackFontList;
   std::mutex locker = {};
+  std::atomic_uint32_t generation = {0};
 
   std::shared_ptr<Typeface> getTypefaceFromCache(const std::string& fontFamily,
                                                  const std::string& fontStyle);
@@ -16,7 +16,15 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "base/utils/Task.h"
+#include "base/utils/USE.h"
+#include "gpu/opengl/GLPathTessellator.h"
+#include "gpu/opengl/GLProgramBinaryCache.h"
 #include "pag/pag.h"
+#include "rendering/caches/FrameCacheBudget.h"
+#include "rendering/caches/GraphicsMemoryBudget.h"
+#include "rendering/caches/RenderCache.h"
+#include "rendering/filters/utils/BlurPyramid.h"
 
 namespace pag {
 
@@ -25,4 +33,36 @@ static const char sdkVersion[] = "4.0.0.1";
 std::string PAG::SDKVersion() {
   return sdkVersion;
 }
+
+void PAG::SetMaxThreadCount(int count) {
+#ifdef PAG_BUILD_FOR_WEB
+  USE(count);
+#else
+  TaskGroup::SetMaxThreads(count);
+#endif
+}
+
+void PAG::SetMaxGraphicsMemory(size_t bytes) {
+  GraphicsMemoryBudget::SetMaxMemory(bytes);
+}
+
+void PAG::TrimGraphicsMemory(size_t targetBytes) {
+  RenderCache::TrimGraphicsMemory(targetBytes);
+}
+
+void PAG::SetMaxFrameCacheMemory(size_t bytes) {
+  FrameCacheBudget::SetMaxMemory(bytes);
+}
+
+void PAG::SetProgramCacheDirectory(const std::string& directory) {
+  GLProgramBinaryCache::SetDirectory(directory);
+}
+
+void PAG::SetBlurDownsamplingEnabled(bool enabled) {
+  BlurPyramid::SetEnabled(enabled);
+}
+
+void PAG::SetPathTessellationEnabled(bool enabled) {
+  GLPathTessellator::SetEnabled(enabled);
+}
 }  // namespace pag
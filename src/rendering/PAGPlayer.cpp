@@ -16,6 +16,7 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <set>
 #include "base/utils/GetTimer.h"
 #include "base/utils/TimeUtil.h"
 #include "pag/file.h"
@@ -24,6 +25,7 @@
 #include "rendering/caches/RenderCache.h"
 #include "rendering/layers/PAGStage.h"
 #include "rendering/utils/ApplyScaleMode.h"
+#include "rendering/utils/DamageTracker.h"
 #include "rendering/utils/LockGuard.h"
 #include "rendering/utils/ScopedLock.h"
 
@@ -32,6 +34,7 @@ PAGPlayer::PAGPlayer() {
   stage = PAGStage::Make(0, 0);
   rootLocker = stage->rootLocker;
   renderCache = new RenderCache(stage.get());
+  damageTracker = new DamageTracker();
 }
 
 PAGPlayer::~PAGPlayer() {
@@ -39,6 +42,7 @@ PAGPlayer::~PAGPlayer() {
   setSurface(nullptr);
   stage->removeAllLayers();
   delete reporter;
+  delete damageTracker;
 }
 
 std::shared_ptr<PAGComposition> PAGPlayer::getComposition() {
@@ -259,6 +263,9 @@ bool PAGPlayer::flushInternal(BackendSemaphore* signalSemaphore) {
     return false;
   }
   updateStageSize();
+  // The layer caches are shared by all players of the same file, only the requests made while this
+  // player flushes are counted into its stats.
+  ScopedFrameCacheStats frameCacheStats(renderCache->frameCacheStats());
 #ifndef PAG_BUILD_FOR_WEB
   // must be called before content comparing, otherwise decoders can not be prepared.
   renderCache->prepareFrame();
@@ -269,12 +276,13 @@ bool PAGPlayer::flushInternal(BackendSemaphore* signalSemaphore) {
     Recorder recorder = {};
     stage->draw(&recorder);
     lastGraphic = recorder.makeGraphic();
+    damageTracker->update(stage.get());
   }
   auto presentingStart = GetTimer();
   if (lastGraphic) {
     lastGraphic->prepare(renderCache);
   }
-  if (!pagSurface->draw(renderCache, lastGraphic, signalSemaphore, _autoClear)) {
+  if (!pagSurface->draw(renderCache, lastGraphic, signalSemaphore, _autoClear, damageTracker)) {
     return false;
   }
   auto finishTime = GetTimer();
@@ -295,6 +303,104 @@ bool PAGPlayer::flushInternal(BackendSemaphore* signalSemaphore) {
   return true;
 }
 
+bool PAGPlayer::renderFrames(const std::vector<Frame>& frames, int columns, ColorType colorType,
+                             AlphaType alphaType, void* dstPixels, size_t dstRowBytes) {
+  LockGuard autoLock(rootLocker);
+  if (dstPixels == nullptr) {
+    return false;
+  }
+  return renderFramesInternal(frames, columns, colorType, alphaType, dstPixels, dstRowBytes);
+}
+
+bool PAGPlayer::renderFramesInternal(const std::vector<Frame>& frames, int columns,
+                                     ColorType colorType, AlphaType alphaType, void* dstPixels,
+                                     size_t dstRowBytes) {
+  auto pagComposition = stage->getRootComposition();
+  if (pagSurface == nullptr || pagComposition == nullptr || frames.empty() || columns <= 0) {
+    return false;
+  }
+  updateStageSize();
+  columns = static_cast<int>(std::min(frames.size(), static_cast<size_t>(columns)));
+  auto totalFrames =
+      TimeToFrame(pagComposition->durationInternal(), pagComposition->frameRateInternal());
+  if (totalFrames <= 0) {
+    return false;
+  }
+  auto seekTo = [&](Frame frame) {
+    pagComposition->setProgressInternal(FrameToProgress(frame, totalFrames));
+#ifndef PAG_BUILD_FOR_WEB
+    renderCache->prepareFrame();
+#endif
+  };
+  auto progress = pagComposition->getProgressInternal();
+  seekTo(frames[0]);
+  auto makeGraphic = [&](size_t index) {
+    Recorder recorder = {};
+    stage->draw(&recorder);
+    auto graphic = recorder.makeGraphic();
+    if (graphic) {
+      graphic->prepare(renderCache);
+    }
+    // Moves on to the next frame before drawing this one, so that its images, sequences and layer
+    // caches are decoded on the thread pool while the current frame is drawing.
+    if (index + 1 < frames.size()) {
+      seekTo(frames[index + 1]);
+    }
+    return graphic;
+  };
+  auto result = pagSurface->drawFrames(renderCache, frames.size(), columns, makeGraphic, colorType,
+                                       alphaType, dstPixels, dstRowBytes);
+  pagComposition->setProgressInternal(progress);
+  return result;
+}
+
+bool PAGPlayer::warmUp() {
+  LockGuard autoLock(rootLocker);
+  auto pagComposition = stage->getRootComposition();
+  if (pagSurface == nullptr || pagComposition == nullptr) {
+    return false;
+  }
+  auto totalFrames =
+      TimeToFrame(pagComposition->durationInternal(), pagComposition->frameRateInternal());
+  if (totalFrames <= 0) {
+    return false;
+  }
+  // Most programs are first used at the start of the composition or where a layer shows up, the
+  // other frames usually reuse them.
+  std::set<Frame> startFrames = {0};
+  auto rootStartFrame = pagComposition->localFrameToGlobal(pagComposition->startFrame);
+  std::function<void(PAGComposition*)> collectStartFrames = [&](PAGComposition* composition) {
+    for (auto& pagLayer : composition->layers) {
+      startFrames.insert(pagLayer->localFrameToGlobal(pagLayer->startFrame) - rootStartFrame);
+      if (pagLayer->layerType() == LayerType::PreCompose) {
+        collectStartFrames(static_cast<PAGComposition*>(pagLayer.get()));
+      }
+    }
+  };
+  collectStartFrames(pagComposition.get());
+  std::vector<Frame> frames = {};
+  for (auto frame : startFrames) {
+    if (frame >= 0 && frame < totalFrames) {
+      frames.push_back(frame);
+    }
+  }
+  if (!renderFramesInternal(frames, 1, ColorType::RGBA_8888, AlphaType::Premultiplied, nullptr,
+                            0)) {
+    return false;
+  }
+  // The filters of effects and layer styles that are not visible in those frames are created as
+  // well, they hold most of the programs in a composition.
+  auto context = pagSurface->lockContext();
+  if (context == nullptr) {
+    return false;
+  }
+  renderCache->attachToContext(context);
+  renderCache->prepareFilters(pagComposition.get());
+  renderCache->detachFromContext();
+  pagSurface->unlockContext();
+  return true;
+}
+
 Rect PAGPlayer::getBounds(std::shared_ptr<PAGLayer> pagLayer) {
   if (pagLayer == nullptr) {
     return Rect::MakeEmpty();
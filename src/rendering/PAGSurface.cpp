@@ -18,12 +18,15 @@
 
 #include "base/utils/GetTimer.h"
 #include "core/Canvas.h"
+#include "gpu/ReadbackBuffer.h"
+#include "gpu/opengl/GLContext.h"
 #include "gpu/opengl/GLDevice.h"
 #include "pag/file.h"
 #include "pag/pag.h"
 #include "rendering/Drawable.h"
 #include "rendering/caches/RenderCache.h"
 #include "rendering/graphics/Recorder.h"
+#include "rendering/utils/DamageTracker.h"
 #include "rendering/utils/LockGuard.h"
 
 namespace pag {
@@ -92,6 +95,7 @@ int PAGSurface::height() {
 void PAGSurface::updateSize() {
   LockGuard autoLock(rootLocker);
   surface = nullptr;
+  backBuffer = nullptr;
   device = nullptr;
   drawable->updateSize();
 }
@@ -102,6 +106,7 @@ void PAGSurface::freeCache() {
     pagPlayer->renderCache->releaseAll();
   }
   surface = nullptr;
+  backBuffer = nullptr;
   if (device) {
     auto context = device->lockContext();
     if (context) {
@@ -129,6 +134,9 @@ bool PAGSurface::clearAll() {
     return false;
   }
   contentVersion = 0;  // 清空画布后 contentVersion 还原为初始值 0.
+  if (backBuffer != nullptr) {
+    backBuffer->getCanvas()->clear();
+  }
   auto canvas = surface->getCanvas();
   canvas->clear();
   canvas->flush();
@@ -152,8 +160,59 @@ bool PAGSurface::readPixels(ColorType colorType, AlphaType alphaType, void* dstP
   return result;
 }
 
+static std::future<bool> MakeReadyFuture(bool result) {
+  std::promise<bool> promise = {};
+  promise.set_value(result);
+  return promise.get_future();
+}
+
+std::future<bool> PAGSurface::readPixelsAsync(ColorType colorType, AlphaType alphaType,
+                                              void* dstPixels, size_t dstRowBytes) {
+  LockGuard autoLock(rootLocker);
+  auto context = lockContext();
+  if (!context) {
+    return MakeReadyFuture(false);
+  }
+  if (surface == nullptr) {
+    unlockContext();
+    return MakeReadyFuture(false);
+  }
+  auto info =
+      ImageInfo::Make(surface->width(), surface->height(), colorType, alphaType, dstRowBytes);
+  auto buffer = surface->readPixelsAsync();
+  if (buffer == nullptr) {
+    auto result = surface->readPixels(info, dstPixels);
+    unlockContext();
+    return MakeReadyFuture(result);
+  }
+  unlockContext();
+  // The pixels are mapped to the CPU only when the future is waited on, so the transfer can
+  // overlap with the rendering of the next frame.
+  auto currentDevice = device;
+  return std::async(std::launch::deferred, [currentDevice, buffer, info, dstPixels]() {
+    auto context = currentDevice->lockContext();
+    if (context == nullptr) {
+      return false;
+    }
+    auto result = buffer->readPixels(info, dstPixels);
+    currentDevice->unlock();
+    return result;
+  });
+}
+
+static bool GetDamagedBounds(const DamageTracker* damageTracker, const Rect& surfaceBounds,
+                             Rect* damagedBounds) {
+  *damagedBounds = damageTracker->damagedBounds();
+  damagedBounds->roundOut();
+  if (!damagedBounds->intersect(surfaceBounds)) {
+    damagedBounds->setEmpty();
+  }
+  return *damagedBounds != surfaceBounds;
+}
+
 bool PAGSurface::draw(RenderCache* cache, std::shared_ptr<Graphic> graphic,
-                      BackendSemaphore* signalSemaphore, bool autoClear) {
+                      BackendSemaphore* signalSemaphore, bool autoClear,
+                      const DamageTracker* damageTracker) {
   if (device == nullptr) {
     device = drawable->getDevice();
   }
@@ -165,6 +224,11 @@ bool PAGSurface::draw(RenderCache* cache, std::shared_ptr<Graphic> graphic,
     unlockContext();
     return false;
   }
+  // Only the damaged region needs redrawing if the surface still holds the content which the
+  // damage was computed against.
+  auto partialRedraw = surface != nullptr && autoClear && damageTracker != nullptr &&
+                       damageTracker->baseVersion() > 0 &&
+                       damageTracker->baseVersion() == contentVersion;
   if (surface == nullptr) {
     surface = drawable->createSurface(context);
   }
@@ -172,14 +236,50 @@ bool PAGSurface::draw(RenderCache* cache, std::shared_ptr<Graphic> graphic,
     unlockContext();
     return false;
   }
+  if (partialRedraw && !drawable->preservesContents() && backBuffer == nullptr) {
+    // The drawable discards its pixels after presenting, so the frames are rendered into a
+    // persistent back buffer which is copied to the drawable instead. The back buffer is empty
+    // right after creating, so the current frame is still drawn in full.
+    backBuffer = Surface::Make(context, surface->width(), surface->height());
+    partialRedraw = false;
+  }
+  partialRedraw = partialRedraw && (drawable->preservesContents() || backBuffer != nullptr);
   contentVersion = cache->getContentVersion();
   cache->attachToContext(context);
-  auto canvas = surface->getCanvas();
-  if (autoClear) {
-    canvas->clear();
+  auto target = backBuffer != nullptr ? backBuffer : surface;
+  auto canvas = target->getCanvas();
+  auto surfaceBounds =
+      Rect::MakeWH(static_cast<float>(surface->width()), static_cast<float>(surface->height()));
+  Rect damagedBounds = surfaceBounds;
+  if (partialRedraw) {
+    partialRedraw = GetDamagedBounds(damageTracker, surfaceBounds, &damagedBounds);
+  }
+  if (partialRedraw) {
+    if (!damagedBounds.isEmpty()) {
+      canvas->save();
+      Path clip = {};
+      clip.addRect(damagedBounds);
+      canvas->clipPath(clip);
+      canvas->clearRect(damagedBounds);
+      if (graphic) {
+        graphic->draw(canvas, cache);
+      }
+      canvas->restore();
+    }
+  } else {
+    if (autoClear) {
+      canvas->clear();
+    }
+    if (graphic) {
+      graphic->draw(canvas, cache);
+    }
   }
-  if (graphic) {
-    graphic->draw(canvas, cache);
+  cache->damagedPixels = static_cast<size_t>(damagedBounds.width() * damagedBounds.height());
+  cache->surfacePixels = static_cast<size_t>(surfaceBounds.width() * surfaceBounds.height());
+  if (backBuffer != nullptr) {
+    auto surfaceCanvas = surface->getCanvas();
+    surfaceCanvas->clear();
+    surfaceCanvas->drawTexture(backBuffer->getTexture().get());
   }
   surface->flush(signalSemaphore);
   cache->detachFromContext();
@@ -227,6 +327,90 @@ bool PAGSurface::hitTest(RenderCache* cache, std::shared_ptr<Graphic> graphic, f
   return result;
 }
 
+bool PAGSurface::drawFrames(RenderCache* cache, size_t frameCount, int columns,
+                            const std::function<std::shared_ptr<Graphic>(size_t)>& makeGraphic,
+                            ColorType colorType, AlphaType alphaType, void* dstPixels,
+                            size_t dstRowBytes) {
+  if (device == nullptr) {
+    device = drawable->getDevice();
+  }
+  auto context = lockContext();
+  if (!context) {
+    return false;
+  }
+  auto cellWidth = drawable->width();
+  auto cellHeight = drawable->height();
+  auto rowCount = static_cast<int>((frameCount + columns - 1) / columns);
+  auto dstInfo = ImageInfo::Make(cellWidth * columns, cellHeight * rowCount, colorType, alphaType,
+                                 dstRowBytes);
+  // The atlas holds as many cells as the max texture size allows, and it is read back each time it
+  // is full. If a row of frames is wider than the max texture size, the atlas holds a part of one
+  // row instead. Without dstPixels the frames are only drawn, one cell is enough.
+  auto maxTextureSize = GLContext::Unwrap(context)->caps->maxTextureSize;
+  auto pageColumns = cellWidth > 0 ? std::min(columns, maxTextureSize / cellWidth) : 0;
+  auto pageRows = cellHeight > 0 ? std::min(rowCount, maxTextureSize / cellHeight) : 0;
+  if (pageColumns < columns || dstPixels == nullptr) {
+    pageRows = std::min(pageRows, 1);
+  }
+  if (dstPixels == nullptr) {
+    pageColumns = std::min(pageColumns, 1);
+  }
+  std::shared_ptr<Surface> atlas = nullptr;
+  if (!dstInfo.isEmpty() && pageColumns > 0 && pageRows > 0) {
+    atlas = Surface::Make(context, cellWidth * pageColumns, cellHeight * pageRows);
+  }
+  if (atlas == nullptr) {
+    unlockContext();
+    return false;
+  }
+  auto canvas = atlas->getCanvas();
+  auto result = true;
+  for (size_t index = 0; index < frameCount && result; index++) {
+    // The graphic is made before attaching the cache, which prepares the next frame as well.
+    auto graphic = makeGraphic(index);
+    auto row = static_cast<int>(index) / columns;
+    auto column = static_cast<int>(index) % columns;
+    auto pageRow = row % pageRows;
+    auto pageColumn = column % pageColumns;
+    cache->attachToContext(context);
+    if (pageRow == 0 && pageColumn == 0) {
+      canvas->clear();
+    }
+    auto cellBounds = Rect::MakeXYWH(static_cast<float>(pageColumn * cellWidth),
+                                     static_cast<float>(pageRow * cellHeight),
+                                     static_cast<float>(cellWidth), static_cast<float>(cellHeight));
+    canvas->save();
+    Path clip = {};
+    clip.addRect(cellBounds);
+    canvas->clipPath(clip);
+    canvas->concat(Matrix::MakeTrans(cellBounds.left, cellBounds.top));
+    if (graphic) {
+      graphic->draw(canvas, cache);
+    }
+    canvas->restore();
+    canvas->flush();
+    cache->detachFromContext();
+    if (dstPixels == nullptr) {
+      continue;
+    }
+    auto lastFrame = index == frameCount - 1;
+    if (pageColumns < columns) {
+      if (pageColumn == pageColumns - 1 || column == columns - 1 || lastFrame) {
+        auto pageLeft = (column - pageColumn) * cellWidth;
+        auto pageInfo = dstInfo.makeWH((pageColumn + 1) * cellWidth, cellHeight);
+        result = atlas->readPixels(pageInfo,
+                                   dstInfo.computeOffset(dstPixels, pageLeft, row * cellHeight));
+      }
+    } else if (pageRow == pageRows - 1 || lastFrame) {
+      auto pageTop = (row - pageRow) * cellHeight;
+      auto pageInfo = dstInfo.makeWH(dstInfo.width(), (pageRow + 1) * cellHeight);
+      result = atlas->readPixels(pageInfo, dstInfo.computeOffset(dstPixels, 0, pageTop));
+    }
+  }
+  unlockContext();
+  return result;
+}
+
 Context* PAGSurface::lockContext() {
   if (device == nullptr) {
     return nullptr;
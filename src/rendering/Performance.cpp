@@ -21,19 +21,56 @@
 
 namespace pag {
 std::string Performance::getPerformanceString() const {
-  char buffer[300];
+  char buffer[320];
   sprintf(buffer,
           "%6.1fms[Render] %6.1fms[Image] %6.1fms[Video]"
-          " %6.1fms[Texture] %6.1fms[Program] %6.1fms[Present] ",
+          " %6.1fms[Texture] %6.1fms[Program] %6.1fms[Present] %5.1f%%[Glyph] %4zu[Draw] "
+          "%4zu[Batch] %5.1f%%[Prefetch] %5.1f%%[Damage] %5.1f%%[Pool] %6.2fMB[Mask] ",
           static_cast<double>(renderingTime) / 1000.0,
           static_cast<double>(imageDecodingTime) / 1000.0,
           static_cast<double>(softwareDecodingTime + hardwareDecodingTime) / 1000.0,
           static_cast<double>(textureUploadingTime) / 1000.0,
           static_cast<double>(programCompilingTime) / 1000.0,
-          static_cast<double>(presentingTime) / 1000.0);
+          static_cast<double>(presentingTime) / 1000.0,
+          static_cast<double>(glyphAtlasHitRate()) * 100.0, drawCalls, drawBatches,
+          static_cast<double>(prefetchHitRate()) * 100.0,
+          static_cast<double>(damagedRatio()) * 100.0,
+          static_cast<double>(surfacePoolHitRate()) * 100.0,
+          static_cast<double>(pathMaskMemory) / (1024.0 * 1024.0));
   return buffer;
 }
 
+float Performance::glyphAtlasHitRate() const {
+  auto lookups = glyphAtlasHits + glyphAtlasMisses;
+  if (lookups == 0) {
+    return 0;
+  }
+  return static_cast<float>(glyphAtlasHits) / static_cast<float>(lookups);
+}
+
+float Performance::prefetchHitRate() const {
+  auto requests = prefetchHits + prefetchMisses;
+  if (requests == 0) {
+    return 0;
+  }
+  return static_cast<float>(prefetchHits) / static_cast<float>(requests);
+}
+
+float Performance::damagedRatio() const {
+  if (surfacePixels == 0) {
+    return 0;
+  }
+  return static_cast<float>(damagedPixels) / static_cast<float>(surfacePixels);
+}
+
+float Performance::surfacePoolHitRate() const {
+  auto requests = surfacePoolHits + surfacePoolMisses;
+  if (requests == 0) {
+    return 0;
+  }
+  return static_cast<float>(surfacePoolHits) / static_cast<float>(requests);
+}
+
 void Performance::printPerformance(Frame currentFrame) const {
   auto performance = getPerformanceString();
   LOGI("%4d | %6.1fms :%s", currentFrame, static_cast<double>(totalTime) / 1000.0,
@@ -52,5 +89,22 @@ void Performance::resetPerformance() {
   hardwareDecodingInitialTime = 0;
   softwareDecodingInitialTime = 0;
   totalTime = 0;
+
+  glyphAtlasHits = 0;
+  glyphAtlasMisses = 0;
+
+  drawCalls = 0;
+  drawBatches = 0;
+
+  prefetchHits = 0;
+  prefetchMisses = 0;
+
+  damagedPixels = 0;
+  surfacePixels = 0;
+
+  surfacePoolHits = 0;
+  surfacePoolMisses = 0;
+
+  pathMaskMemory = 0;
 }
 }  // namespace pag
\ No newline at end of file
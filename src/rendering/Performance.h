@@ -40,6 +40,79 @@ class Performance {
   int64_t softwareDecodingInitialTime = 0;
   int64_t totalTime = 0;
 
+  // ======= glyph atlas ==========
+  size_t glyphAtlasHits = 0;
+  size_t glyphAtlasMisses = 0;
+
+  /**
+   * Returns the ratio of glyph lookups that were found in the glyph atlas, or 0 if no text was
+   * drawn from the atlas.
+   */
+  float glyphAtlasHitRate() const;
+
+  // ======= draw calls ==========
+  size_t drawCalls = 0;
+  /**
+   * The number of draw calls that merged two or more draw ops.
+   */
+  size_t drawBatches = 0;
+
+  // ======= frame prefetch ==========
+  /**
+   * The number of shape, text and mask frames that were already prepared on the thread pool when
+   * they were rendered.
+   */
+  size_t prefetchHits = 0;
+  /**
+   * The number of shape, text and mask frames that had to be created on the rendering thread.
+   */
+  size_t prefetchMisses = 0;
+
+  /**
+   * Returns the ratio of the rendered frames that were prepared on the thread pool in time, or 0 if
+   * no frame was requested.
+   */
+  float prefetchHitRate() const;
+
+  // ======= damaged region ==========
+  /**
+   * The number of pixels redrawn by the last flush, which only covers the changed region of the
+   * surface if the surface keeps its pixels between flushes.
+   */
+  size_t damagedPixels = 0;
+  /**
+   * The number of pixels of the surface drawn by the last flush.
+   */
+  size_t surfacePixels = 0;
+
+  /**
+   * Returns the ratio of the surface pixels redrawn by the last flush, or 0 if nothing was drawn.
+   */
+  float damagedRatio() const;
+
+  // ======= surface pool ==========
+  /**
+   * The number of filter buffers that reused a free surface of the context.
+   */
+  size_t surfacePoolHits = 0;
+  /**
+   * The number of filter buffers that had to allocate a new surface.
+   */
+  size_t surfacePoolMisses = 0;
+
+  /**
+   * Returns the ratio of the filter buffers that reused a free surface, or 0 if no filter was
+   * drawn.
+   */
+  float surfacePoolHitRate() const;
+
+  // ======= path mask cache ==========
+  /**
+   * The GPU memory held by the path masks cached by the context in bytes, measured after the last
+   * flush. The cache is shared by all players of the context.
+   */
+  size_t pathMaskMemory = 0;
+
   /**
    * Returns the formatted  string which contains the performance data.
    */
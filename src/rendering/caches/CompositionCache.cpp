@@ -22,6 +22,8 @@
 namespace pag {
 
 CompositionCache* CompositionCache::Get(Composition* composition) {
+  // 延迟解码的序列帧需在读取 staticTimeRanges 之前完成解码，且不能持有 composition->locker。
+  composition->decodeDeferredContent();
   std::lock_guard<std::mutex> autoLock(composition->locker);
   if (composition->cache == nullptr) {
     composition->cache = new CompositionCache(composition);
@@ -98,4 +98,10 @@ Content* ContentCache::createCache(Frame layerFrame) {
   }
   return content;
 }
+
+size_t ContentCache::estimateMemory(const Content* content) const {
+  // All contents are created by createContent().
+  auto graphic = static_cast<const GraphicContent*>(content)->graphic;
+  return sizeof(GraphicContent) + (graphic ? graphic->memoryUsage() : 0);
+}
 }  // namespace pag
\ No newline at end of file
@@ -54,6 +54,8 @@ class ContentCache : public FrameCache<Content> {
 
   Content* createCache(Frame layerFrame) override;
 
+  size_t estimateMemory(const Content* content) const override;
+
   virtual ID getCacheID() const {
     return layer->uniqueID;
   }
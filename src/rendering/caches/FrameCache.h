@@ -18,12 +18,53 @@
 
 #pragma once
 
+#include <list>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+#include "FrameCacheBudget.h"
+#include "base/utils/Task.h"
+#include "base/utils/USE.h"
 #include "pag/file.h"
 
 namespace pag {
 template <typename T>
-class FrameCache : public Cache {
+class FrameCache;
+
+/**
+ * FrameCacheTask creates the cache of a future frame on the thread pool.
+ */
+template <typename T>
+class FrameCacheTask : public Executor {
+ public:
+  FrameCacheTask(FrameCache<T>* frameCache, Frame layerFrame)
+      : frameCache(frameCache), layerFrame(layerFrame) {
+  }
+
+  /**
+   * Returns the created cache and gives up its ownership.
+   */
+  T* releaseCache() {
+    return cache.release();
+  }
+
+ private:
+  FrameCache<T>* frameCache = nullptr;
+  Frame layerFrame = 0;
+  std::unique_ptr<T> cache = nullptr;
+
+  void execute() override {
+    cache.reset(frameCache->createCache(layerFrame));
+  }
+};
+
+/**
+ * FrameCache caches the content created for each distinct frame. The frames that stand for a
+ * static time range are pinned, the others are evicted in least recently used order once all
+ * frame caches in the process use up the FrameCacheBudget.
+ */
+template <typename T>
+class FrameCache : public EvictableCache {
  public:
   explicit FrameCache(Frame startTime, Frame duration) : startTime(startTime), duration(duration) {
     if (duration <= 0) {
@@ -32,31 +73,93 @@ class FrameCache : public Cache {
 
     TimeRange range = {0, duration - 1};
     staticTimeRanges.push_back(range);
+    FrameCacheBudget::Register(this);
   }
 
   ~FrameCache() override {
-    for (auto& item : frames) {
-      delete item.second;
-    }
+    FrameCacheBudget::Unregister(this);
+    FrameCacheBudget::Release(usedMemory);
   }
 
-  virtual T* getCache(Frame contentFrame) {
-    contentFrame = ConvertFrameByStaticTimeRanges(staticTimeRanges, contentFrame);
-    if (contentFrame >= duration) {
-      contentFrame = duration - 1;
+  /**
+   * Returns the cache of the specified frame. The returned cache stays valid while it is held,
+   * even if the frame is evicted in the meantime.
+   */
+  virtual std::shared_ptr<T> getCache(Frame contentFrame) {
+    contentFrame = toCacheFrame(contentFrame);
+    FrameCacheLock autoLock(this, locker);
+    auto result = frames.find(contentFrame);
+    if (result != frames.end()) {
+      auto& item = result->second;
+      item.referenced = true;
+      if (item.prepared) {
+        item.prepared = false;
+        FrameCacheStats::RecordPrefetchHit();
+      }
+      return item.cache;
     }
-    if (contentFrame < 0) {
-      contentFrame = 0;
-    }
-    std::lock_guard<std::mutex> autoLock(locker);
-    auto cache = frames[contentFrame];
-    if (cache == nullptr) {
-      cache = createCache(contentFrame + startTime);
-      frames[contentFrame] = cache;
+    T* newCache = nullptr;
+    auto task = preparingTasks.find(contentFrame);
+    if (task != preparingTasks.end()) {
+      auto ready = !task->second->isRunning();
+      auto executor = static_cast<FrameCacheTask<T>*>(task->second->wait());
+      newCache = executor->releaseCache();
+      preparingTasks.erase(task);
+      if (ready) {
+        FrameCacheStats::RecordPrefetchHit();
+      } else {
+        FrameCacheStats::RecordPrefetchMiss();
+      }
+    } else {
+      newCache = createCache(contentFrame + startTime);
+      if (preparingEnabled) {
+        FrameCacheStats::RecordPrefetchMiss();
+      }
     }
+    auto cache = addFrame(contentFrame, newCache, false);
+    purgeIfNeeded();
     return cache;
   }
 
+  /**
+   * Starts creating the cache of the specified frame on the thread pool with low priority, so that
+   * the following getCache() call finds it ready. Does nothing if the frame is already cached or
+   * being created.
+   */
+  void prepareCache(Frame contentFrame) {
+#ifdef PAG_BUILD_FOR_WEB
+    // Tasks run synchronously on the web, preparing a frame would only create it ahead of time on
+    // the rendering thread.
+    USE(contentFrame);
+#else
+    contentFrame = toCacheFrame(contentFrame);
+    FrameCacheLock autoLock(this, locker);
+    preparingEnabled = true;
+    collectPreparedFrames();
+    if (frames.count(contentFrame) > 0 || preparingTasks.count(contentFrame) > 0) {
+      return;
+    }
+    auto executor = new FrameCacheTask<T>(this, contentFrame + startTime);
+    auto task = Task::Make(std::unique_ptr<FrameCacheTask<T>>(executor));
+    task->run(TaskPriority::Low);
+    preparingTasks[contentFrame] = task;
+#endif
+  }
+
+  /**
+   * Cancels all frames that are still being prepared. It must be called before the subclass is
+   * destroyed, because the preparing tasks call createCache() of the subclass.
+   */
+  void cancelPreparing() {
+    std::unordered_map<Frame, std::shared_ptr<Task>> tasks = {};
+    {
+      std::lock_guard<std::mutex> autoLock(locker);
+      std::swap(tasks, preparingTasks);
+    }
+    // The Task destructor waits until the running task is finished.
+    tasks.clear();
+  }
+
   const std::vector<TimeRange>* getStaticTimeRanges() const {
     return &staticTimeRanges;
   }
@@ -66,10 +169,123 @@ class FrameCache : public Cache {
   Frame duration = 1;
   std::vector<TimeRange> staticTimeRanges;
 
+  /**
+   * Creates the cache of the specified frame. It may be called from the thread pool concurrently
+   * with the rendering thread, so it must not modify any member of the cache.
+   */
   virtual T* createCache(Frame layerFrame) = 0;
 
+  /**
+   * Returns the estimated memory in bytes used by the specified cache.
+   */
+  virtual size_t estimateMemory(const T*) const {
+    return sizeof(T);
+  }
+
+  bool evictFrame(bool locked) override {
+    std::unique_lock<std::mutex> autoLock(locker, std::defer_lock);
+    if (!locked && !autoLock.try_lock()) {
+      return false;
+    }
+    // The last unpinned frame is kept, since it is usually the one being rendered. Each frame is
+    // visited at most twice, the second time after its second chance is used up.
+    auto count = unpinnedFrames.size() * 2;
+    for (; count > 0 && unpinnedFrames.size() > 1; count--) {
+      auto frame = unpinnedFrames.front();
+      auto& item = frames[frame];
+      if (item.referenced) {
+        // Gives the recently used frame a second chance.
+        item.referenced = false;
+        unpinnedFrames.splice(unpinnedFrames.end(), unpinnedFrames, item.position);
+        continue;
+      }
+      unpinnedFrames.erase(item.position);
+      usedMemory -= item.memory;
+      FrameCacheBudget::Release(item.memory);
+      frames.erase(frame);
+      return true;
+    }
+    return false;
+  }
+
  private:
+  struct FrameItem {
+    std::shared_ptr<T> cache = nullptr;
+    size_t memory = 0;
+    bool pinned = false;
+    bool referenced = false;
+    // True if the frame was prepared on the thread pool and has not been requested yet.
+    bool prepared = false;
+    std::list<Frame>::iterator position = {};
+  };
+
   std::mutex locker = {};
-  std::unordered_map<Frame, T*> frames;
+  std::unordered_map<Frame, FrameItem> frames;
+  // The unpinned frames from the least recently inserted to the most recently inserted.
+  std::list<Frame> unpinnedFrames;
+  std::unordered_map<Frame, std::shared_ptr<Task>> preparingTasks;
+  bool preparingEnabled = false;
+
+  Frame toCacheFrame(Frame contentFrame) const {
+    contentFrame = ConvertFrameByStaticTimeRanges(staticTimeRanges, contentFrame);
+    if (contentFrame >= duration) {
+      contentFrame = duration - 1;
+    }
+    if (contentFrame < 0) {
+      contentFrame = 0;
+    }
+    return contentFrame;
+  }
+
+  bool isPinned(Frame contentFrame) const {
+    for (auto& timeRange : staticTimeRanges) {
+      if (timeRange.start == contentFrame) {
+        return timeRange.end > timeRange.start;
+      }
+    }
+    return false;
+  }
+
+  std::shared_ptr<T> addFrame(Frame contentFrame, T* cache, bool prepared) {
+    auto& item = frames[contentFrame];
+    item.cache = std::shared_ptr<T>(cache);
+    item.memory = estimateMemory(cache);
+    item.pinned = isPinned(contentFrame);
+    item.referenced = true;
+    item.prepared = prepared;
+    if (!item.pinned) {
+      item.position = unpinnedFrames.insert(unpinnedFrames.end(), contentFrame);
+    }
+    usedMemory += item.memory;
+    FrameCacheBudget::Allocate(item.memory);
+    return item.cache;
+  }
+
+  void purgeIfNeeded() {
+    if (FrameCacheBudget::TotalUsage() > FrameCacheBudget::MaxMemory()) {
+      FrameCacheBudget::Purge(this);
+    }
+  }
+
+  // Moves the frames that finished preparing into the cache, so that they are counted by the
+  // budget.
+  void collectPreparedFrames() {
+    auto added = false;
+    for (auto task = preparingTasks.begin(); task != preparingTasks.end();) {
+      if (task->second->isRunning()) {
+        task++;
+        continue;
+      }
+      auto executor = static_cast<FrameCacheTask<T>*>(task->second->wait());
+      addFrame(task->first, executor->releaseCache(), true);
+      task = preparingTasks.erase(task);
+      added = true;
+    }
+    if (added) {
+      purgeIfNeeded();
+    }
+  }
+
+  friend class FrameCacheTask<T>;
 };
 }  // namespace pag
@@ -0,0 +1,129 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FrameCacheBudget.h"
+#include <mutex>
+#include <vector>
+
+namespace pag {
+// 64M, 超出后按时钟顺序淘汰各个图层最久未使用的帧缓存。
+static constexpr size_t DEFAULT_MAX_FRAME_CACHE_MEMORY = 67108864;
+
+static std::atomic<size_t> maxMemory = {DEFAULT_MAX_FRAME_CACHE_MEMORY};
+static std::atomic<size_t> totalUsage = {0};
+static std::mutex registryLocker = {};
+static std::vector<EvictableCache*> registeredCaches = {};
+static size_t clockHand = 0;
+static thread_local FrameCacheStats* currentStats = nullptr;
+// The frame caches locked by the calling thread, from the outermost to the innermost.
+static thread_local std::vector<EvictableCache*> heldCaches = {};
+
+static bool IsHeldByCurrentThread(EvictableCache* cache) {
+  for (auto heldCache : heldCaches) {
+    if (heldCache == cache) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t FrameCacheBudget::MaxMemory() {
+  return maxMemory;
+}
+
+void FrameCacheBudget::SetMaxMemory(size_t bytes) {
+  maxMemory = bytes;
+}
+
+size_t FrameCacheBudget::TotalUsage() {
+  return totalUsage;
+}
+
+void FrameCacheBudget::Allocate(size_t bytes) {
+  totalUsage += bytes;
+}
+
+void FrameCacheBudget::Release(size_t bytes) {
+  totalUsage -= bytes;
+}
+
+void FrameCacheBudget::Register(EvictableCache* cache) {
+  std::lock_guard<std::mutex> autoLock(registryLocker);
+  cache->registryIndex = registeredCaches.size();
+  registeredCaches.push_back(cache);
+}
+
+void FrameCacheBudget::Unregister(EvictableCache* cache) {
+  std::lock_guard<std::mutex> autoLock(registryLocker);
+  auto index = cache->registryIndex;
+  if (index >= registeredCaches.size() || registeredCaches[index] != cache) {
+    return;
+  }
+  // Moves the last one into the slot to keep the removal O(1), the sweeping order does not matter.
+  auto last = registeredCaches.back();
+  registeredCaches[index] = last;
+  last->registryIndex = index;
+  registeredCaches.pop_back();
+}
+
+void FrameCacheBudget::Purge(EvictableCache* current) {
+  std::lock_guard<std::mutex> autoLock(registryLocker);
+  // Stops after a full round in which no cache could evict anything.
+  size_t failures = 0;
+  while (totalUsage > maxMemory && failures < registeredCaches.size()) {
+    clockHand = clockHand % registeredCaches.size();
+    auto cache = registeredCaches[clockHand++];
+    if (cache != current && IsHeldByCurrentThread(cache)) {
+      // The cache is in the middle of creating a frame further up the stack.
+      failures++;
+      continue;
+    }
+    if (cache->evictFrame(cache == current)) {
+      failures = 0;
+    } else {
+      failures++;
+    }
+  }
+}
+
+FrameCacheLock::FrameCacheLock(EvictableCache* cache, std::mutex& locker) : autoLock(locker) {
+  heldCaches.push_back(cache);
+}
+
+FrameCacheLock::~FrameCacheLock() {
+  heldCaches.pop_back();
+}
+
+FrameCacheStats* FrameCacheStats::SetCurrent(FrameCacheStats* stats) {
+  auto lastStats = currentStats;
+  currentStats = stats;
+  return lastStats;
+}
+
+void FrameCacheStats::RecordPrefetchHit() {
+  if (currentStats != nullptr) {
+    currentStats->prefetchHits++;
+  }
+}
+
+void FrameCacheStats::RecordPrefetchMiss() {
+  if (currentStats != nullptr) {
+    currentStats->prefetchMisses++;
+  }
+}
+}  // namespace pag
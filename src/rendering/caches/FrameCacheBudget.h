@@ -0,0 +1,171 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include "pag/file.h"
+
+namespace pag {
+/**
+ * EvictableCache is the base class of the frame caches whose frames can be evicted by
+ * FrameCacheBudget when all frame caches in the process use up the budget.
+ */
+class EvictableCache : public Cache {
+ public:
+  /**
+   * Returns the estimated memory in bytes used by the frames currently in the cache.
+   */
+  size_t memoryUsage() const {
+    return usedMemory;
+  }
+
+ protected:
+  std::atomic<size_t> usedMemory = {0};
+
+  /**
+   * Evicts one frame that is neither pinned nor the only unpinned frame in the cache. Returns
+   * false if there is no such frame. If locked is false, the cache must not block waiting for its
+   * lock, and returns false if the lock is held by others.
+   */
+  virtual bool evictFrame(bool locked) = 0;
+
+ private:
+  // The position of the cache in the registered caches of FrameCacheBudget, guarded by its lock.
+  size_t registryIndex = 0;
+
+  friend class FrameCacheBudget;
+};
+
+/**
+ * FrameCacheBudget tracks the estimated memory used by the frame caches of all layers in the
+ * process. Once the total usage exceeds the budget, it sweeps the registered caches like a clock
+ * hand, asking each one in turn to evict its least recently used frame. All methods are thread
+ * safe.
+ */
+class FrameCacheBudget {
+ public:
+  /**
+   * Returns the maximum memory in bytes that all frame caches can use together.
+   */
+  static size_t MaxMemory();
+
+  /**
+   * Sets the maximum memory in bytes that all frame caches can use together.
+   */
+  static void SetMaxMemory(size_t bytes);
+
+  /**
+   * Returns the memory in bytes currently used by all frame caches.
+   */
+  static size_t TotalUsage();
+
+  /**
+   * Records that a frame cache has allocated the specified bytes of memory.
+   */
+  static void Allocate(size_t bytes);
+
+  /**
+   * Records that a frame cache has released the specified bytes of memory.
+   */
+  static void Release(size_t bytes);
+
+  /**
+   * Adds the cache to the caches that can be swept.
+   */
+  static void Register(EvictableCache* cache);
+
+  /**
+   * Removes the cache from the caches that can be swept. It must be called before the cache is
+   * destroyed.
+   */
+  static void Unregister(EvictableCache* cache);
+
+  /**
+   * Evicts frames from the registered caches until the total usage drops below the budget. The
+   * current cache is the one calling this method while holding its own lock. The other caches whose
+   * locks are held by the calling thread are skipped, see FrameCacheLock.
+   */
+  static void Purge(EvictableCache* current);
+};
+
+/**
+ * FrameCacheLock locks a frame cache during its lifetime and records it as held by the calling
+ * thread. Creating a frame may request the frames of other caches while the lock is held, e.g. a
+ * layer reading the transform of its parent, and those requests may purge the budget. The purge
+ * must then skip the caches held further up the stack, since locking them again is undefined.
+ */
+class FrameCacheLock {
+ public:
+  FrameCacheLock(EvictableCache* cache, std::mutex& locker);
+
+  ~FrameCacheLock();
+
+ private:
+  std::lock_guard<std::mutex> autoLock;
+};
+
+/**
+ * FrameCacheStats counts how often the frames prepared on the thread pool are ready when the
+ * rendering thread requests them. The frame caches are shared by all players of the same file, so
+ * each RenderCache owns its stats and makes them current on the rendering thread while its player
+ * flushes, see ScopedFrameCacheStats.
+ */
+class FrameCacheStats {
+ public:
+  /**
+   * Makes the stats current on the calling thread and returns the previous ones. The requests made
+   * on a thread without current stats are not counted.
+   */
+  static FrameCacheStats* SetCurrent(FrameCacheStats* stats);
+
+  static void RecordPrefetchHit();
+
+  static void RecordPrefetchMiss();
+
+  /**
+   * The number of requested frames that were already prepared on the thread pool.
+   */
+  size_t prefetchHits = 0;
+
+  /**
+   * The number of requested frames that had to be created or waited for on the rendering thread,
+   * counting only the caches that have frames prepared.
+   */
+  size_t prefetchMisses = 0;
+};
+
+/**
+ * ScopedFrameCacheStats makes the stats current on the calling thread during its lifetime.
+ */
+class ScopedFrameCacheStats {
+ public:
+  explicit ScopedFrameCacheStats(FrameCacheStats* stats)
+      : lastStats(FrameCacheStats::SetCurrent(stats)) {
+  }
+
+  ~ScopedFrameCacheStats() {
+    FrameCacheStats::SetCurrent(lastStats);
+  }
+
+ private:
+  FrameCacheStats* lastStats = nullptr;
+};
+}  // namespace pag
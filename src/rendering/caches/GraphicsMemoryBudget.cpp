@@ -0,0 +1,51 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GraphicsMemoryBudget.h"
+
+namespace pag {
+// 300M设置的大一些用于兜底，所有 RenderCache 共享这部分显存预算。
+static constexpr size_t DEFAULT_MAX_GRAPHICS_MEMORY = 314572800;
+
+static std::atomic<size_t> maxMemory = {DEFAULT_MAX_GRAPHICS_MEMORY};
+static std::atomic<size_t> totalUsage = {0};
+
+size_t GraphicsMemoryBudget::MaxMemory() {
+  return maxMemory;
+}
+
+void GraphicsMemoryBudget::SetMaxMemory(size_t bytes) {
+  maxMemory = bytes;
+}
+
+size_t GraphicsMemoryBudget::TotalUsage() {
+  return totalUsage;
+}
+
+bool GraphicsMemoryBudget::Exceeded() {
+  return totalUsage >= maxMemory;
+}
+
+void GraphicsMemoryBudget::Allocate(size_t bytes) {
+  totalUsage += bytes;
+}
+
+void GraphicsMemoryBudget::Release(size_t bytes) {
+  totalUsage -= bytes;
+}
+}  // namespace pag
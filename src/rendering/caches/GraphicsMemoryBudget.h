@@ -0,0 +1,63 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace pag {
+/**
+ * GraphicsMemoryBudget tracks the graphics memory used by the snapshot caches of all RenderCache
+ * instances in the process, so that multiple players share one memory budget instead of each
+ * assuming it owns the whole budget. The CPU coverages kept for hit testing are counted as well.
+ * All methods are thread safe.
+ */
+class GraphicsMemoryBudget {
+ public:
+  /**
+   * Returns the maximum graphics memory in bytes that all snapshot caches can use together.
+   */
+  static size_t MaxMemory();
+
+  /**
+   * Sets the maximum graphics memory in bytes that all snapshot caches can use together.
+   */
+  static void SetMaxMemory(size_t bytes);
+
+  /**
+   * Returns the graphics memory in bytes currently used by all snapshot caches.
+   */
+  static size_t TotalUsage();
+
+  /**
+   * Returns true if the snapshot caches have used up the budget.
+   */
+  static bool Exceeded();
+
+  /**
+   * Records that a snapshot cache has allocated the specified bytes of graphics memory.
+   */
+  static void Allocate(size_t bytes);
+
+  /**
+   * Records that a snapshot cache has released the specified bytes of graphics memory.
+   */
+  static void Release(size_t bytes);
+};
+}  // namespace pag
@@ -64,16 +64,22 @@ LayerCache::LayerCache(Layer* layer) : layer(layer) {
 }
 
 LayerCache::~LayerCache() {
+  // The preparing tasks must be finished before the caches start to be destroyed.
+  transformCache->cancelPreparing();
+  contentCache->cancelPreparing();
+  if (maskCache) {
+    maskCache->cancelPreparing();
+  }
   delete transformCache;
   delete maskCache;
   delete contentCache;
 }
 
-Transform* LayerCache::getTransform(Frame contentFrame) {
+std::shared_ptr<Transform> LayerCache::getTransform(Frame contentFrame) {
   return transformCache->getCache(contentFrame);
 }
 
-Path* LayerCache::getMasks(Frame contentFrame) {
+std::shared_ptr<Path> LayerCache::getMasks(Frame contentFrame) {
   auto mask = maskCache ? maskCache->getCache(contentFrame) : nullptr;
   if (mask && mask->isEmpty()) {
     return nullptr;
@@ -81,10 +87,33 @@ Path* LayerCache::getMasks(Frame contentFrame) {
   return mask;
 }
 
-Content* LayerCache::getContent(Frame contentFrame) {
+std::shared_ptr<Content> LayerCache::getContent(Frame contentFrame) {
   return contentCache->getCache(contentFrame);
 }
 
+void LayerCache::prepareFrame(Frame contentFrame, bool prepareContent) {
+  if (contentFrame < 0 || contentFrame >= layer->duration) {
+    return;
+  }
+  // Only the shapes, texts and masks are worth preparing, the other contents are cheap to create
+  // or decoded by their own tasks.
+  auto layerType = layer->type();
+  if (prepareContent && (layerType == LayerType::Shape || layerType == LayerType::Text)) {
+    contentCache->prepareCache(contentFrame);
+  }
+  if (maskCache) {
+    maskCache->prepareCache(contentFrame);
+  }
+}
+
+size_t LayerCache::memoryUsage() const {
+  auto memory = transformCache->memoryUsage() + contentCache->memoryUsage();
+  if (maskCache) {
+    memory += maskCache->memoryUsage();
+  }
+  return memory;
+}
+
 Layer* LayerCache::getLayer() const {
   return layer;
 }
@@ -106,6 +135,13 @@ bool LayerCache::checkFrameChanged(Frame contentFrame, Frame lastContentFrame) {
   return contentFrame != lastContentFrame;
 }
 
+Frame LayerCache::getStaticFrame(Frame contentFrame) const {
+  if (contentFrame < 0 || contentFrame >= layer->duration) {
+    return -1;
+  }
+  return ConvertFrameByStaticTimeRanges(staticTimeRanges, contentFrame);
+}
+
 bool LayerCache::contentVisible(Frame contentFrame) {
   if (contentFrame < 0 || contentFrame >= layer->duration) {
     return false;
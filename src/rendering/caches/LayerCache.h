@@ -29,11 +29,22 @@ class LayerCache : public Cache {
 
   ~LayerCache() override;
 
-  Transform* getTransform(Frame contentFrame);
+  std::shared_ptr<Transform> getTransform(Frame contentFrame);
 
-  Path* getMasks(Frame contentFrame);
+  std::shared_ptr<Path> getMasks(Frame contentFrame);
 
-  Content* getContent(Frame contentFrame);
+  std::shared_ptr<Content> getContent(Frame contentFrame);
+
+  /**
+   * Starts creating the content and masks of the specified frame on the thread pool, so that they
+   * are ready when the frame is rendered. If prepareContent is false, only the masks are prepared.
+   */
+  void prepareFrame(Frame contentFrame, bool prepareContent);
+
+  /**
+   * Returns the estimated memory in bytes used by the frame caches of the layer.
+   */
+  size_t memoryUsage() const;
 
   Layer* getLayer() const;
 
@@ -41,6 +52,12 @@ class LayerCache : public Cache {
 
   bool checkFrameChanged(Frame contentFrame, Frame lastContentFrame);
 
+  /**
+   * Returns the first frame of the static time range that contains the contentFrame, which renders
+   * the same as the contentFrame. Returns -1 if the contentFrame is out of the layer duration.
+   */
+  Frame getStaticFrame(Frame contentFrame) const;
+
   bool contentVisible(Frame contentFrame);
 
   bool contentStatic() const {
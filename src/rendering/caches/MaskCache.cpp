@@ -34,4 +34,8 @@ Path* MaskCache::createCache(Frame layerFrame) {
   RenderMasks(maskContent, layer->masks, layerFrame);
   return maskContent;
 }
+
+size_t MaskCache::estimateMemory(const Path* path) const {
+  return sizeof(Path) + path->countPoints() * sizeof(Point) + path->countVerbs();
+}
 }  // namespace pag
\ No newline at end of file
@@ -29,6 +29,8 @@ class MaskCache : public FrameCache<Path> {
  protected:
   Path* createCache(Frame layerFrame) override;
 
+  size_t estimateMemory(const Path* path) const override;
+
  private:
   Layer* layer = nullptr;
 };
@@ -17,33 +17,41 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "RenderCache.h"
+#include <algorithm>
 #include <functional>
 #include <map>
 #include "base/utils/TimeUtil.h"
 #include "base/utils/USE.h"
 #include "base/utils/UniqueID.h"
+#include "gpu/GlyphAtlas.h"
+#include "gpu/PathMaskCache.h"
+#include "gpu/SurfacePool.h"
+#include "rendering/caches/FrameCacheBudget.h"
+#include "rendering/caches/GraphicsMemoryBudget.h"
 #include "rendering/caches/ImageContentCache.h"
 #include "rendering/caches/LayerCache.h"
 #include "rendering/renderers/FilterRenderer.h"
+#include "rendering/utils/LockGuard.h"
 
 namespace pag {
-// 300M设置的大一些用于兜底，通常在大于20M时就开始随时清理。
-#define MAX_GRAPHICS_MEMORY 314572800
+// 显存总量上限由 GraphicsMemoryBudget 在所有 RenderCache 之间共享，通常在大于20M时就开始随时清理。
 #define PURGEABLE_GRAPHICS_MEMORY 20971520  // 20M
 #define PURGEABLE_EXPIRED_FRAME 10
 #define SCALE_FACTOR_PRECISION 0.001f
 #define DECODING_VISIBLE_DISTANCE 500000  // 提前 500ms 秒开始解码。
 #define MIN_HARDWARE_PREPARE_TIME 100000  // 距离当前时刻小于100ms的视频启动软解转硬解优化。
+#define PREPARE_FRAME_COUNT 2  // 提前在线程池里生成后续 2 帧的形状、文本和遮罩。
 
 class ImageTask : public Executor {
  public:
-  static std::shared_ptr<Task> MakeAndRun(std::shared_ptr<Image> image) {
+  static std::shared_ptr<Task> MakeAndRun(std::shared_ptr<Image> image, float scaleFactor,
+                                          TaskPriority priority) {
     if (image == nullptr) {
       return nullptr;
     }
-    auto bitmap = new ImageTask(std::move(image));
+    auto bitmap = new ImageTask(std::move(image), scaleFactor);
     auto task = Task::Make(std::unique_ptr<ImageTask>(bitmap));
-    task->run();
+    task->run(priority);
     return task;
   }
 
@@ -54,19 +62,43 @@ class ImageTask : public Executor {
  private:
   std::shared_ptr<TextureBuffer> buffer = {};
   std::shared_ptr<Image> image = nullptr;
+  float scaleFactor = 1.0f;
 
-  explicit ImageTask(std::shared_ptr<Image> image) : image(std::move(image)) {
+  ImageTask(std::shared_ptr<Image> image, float scaleFactor)
+      : image(std::move(image)), scaleFactor(scaleFactor) {
   }
 
   void execute() override {
-    buffer = image->makeBuffer();
+    buffer = image->makeBuffer(scaleFactor);
   }
 };
 
+static std::mutex cacheListLocker = {};
+static std::vector<RenderCache*> cacheList = {};
+
+void RenderCache::TrimGraphicsMemory(size_t targetBytes) {
+  std::lock_guard<std::mutex> autoLock(cacheListLocker);
+  // 先清理所有缓存中当前帧未使用的部分，仍然超出目标值时再清理正在使用的部分。
+  for (auto purgeUsed : {false, true}) {
+    for (auto cache : cacheList) {
+      if (GraphicsMemoryBudget::TotalUsage() <= targetBytes) {
+        return;
+      }
+      cache->trimSnapshots(targetBytes, purgeUsed);
+    }
+  }
+}
+
 RenderCache::RenderCache(PAGStage* stage) : _uniqueID(UniqueID::Next()), stage(stage) {
+  std::lock_guard<std::mutex> autoLock(cacheListLocker);
+  cacheList.push_back(this);
 }
 
 RenderCache::~RenderCache() {
+  {
+    std::lock_guard<std::mutex> autoLock(cacheListLocker);
+    cacheList.erase(std::find(cacheList.begin(), cacheList.end(), this));
+  }
   releaseAll();
 }
 
@@ -108,6 +140,9 @@ void RenderCache::preparePreComposeLayer(PreComposeLayer* layer, DecodingPolicy
     compositionFrame = 0;
   }
   auto sequence = Sequence::Get(composition);
+  if (sequence == nullptr) {
+    return;
+  }
   auto sequenceFrame = sequence->toSequenceFrame(compositionFrame);
   if (prepareSequenceReader(sequence, sequenceFrame, policy)) {
     return;
@@ -119,19 +154,49 @@ void RenderCache::preparePreComposeLayer(PreComposeLayer* layer, DecodingPolicy
   }
 }
 
-void RenderCache::prepareImageLayer(PAGImageLayer* pagLayer) {
+void RenderCache::prepareImageLayer(PAGImageLayer* pagLayer, TaskPriority priority) {
   auto pagImage = static_cast<PAGImageLayer*>(pagLayer)->getPAGImage();
   if (pagImage == nullptr) {
     auto imageBytes = static_cast<ImageLayer*>(pagLayer->layer)->imageBytes;
     auto image = ImageContentCache::GetImage(imageBytes);
     if (image) {
-      prepareImage(imageBytes->uniqueID, image);
+      prepareImage(imageBytes->uniqueID, image, priority);
     }
     return;
   }
   auto image = pagImage->getImage();
   if (image) {
-    prepareImage(pagImage->uniqueID(), image);
+    prepareImage(pagImage->uniqueID(), image, priority);
+  }
+}
+
+void RenderCache::prepareLayerCaches(PAGComposition* composition) {
+#ifdef PAG_BUILD_FOR_WEB
+  USE(composition);
+#else
+  for (auto& pagLayer : composition->layers) {
+    if (!pagLayer->layerVisible) {
+      continue;
+    }
+    if (pagLayer->layerType() == LayerType::PreCompose) {
+      prepareLayerCaches(static_cast<PAGComposition*>(pagLayer.get()));
+    }
+    prepareLayerCache(pagLayer.get());
+    if (pagLayer->_trackMatteLayer != nullptr) {
+      prepareLayerCache(pagLayer->_trackMatteLayer.get());
+    }
+  }
+#endif
+}
+
+void RenderCache::prepareLayerCache(PAGLayer* pagLayer) {
+  if (pagLayer->layerCache == nullptr) {
+    return;
+  }
+  // The content of a modified layer comes from its replacement instead of the layer cache.
+  auto prepareContent = !pagLayer->contentModified();
+  for (Frame i = 1; i <= PREPARE_FRAME_COUNT; i++) {
+    pagLayer->layerCache->prepareFrame(pagLayer->contentFrame + i, prepareContent);
   }
 }
 
@@ -170,10 +235,16 @@ void RenderCache::prepareFrame() {
                                                              : DecodingPolicy::Hardware;
         preparePreComposeLayer(static_cast<PreComposeLayer*>(pagLayer->layer), policy);
       } else if (pagLayer->layerType() == LayerType::Image) {
-        prepareImageLayer(static_cast<PAGImageLayer*>(pagLayer));
+        // Images of the layers that are visible right now are needed by the current frame.
+        auto priority = item.first > 0 ? TaskPriority::Low : TaskPriority::High;
+        prepareImageLayer(static_cast<PAGImageLayer*>(pagLayer), priority);
       }
     }
   }
+  auto root = stage->getRootComposition();
+  if (root != nullptr) {
+    prepareLayerCaches(root.get());
+  }
 }
 
 void RenderCache::attachToContext(Context* current, bool forHitTest) {
@@ -184,13 +255,24 @@ void RenderCache::attachToContext(Context* current, bool forHitTest) {
   }
   context = current;
   deviceID = context->getDevice()->uniqueID();
+  device = context->getDevice()->weakReference();
   hitTestOnly = forHitTest;
   if (hitTestOnly) {
     return;
   }
+  auto glyphAtlas = context->getGlyphAtlas();
+  lastGlyphAtlasHits = glyphAtlas->hitCount();
+  lastGlyphAtlasMisses = glyphAtlas->missCount();
+  lastDrawCalls = context->drawCallCount();
+  lastDrawBatches = context->batchCount();
+  auto surfacePool = context->getSurfacePool();
+  lastSurfacePoolHits = surfacePool->hitCount();
+  lastSurfacePoolMisses = surfacePool->missCount();
   auto removedAssets = stage->getRemovedAssets();
   for (auto assetID : removedAssets) {
     removeSnapshot(assetID);
+    removeCoverage(assetID);
+    coverageRequests.erase(assetID);
     imageTasks.erase(assetID);
     clearSequenceCache(assetID);
     clearFilterCache(assetID);
@@ -199,6 +281,8 @@ void RenderCache::attachToContext(Context* current, bool forHitTest) {
 
 void RenderCache::releaseAll() {
   clearAllSnapshots();
+  clearAllCoverages();
+  coverageRequests.clear();
   graphicsMemory = 0;
   clearAllSequenceCaches();
   for (auto& item : filterCaches) {
@@ -218,6 +302,22 @@ void RenderCache::detachFromContext() {
   clearExpiredSequences();
   clearExpiredBitmaps();
   clearExpiredSnapshots();
+  clearExpiredCoverages();
+  // The glyph atlas, the surface pool and the draw call counters are shared by all players of the
+  // context, but only this one draws while the context is attached.
+  auto glyphAtlas = context->getGlyphAtlas();
+  glyphAtlasHits += glyphAtlas->hitCount() - lastGlyphAtlasHits;
+  glyphAtlasMisses += glyphAtlas->missCount() - lastGlyphAtlasMisses;
+  drawCalls += context->drawCallCount() - lastDrawCalls;
+  drawBatches += context->batchCount() - lastDrawBatches;
+  auto surfacePool = context->getSurfacePool();
+  surfacePoolHits += surfacePool->hitCount() - lastSurfacePoolHits;
+  surfacePoolMisses += surfacePool->missCount() - lastSurfacePoolMisses;
+  pathMaskMemory = context->getPathMaskCache()->memoryUsage();
+  // The frame caches are requested before the context is attached, while the player flushes.
+  prefetchHits += _frameCacheStats.prefetchHits;
+  prefetchMisses += _frameCacheStats.prefetchMisses;
+  _frameCacheStats = {};
   auto currentTimestamp = GetTimer();
   context->purgeResourcesNotUsedIn(currentTimestamp - lastTimestamp);
   lastTimestamp = currentTimestamp;
@@ -250,16 +350,20 @@ Snapshot* RenderCache::getSnapshot(const Picture* image) {
   }
   if (snapshot) {
     snapshot->idleFrames = 0;
-    auto position = std::find(snapshotLRU.begin(), snapshotLRU.end(), snapshot);
-    if (position != snapshotLRU.end()) {
-      snapshotLRU.erase(position);
-    }
-    snapshotLRU.push_front(snapshot);
+    snapshotLRU.splice(snapshotLRU.begin(), snapshotLRU, snapshot->lruPosition);
     return snapshot;
   }
-  if (scaleFactor < SCALE_FACTOR_PRECISION || graphicsMemory >= MAX_GRAPHICS_MEMORY) {
+  if (scaleFactor < SCALE_FACTOR_PRECISION) {
     return nullptr;
   }
+  if (GraphicsMemoryBudget::Exceeded()) {
+    // 显存预算已经用完，先尝试清理当前帧未使用的缓存。
+    purgeSnapshots(GraphicsMemoryBudget::MaxMemory(), false);
+    if (GraphicsMemoryBudget::Exceeded()) {
+      return nullptr;
+    }
+  }
+  auto startTime = GetTimer();
   auto newSnapshot = image->makeSnapshot(this, scaleFactor);
   if (newSnapshot == nullptr) {
     return nullptr;
@@ -267,8 +371,12 @@ Snapshot* RenderCache::getSnapshot(const Picture* image) {
   snapshot = newSnapshot.release();
   snapshot->assetID = image->assetID;
   snapshot->makerKey = image->uniqueKey;
-  graphicsMemory += snapshot->memoryUsage();
+  snapshot->makingCost = GetTimer() - startTime;
+  auto memoryUsage = snapshot->memoryUsage();
+  graphicsMemory += memoryUsage;
+  GraphicsMemoryBudget::Allocate(memoryUsage);
   snapshotLRU.push_front(snapshot);
+  snapshot->lruPosition = snapshotLRU.begin();
   snapshotCaches[image->assetID] = snapshot;
   return snapshot;
 }
@@ -278,18 +386,19 @@ void RenderCache::removeSnapshot(ID assetID) {
   if (snapshot == snapshotCaches.end()) {
     return;
   }
-  auto position = std::find(snapshotLRU.begin(), snapshotLRU.end(), snapshot->second);
-  if (position != snapshotLRU.end()) {
-    snapshotLRU.erase(position);
-  }
-  graphicsMemory -= snapshot->second->memoryUsage();
+  snapshotLRU.erase(snapshot->second->lruPosition);
+  auto memoryUsage = snapshot->second->memoryUsage();
+  graphicsMemory -= memoryUsage;
+  GraphicsMemoryBudget::Release(memoryUsage);
   delete snapshot->second;
   snapshotCaches.erase(assetID);
 }
 
 void RenderCache::clearAllSnapshots() {
   for (auto& item : snapshotCaches) {
-    graphicsMemory -= item.second->memoryUsage();
+    auto memoryUsage = item.second->memoryUsage();
+    graphicsMemory -= memoryUsage;
+    GraphicsMemoryBudget::Release(memoryUsage);
     delete item.second;
   }
   snapshotCaches.clear();
@@ -301,7 +410,7 @@ void RenderCache::clearExpiredSnapshots() {
     auto snapshot = snapshotLRU.back();
     // 只有 Snapshot 数量可能会比较多，使用 LRU
     // 来避免遍历完整的列表，遇到第一个用过的就可以取消遍历。
-    if (usedAssets.count((snapshot->assetID) > 0)) {
+    if (usedAssets.count(snapshot->assetID) > 0) {
       break;
     }
     snapshot->idleFrames++;
@@ -314,12 +423,137 @@ void RenderCache::clearExpiredSnapshots() {
   }
 }
 
-void RenderCache::prepareImage(ID assetID, std::shared_ptr<Image> image) {
+void RenderCache::purgeSnapshots(size_t targetUsage, bool purgeUsed) {
+  if (GraphicsMemoryBudget::TotalUsage() <= targetUsage) {
+    return;
+  }
+  // 按照每字节的重建耗时排序，重建代价低、占用显存大且越久未使用的缓存越优先清理。
+  std::vector<std::pair<float, Snapshot*>> candidates = {};
+  float recency = 1.0f;
+  for (auto item = snapshotLRU.rbegin(); item != snapshotLRU.rend(); item++, recency++) {
+    auto snapshot = *item;
+    if (!purgeUsed && usedAssets.count(snapshot->assetID) > 0) {
+      continue;
+    }
+    auto memoryUsage = std::max(snapshot->memoryUsage(), static_cast<size_t>(1));
+    auto costPerByte =
+        static_cast<float>(snapshot->makingCost + 1) / static_cast<float>(memoryUsage);
+    candidates.emplace_back(costPerByte * recency, snapshot);
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const std::pair<float, Snapshot*>& a, const std::pair<float, Snapshot*>& b) {
+              return a.first < b.first;
+            });
+  for (auto& item : candidates) {
+    if (GraphicsMemoryBudget::TotalUsage() <= targetUsage) {
+      break;
+    }
+    removeSnapshot(item.second->assetID);
+  }
+}
+
+void RenderCache::trimSnapshots(size_t targetUsage, bool purgeUsed) {
+  LockGuard autoLock(stage->rootLocker);
+  if (purgeUsed && GraphicsMemoryBudget::TotalUsage() > targetUsage) {
+    // 透明度遮罩在 CPU 内存中，释放时无需锁定设备，重建代价也比 Snapshot 低。
+    clearAllCoverages();
+  }
+  if (snapshotCaches.empty()) {
+    return;
+  }
+  // Snapshot 持有的纹理只能在设备锁定时释放。
+  auto currentDevice = device.lock();
+  if (currentDevice == nullptr) {
+    return;
+  }
+  auto currentContext = currentDevice->lockContext();
+  if (currentContext == nullptr) {
+    return;
+  }
+  purgeSnapshots(targetUsage, purgeUsed);
+  currentContext->purgeResourcesNotUsedIn(0);
+  currentDevice->unlock();
+}
+
+Coverage* RenderCache::getCoverage(const Picture* picture) {
+  auto result = coverageCaches.find(picture->assetID);
+  if (result != coverageCaches.end() && result->second->makerKey != picture->uniqueKey) {
+    removeCoverage(picture->assetID);
+    result = coverageCaches.end();
+  }
+  if (result == coverageCaches.end()) {
+    coverageRequests.insert(picture->assetID);
+    return nullptr;
+  }
+  result->second->idleFrames = 0;
+  return result->second;
+}
+
+Coverage* RenderCache::makeCoverage(const Picture* picture, const Texture* texture,
+                                    const Matrix& matrix, const RGBAAALayout* layout) {
+  coverageRequests.erase(picture->assetID);
+  Rect bounds = Rect::MakeEmpty();
+  picture->measureBounds(&bounds);
+  auto coverage = Coverage::Make(context, bounds, texture, matrix, layout).release();
+  if (coverage == nullptr) {
+    return nullptr;
+  }
+  removeCoverage(picture->assetID);
+  coverage->makerKey = picture->uniqueKey;
+  auto memoryUsage = coverage->memoryUsage();
+  graphicsMemory += memoryUsage;
+  GraphicsMemoryBudget::Allocate(memoryUsage);
+  coverageCaches[picture->assetID] = coverage;
+  return coverage;
+}
+
+void RenderCache::removeCoverage(ID assetID) {
+  auto coverage = coverageCaches.find(assetID);
+  if (coverage == coverageCaches.end()) {
+    return;
+  }
+  auto memoryUsage = coverage->second->memoryUsage();
+  graphicsMemory -= memoryUsage;
+  GraphicsMemoryBudget::Release(memoryUsage);
+  delete coverage->second;
+  coverageCaches.erase(coverage);
+}
+
+void RenderCache::clearAllCoverages() {
+  for (auto& item : coverageCaches) {
+    auto memoryUsage = item.second->memoryUsage();
+    graphicsMemory -= memoryUsage;
+    GraphicsMemoryBudget::Release(memoryUsage);
+    delete item.second;
+  }
+  coverageCaches.clear();
+}
+
+void RenderCache::clearExpiredCoverages() {
+  // 碰撞检测停止后，透明度遮罩在一段时间后释放。
+  std::vector<ID> expiredCoverages = {};
+  for (auto& item : coverageCaches) {
+    item.second->idleFrames++;
+    if (item.second->idleFrames >= PURGEABLE_EXPIRED_FRAME) {
+      expiredCoverages.push_back(item.first);
+    }
+  }
+  for (auto& assetID : expiredCoverages) {
+    removeCoverage(assetID);
+  }
+}
+
+void RenderCache::prepareImage(ID assetID, std::shared_ptr<Image> image, TaskPriority priority) {
   usedAssets.insert(assetID);
   if (imageTasks.count(assetID) != 0 || snapshotCaches.count(assetID) != 0) {
     return;
   }
-  auto task = ImageTask::MakeAndRun(std::move(image));
+  // 直接按照图片的最大显示尺寸解码，图片缩放值不需要大于 1.0f，清晰度无法继续提高。
+  auto scaleFactor = std::min(stage->getAssetMaxScale(assetID), 1.0f);
+  if (scaleFactor < SCALE_FACTOR_PRECISION) {
+    scaleFactor = 1.0f;
+  }
+  auto task = ImageTask::MakeAndRun(std::move(image), scaleFactor, priority);
   if (task) {
     imageTasks[assetID] = task;
   }
@@ -503,6 +737,34 @@ LayerStylesFilter* RenderCache::getLayerStylesFilter(Layer* layer) {
   return filter;
 }
 
+void RenderCache::prepareFilters(PAGComposition* composition) {
+  for (auto& pagLayer : composition->layers) {
+    if (pagLayer->layerType() == LayerType::PreCompose) {
+      prepareFilters(static_cast<PAGComposition*>(pagLayer.get()));
+    }
+    prepareLayerFilters(pagLayer.get());
+    if (pagLayer->_trackMatteLayer != nullptr) {
+      prepareLayerFilters(pagLayer->_trackMatteLayer.get());
+    }
+  }
+}
+
+void RenderCache::prepareLayerFilters(PAGLayer* pagLayer) {
+  auto layer = pagLayer->layer;
+  for (auto& effect : layer->effects) {
+    getFilterCache(effect);
+  }
+  if (!layer->layerStyles.empty()) {
+    getLayerStylesFilter(layer);
+    for (auto& layerStyle : layer->layerStyles) {
+      getFilterCache(layerStyle);
+    }
+  }
+  if (layer->motionBlur) {
+    getMotionBlurFilter();
+  }
+}
+
 void RenderCache::clearFilterCache(ID uniqueID) {
   auto result = filterCaches.find(uniqueID);
   if (result != filterCaches.end()) {
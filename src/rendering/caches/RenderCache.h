@@ -24,9 +24,11 @@
 #include "pag/file.h"
 #include "pag/pag.h"
 #include "rendering/Performance.h"
+#include "rendering/caches/FrameCacheBudget.h"
 #include "rendering/filters/LayerFilter.h"
 #include "rendering/filters/LayerStylesFilter.h"
 #include "rendering/filters/MotionBlurFilter.h"
+#include "rendering/graphics/Coverage.h"
 #include "rendering/graphics/Picture.h"
 #include "rendering/graphics/Snapshot.h"
 #include "rendering/layers/PAGStage.h"
@@ -36,6 +38,15 @@
 namespace pag {
 class RenderCache : public Performance {
  public:
+  /**
+   * Releases the snapshots of all RenderCache instances in the process until their total graphics
+   * memory drops to the target bytes. The snapshots that the last frame of each cache did not use
+   * are released first. Each cache is trimmed right away under its root locker and the lock of its
+   * GPU device, so the caches of idle players are trimmed as well. It must not be called while
+   * holding the root locker of any PAGPlayer or the lock of any device.
+   */
+  static void TrimGraphicsMemory(size_t targetBytes);
+
   explicit RenderCache(PAGStage* stage);
 
   ~RenderCache() override;
@@ -51,12 +62,21 @@ class RenderCache : public Performance {
   void detachFromContext();
 
   /**
-   * Returns the total memory usage of this cache.
+   * Returns the total memory usage of this cache. The path masks cached by the GPU context are
+   * shared by all players of the context, so they are not included. They are reported by
+   * pathMaskMemory instead.
    */
   size_t memoryUsage() const {
     return graphicsMemory;
   }
 
+  /**
+   * Returns the stats that the frame cache requests are counted into while the player flushes.
+   */
+  FrameCacheStats* frameCacheStats() {
+    return &_frameCacheStats;
+  }
+
   /**
    * Returns the GPU context associated with this cache.
    */
@@ -99,10 +119,32 @@ class RenderCache : public Performance {
    */
   void removeSnapshot(ID assetID);
 
+  /**
+   * Returns the CPU coverage of specified picture for hit testing. Returns null if there is no
+   * associated cache available or the picture has changed since it was made. In that case the
+   * coverage is requested, and it is made from the texture of the picture when it is drawn next.
+   */
+  Coverage* getCoverage(const Picture* picture);
+
+  /**
+   * Returns true if the coverage of specified picture was requested by hit testing.
+   */
+  bool coverageRequested(const Picture* picture) const {
+    return coverageRequests.count(picture->assetID) > 0;
+  }
+
+  /**
+   * Reads back the coverage of specified picture from the texture that draws its content with the
+   * matrix and layout, then caches it for the following hit tests. Returns null if the pixels
+   * fail to read back.
+   */
+  Coverage* makeCoverage(const Picture* picture, const Texture* texture, const Matrix& matrix,
+                         const RGBAAALayout* layout = nullptr);
+
   /**
    * Prepares a bitmap task for next getImageBuffer() call.
    */
-  void prepareImage(ID assetID, std::shared_ptr<Image> image);
+  void prepareImage(ID assetID, std::shared_ptr<Image> image, TaskPriority priority);
 
   /**
    * Returns a texture buffer cache of specified asset id. Returns null if there is no associated
@@ -128,6 +170,12 @@ class RenderCache : public Performance {
 
   LayerStylesFilter* getLayerStylesFilter(Layer* layer);
 
+  /**
+   * Creates the filters of all layers in the composition ahead of time, so that their programs are
+   * compiled before the first frame that uses them. Must be called while attached to a context.
+   */
+  void prepareFilters(PAGComposition* composition);
+
   void recordImageDecodingTime(int64_t decodingTime);
 
   void recordTextureUploadingTime(int64_t time);
@@ -140,8 +188,16 @@ class RenderCache : public Performance {
   ID _uniqueID = 0;
   PAGStage* stage = nullptr;
   uint32_t deviceID = 0;
+  std::weak_ptr<Device> device;
   Context* context = nullptr;
   int64_t lastTimestamp = 0;
+  size_t lastGlyphAtlasHits = 0;
+  size_t lastGlyphAtlasMisses = 0;
+  size_t lastDrawCalls = 0;
+  size_t lastDrawBatches = 0;
+  FrameCacheStats _frameCacheStats = {};
+  size_t lastSurfacePoolHits = 0;
+  size_t lastSurfacePoolMisses = 0;
   bool hitTestOnly = false;
   size_t graphicsMemory = 0;
   bool _videoEnabled = true;
@@ -149,6 +205,8 @@ class RenderCache : public Performance {
   std::unordered_set<ID> usedAssets = {};
   std::unordered_map<ID, Snapshot*> snapshotCaches = {};
   std::list<Snapshot*> snapshotLRU = {};
+  std::unordered_map<ID, Coverage*> coverageCaches = {};
+  std::unordered_set<ID> coverageRequests = {};
   std::unordered_map<ID, std::shared_ptr<Task>> imageTasks;
   std::unordered_map<ID, std::shared_ptr<SequenceReader>> sequenceCaches;
   std::unordered_map<ID, Filter*> filterCaches;
@@ -160,6 +218,13 @@ class RenderCache : public Performance {
   // snapshot caches:
   void clearAllSnapshots();
   void clearExpiredSnapshots();
+  void purgeSnapshots(size_t targetUsage, bool purgeUsed);
+  void trimSnapshots(size_t targetUsage, bool purgeUsed);
+
+  // coverage caches:
+  void removeCoverage(ID assetID);
+  void clearAllCoverages();
+  void clearExpiredCoverages();
 
   // sequence caches:
   void clearAllSequenceCaches();
@@ -170,8 +235,11 @@ class RenderCache : public Performance {
   LayerFilter* getLayerFilterCache(ID uniqueID, const std::function<LayerFilter*()>& makeFilter);
   void clearFilterCache(ID uniqueID);
   bool initFilter(Filter* filter);
+  void prepareLayerFilters(PAGLayer* pagLayer);
 
   void preparePreComposeLayer(PreComposeLayer* layer, DecodingPolicy policy);
-  void prepareImageLayer(PAGImageLayer* layer);
+  void prepareImageLayer(PAGImageLayer* layer, TaskPriority priority);
+  void prepareLayerCaches(PAGComposition* composition);
+  void prepareLayerCache(PAGLayer* pagLayer);
 };
 }  // namespace pag
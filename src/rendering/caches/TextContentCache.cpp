@@ -18,7 +18,6 @@
 
 #include "TextContentCache.h"
 #include "rendering/graphics/Picture.h"
-#include "rendering/renderers/TextRenderer.h"
 
 namespace pag {
 TextContentCache::TextContentCache(TextLayer* layer)
@@ -57,7 +56,9 @@ ID TextContentCache::getCacheID() const {
 }
 
 GraphicContent* TextContentCache::createContent(Frame layerFrame) const {
-  auto content = RenderTexts(sourceText, pathOption, moreOption, animators, layerFrame).release();
+  auto content = RenderTexts(sourceText, pathOption, moreOption, animators, layerFrame,
+                             &layoutCache)
+                     .release();
   if (_cacheEnabled) {
     content->colorGlyphs = Picture::MakeFrom(getCacheID(), content->colorGlyphs);
   }
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "ContentCache.h"
+#include "rendering/renderers/TextRenderer.h"
 
 namespace pag {
 class TextContentCache : public ContentCache {
@@ -37,5 +38,6 @@ class TextContentCache : public ContentCache {
   TextPathOptions* pathOption;
   TextMoreOptions* moreOption;
   std::vector<TextAnimator*>* animators;
+  mutable TextLayoutCache layoutCache = {};
 };
 }  // namespace pag
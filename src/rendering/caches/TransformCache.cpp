@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "TransformCache.h"
+#include "rendering/caches/LayerCache.h"
 #include "rendering/renderers/TransformRenderer.h"
 
 namespace pag {
@@ -34,15 +35,28 @@ TransformCache::TransformCache(Layer* layer)
   staticTimeRanges = OffsetTimeRanges(timeRanges, -layer->startTime);
 }
 
+// Returns the matrix of the parent including all of its ancestors at the specified frame.
+static Matrix GetParentMatrix(Layer* parent, Frame layerFrame) {
+  auto contentFrame = layerFrame - parent->startTime;
+  if (contentFrame >= 0 && contentFrame < parent->duration) {
+    // Reuses the transform cached by the parent itself, which already includes its ancestors. The
+    // frame is relative to the start time of the parent, which may differ from the child's.
+    return LayerCache::Get(parent)->getTransform(contentFrame)->matrix;
+  }
+  // The parent clamps the frames out of its own range, so they are evaluated directly.
+  Transform parentTransform = {};
+  RenderTransform(&parentTransform, parent->transform, layerFrame);
+  if (parent->parent != nullptr) {
+    parentTransform.matrix.postConcat(GetParentMatrix(parent->parent, layerFrame));
+  }
+  return parentTransform.matrix;
+}
+
 Transform* TransformCache::createCache(Frame layerFrame) {
   auto transform = new Transform();
   RenderTransform(transform, layer->transform, layerFrame);
-  auto parent = layer->parent;
-  while (parent != nullptr) {
-    Transform parentTransform = {};
-    RenderTransform(&parentTransform, parent->transform, layerFrame);
-    transform->matrix.postConcat(parentTransform.matrix);
-    parent = parent->parent;
+  if (layer->parent != nullptr) {
+    transform->matrix.postConcat(GetParentMatrix(layer->parent, layerFrame));
   }
   return transform;
 }
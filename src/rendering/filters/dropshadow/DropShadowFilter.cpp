@@ -27,6 +27,7 @@ DropShadowFilter::DropShadowFilter(DropShadowStyle* layerStyle) : layerStyle(lay
   blurFilterH = new SinglePassBlurFilter(BlurDirection::Horizontal);
   spreadFilter = new DropShadowSpreadFilter(layerStyle, DropShadowStyleMode::Normal);
   spreadThickFilter = new DropShadowSpreadFilter(layerStyle, DropShadowStyleMode::Thick);
+  blurPyramid = new BlurPyramid();
 }
 
 DropShadowFilter::~DropShadowFilter() {
@@ -34,6 +35,7 @@ DropShadowFilter::~DropShadowFilter() {
   delete blurFilterH;
   delete spreadFilter;
   delete spreadThickFilter;
+  delete blurPyramid;
 }
 
 bool DropShadowFilter::initialize(Context* context) {
@@ -49,6 +51,9 @@ bool DropShadowFilter::initialize(Context* context) {
   if (!spreadThickFilter->initialize(context)) {
     return false;
   }
+  if (!blurPyramid->initialize(context)) {
+    return false;
+  }
   return true;
 }
 
@@ -63,6 +68,7 @@ void DropShadowFilter::update(Frame frame, const Rect& contentBounds, const Rect
   spread *= (spread == 1.0) ? 1.0 : 0.8;
   blurSize = (1.0f - spread) * size;
   spreadSize = size * spread;
+  scaledBlurSize = blurSize * std::min(filterScale.x, filterScale.y);
 
   filtersBounds.clear();
   filtersBounds.emplace_back(contentBounds);
@@ -161,61 +167,78 @@ void DropShadowFilter::updateParamModeFullSpread(Frame frame, const Rect& conten
   filtersBounds.emplace_back(filterBounds);
 }
 
-void DropShadowFilter::onDrawModeNotSpread(Context* context, const FilterSource* source,
-                                           const FilterTarget* target) {
+void DropShadowFilter::drawBlur(Context* context, const FilterSource* source,
+                                const FilterTarget* target, bool colorBlur) {
+  // filtersBounds 的最后三项依次为模糊的输入区域、纵向模糊和横向模糊的输出区域。
+  auto count = filtersBounds.size();
   auto contentBounds = filtersBounds[0];
-  auto filterBounds = filtersBounds[1];
-  auto targetWidth = static_cast<int>(ceilf(filterBounds.width() * source->scale.x));
-  auto targetHeight = static_cast<int>(ceilf(filterBounds.height() * source->scale.y));
-  if (blurFilterBuffer == nullptr || blurFilterBuffer->width() != targetWidth ||
-      blurFilterBuffer->height() != targetHeight) {
-    blurFilterBuffer = FilterBuffer::Make(context, targetWidth, targetHeight);
+  auto sourceBounds = filtersBounds[count - 3];
+  auto blurVBounds = filtersBounds[count - 2];
+  auto blurHBounds = filtersBounds[count - 1];
+  auto levels = BlurPyramid::LevelCount(scaledBlurSize, BLUR_MODE_SHADOW_MAX_RADIUS, sourceBounds,
+                                        source->scale);
+  auto blurSource = blurPyramid->downsample(context, source, sourceBounds, levels);
+  if (blurSource == nullptr) {
+    return;
   }
+  auto scale = blurSource->scale;
+  auto targetWidth = static_cast<int>(ceilf(blurVBounds.width() * scale.x));
+  auto targetHeight = static_cast<int>(ceilf(blurVBounds.height() * scale.y));
+  auto blurFilterBuffer = FilterBuffer::Make(context, targetWidth, targetHeight);
   if (blurFilterBuffer == nullptr) {
     return;
   }
   auto gl = GLContext::Unwrap(context);
   blurFilterBuffer->clearColor(gl);
 
-  auto offsetMatrix = Matrix::MakeTrans((contentBounds.left - filterBounds.left) * source->scale.x,
-                                        (contentBounds.top - filterBounds.top) * source->scale.y);
+  auto offsetMatrix = Matrix::MakeTrans((sourceBounds.left - blurVBounds.left) * scale.x,
+                                        (sourceBounds.top - blurVBounds.top) * scale.y);
   auto targetV = blurFilterBuffer->toFilterTarget(offsetMatrix);
-
-  blurFilterV->updateParams(blurSize, 1.0, false, BlurMode::Shadow);
-  blurFilterV->enableBlurColor(color);
-  blurFilterV->draw(context, source, targetV.get());
+  blurFilterV->updateParams(blurSize, 1.0, false, BlurMode::Shadow, levels);
+  if (colorBlur) {
+    blurFilterV->enableBlurColor(color);
+  }
+  blurFilterV->draw(context, blurSource.get(), targetV.get());
   blurFilterV->disableBlurColor();
 
-  auto sourceH = blurFilterBuffer->toFilterSource(source->scale);
-
-  blurFilterH->updateParams(blurSize, opacity / 255.f, false, BlurMode::Shadow);
+  auto sourceH = blurFilterBuffer->toFilterSource(scale);
+  blurFilterH->updateParams(blurSize, opacity / 255.f, false, BlurMode::Shadow, levels);
+  if (levels > 0) {
+    auto targetH = blurPyramid->makeOutputTarget(context, blurVBounds, blurHBounds, scale);
+    if (targetH == nullptr) {
+      return;
+    }
+    blurFilterH->draw(context, sourceH.get(), targetH.get());
+    blurPyramid->upsample(context, contentBounds, blurHBounds, source->scale, target);
+    return;
+  }
   Matrix revertMatrix =
-      Matrix::MakeTrans((filterBounds.left - contentBounds.left) * source->scale.x,
-                        (filterBounds.top - contentBounds.top) * source->scale.y);
-
+      Matrix::MakeTrans((blurVBounds.left - contentBounds.left) * source->scale.x,
+                        (blurVBounds.top - contentBounds.top) * source->scale.y);
   auto targetH = *target;
   PreConcatMatrix(&targetH, revertMatrix);
   blurFilterH->draw(context, sourceH.get(), &targetH);
 }
 
+void DropShadowFilter::onDrawModeNotSpread(Context* context, const FilterSource* source,
+                                           const FilterTarget* target) {
+  drawBlur(context, source, target, true);
+}
+
 void DropShadowFilter::onDrawModeNotFullSpread(Context* context, const FilterSource* source,
                                                const FilterTarget* target) {
   auto contentBounds = filtersBounds[0];
-  auto lastBounds = contentBounds;
   auto filterBounds = filtersBounds[1];
   auto targetWidth = static_cast<int>(ceilf(filterBounds.width() * source->scale.x));
   auto targetHeight = static_cast<int>(ceilf(filterBounds.height() * source->scale.y));
-  if (spreadFilterBuffer == nullptr || spreadFilterBuffer->width() != targetWidth ||
-      spreadFilterBuffer->height() != targetHeight) {
-    spreadFilterBuffer = FilterBuffer::Make(context, targetWidth, targetHeight);
-  }
+  auto spreadFilterBuffer = FilterBuffer::Make(context, targetWidth, targetHeight);
   if (spreadFilterBuffer == nullptr) {
     return;
   }
   auto gl = GLContext::Unwrap(context);
   spreadFilterBuffer->clearColor(gl);
-  auto offsetMatrix = Matrix::MakeTrans((lastBounds.left - filterBounds.left) * source->scale.x,
-                                        (lastBounds.top - filterBounds.top) * source->scale.y);
+  auto offsetMatrix = Matrix::MakeTrans((contentBounds.left - filterBounds.left) * source->scale.x,
+                                        (contentBounds.top - filterBounds.top) * source->scale.y);
   auto targetSpread = spreadFilterBuffer->toFilterTarget(offsetMatrix);
   if (spreadSize < DROPSHADOW_SPREAD_MIN_THICK_SIZE) {
     spreadFilter->draw(context, source, targetSpread.get());
@@ -224,32 +247,7 @@ void DropShadowFilter::onDrawModeNotFullSpread(Context* context, const FilterSou
   }
 
   auto sourceV = spreadFilterBuffer->toFilterSource(source->scale);
-  lastBounds = filterBounds;
-  filterBounds = filtersBounds[2];
-  targetWidth = static_cast<int>(ceilf(filterBounds.width() * source->scale.x));
-  targetHeight = static_cast<int>(ceilf(filterBounds.height() * source->scale.y));
-  if (blurFilterBuffer == nullptr || blurFilterBuffer->width() != targetWidth ||
-      blurFilterBuffer->height() != targetHeight) {
-    blurFilterBuffer = FilterBuffer::Make(context, targetWidth, targetHeight);
-  }
-  if (blurFilterBuffer == nullptr) {
-    return;
-  }
-  blurFilterBuffer->clearColor(gl);
-  offsetMatrix = Matrix::MakeTrans((lastBounds.left - filterBounds.left) * source->scale.x,
-                                   (lastBounds.top - filterBounds.top) * source->scale.y);
-  auto targetV = blurFilterBuffer->toFilterTarget(offsetMatrix);
-  blurFilterV->updateParams(blurSize, 1.0, false, BlurMode::Shadow);
-  blurFilterV->draw(context, sourceV.get(), targetV.get());
-
-  auto sourceH = blurFilterBuffer->toFilterSource(source->scale);
-  Matrix revertMatrix =
-      Matrix::MakeTrans((filterBounds.left - contentBounds.left) * source->scale.x,
-                        (filterBounds.top - contentBounds.top) * source->scale.y);
-  auto targetH = *target;
-  PreConcatMatrix(&targetH, revertMatrix);
-  blurFilterH->updateParams(blurSize, opacity / 255.f, false, BlurMode::Shadow);
-  blurFilterH->draw(context, sourceH.get(), &targetH);
+  drawBlur(context, sourceV.get(), target, false);
 }
 
 void DropShadowFilter::onDrawModeFullSpread(Context* context, const FilterSource* source,
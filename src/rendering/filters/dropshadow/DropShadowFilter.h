@@ -21,6 +21,7 @@
 #include "DropShadowSpreadFilter.h"
 #include "rendering/filters/LayerFilter.h"
 #include "rendering/filters/gaussblur/SinglePassBlurFilter.h"
+#include "rendering/filters/utils/BlurPyramid.h"
 #include "rendering/filters/utils/FilterBuffer.h"
 
 namespace pag {
@@ -39,19 +40,18 @@ class DropShadowFilter : public LayerFilter {
  private:
   DropShadowStyle* layerStyle = nullptr;
 
-  std::shared_ptr<FilterBuffer> spreadFilterBuffer = nullptr;
-  std::shared_ptr<FilterBuffer> blurFilterBuffer = nullptr;
-
   SinglePassBlurFilter* blurFilterV = nullptr;
   SinglePassBlurFilter* blurFilterH = nullptr;
   DropShadowSpreadFilter* spreadFilter = nullptr;
   DropShadowSpreadFilter* spreadThickFilter = nullptr;
+  BlurPyramid* blurPyramid = nullptr;
 
   Color color = Black;
   float opacity = 0.0f;
   float spread = 0.0f;
   float spreadSize = 0.0f;
   float blurSize = 0.0f;
+  float scaledBlurSize = 0.0f;
   std::vector<Rect> filtersBounds = {};
 
   void updateParamModeNotSpread(Frame frame, const Rect& contentBounds,
@@ -61,6 +61,9 @@ class DropShadowFilter : public LayerFilter {
   void updateParamModeFullSpread(Frame frame, const Rect& contentBounds,
                                  const Rect& transformedBounds, const Point& filterScale);
 
+  void drawBlur(Context* context, const FilterSource* source, const FilterTarget* target,
+                bool colorBlur);
+
   void onDrawModeNotSpread(Context* context, const FilterSource* source,
                            const FilterTarget* target);
   void onDrawModeNotFullSpread(Context* context, const FilterSource* source,
@@ -24,11 +24,13 @@ namespace pag {
 GaussBlurFilter::GaussBlurFilter(Effect* effect) : effect(effect) {
   blurFilterV = new SinglePassBlurFilter(BlurDirection::Vertical);
   blurFilterH = new SinglePassBlurFilter(BlurDirection::Horizontal);
+  blurPyramid = new BlurPyramid();
 }
 
 GaussBlurFilter::~GaussBlurFilter() {
   delete blurFilterV;
   delete blurFilterH;
+  delete blurPyramid;
 }
 
 bool GaussBlurFilter::initialize(Context* context) {
@@ -38,6 +40,9 @@ bool GaussBlurFilter::initialize(Context* context) {
   if (!blurFilterH->initialize(context)) {
     return false;
   }
+  if (!blurPyramid->initialize(context)) {
+    return false;
+  }
   return true;
 }
 
@@ -50,6 +55,7 @@ void GaussBlurFilter::update(Frame frame, const Rect& contentBounds, const Rect&
   blurDirection =
       static_cast<BlurDirection>(gaussBlurEffect->blurDimensions->getValueAt(layerFrame));
   blurriness = gaussBlurEffect->blurriness->getValueAt(layerFrame);
+  scaledBlurriness = blurriness * std::min(filterScale.x, filterScale.y);
   auto expandY = blurriness * filterScale.y;
   filtersBounds.clear();
   filtersBounds.emplace_back(contentBounds);
@@ -82,37 +88,48 @@ void GaussBlurFilter::draw(Context* context, const FilterSource* source,
   }
   switch (blurDirection) {
     case BlurDirection::Vertical:
-      blurFilterV->updateParams(blurriness, 1.0, repeatEdge, BlurMode::Picture);
-      blurFilterV->draw(context, source, target);
+      drawSinglePass(context, blurFilterV, source, target);
       break;
     case BlurDirection::Horizontal:
-      blurFilterH->updateParams(blurriness, 1.0, repeatEdge, BlurMode::Picture);
-      blurFilterH->draw(context, source, target);
+      drawSinglePass(context, blurFilterH, source, target);
       break;
     case BlurDirection::Both:
-      blurFilterV->updateParams(blurriness, 1.0, repeatEdge, BlurMode::Picture);
       auto contentBounds = filtersBounds[0];
       auto blurVBounds = filtersBounds[1];
-      auto targetWidth = static_cast<int>(ceilf(blurVBounds.width() * source->scale.x));
-      auto targetHeight = static_cast<int>(ceilf(blurVBounds.height() * source->scale.y));
-      if (blurFilterBuffer == nullptr || blurFilterBuffer->width() != targetWidth ||
-          blurFilterBuffer->height() != targetHeight) {
-        blurFilterBuffer = FilterBuffer::Make(context, targetWidth, targetHeight);
+      auto outputBounds = filtersBounds[2];
+      auto levels = BlurPyramid::LevelCount(scaledBlurriness, BLUR_MODE_PIC_MAX_RADIUS,
+                                            contentBounds, source->scale);
+      auto blurSource = blurPyramid->downsample(context, source, contentBounds, levels);
+      if (blurSource == nullptr) {
+        return;
       }
+      auto scale = blurSource->scale;
+      blurFilterV->updateParams(blurriness, 1.0, repeatEdge, BlurMode::Picture, levels);
+      auto targetWidth = static_cast<int>(ceilf(blurVBounds.width() * scale.x));
+      auto targetHeight = static_cast<int>(ceilf(blurVBounds.height() * scale.y));
+      auto blurFilterBuffer = FilterBuffer::Make(context, targetWidth, targetHeight);
       if (blurFilterBuffer == nullptr) {
         return;
       }
       auto gl = GLContext::Unwrap(context);
       blurFilterBuffer->clearColor(gl);
 
-      auto offsetMatrix =
-          Matrix::MakeTrans((contentBounds.left - blurVBounds.left) * source->scale.x,
-                            (contentBounds.top - blurVBounds.top) * source->scale.y);
+      auto offsetMatrix = Matrix::MakeTrans((contentBounds.left - blurVBounds.left) * scale.x,
+                                            (contentBounds.top - blurVBounds.top) * scale.y);
       auto targetV = blurFilterBuffer->toFilterTarget(offsetMatrix);
-      blurFilterV->draw(context, source, targetV.get());
+      blurFilterV->draw(context, blurSource.get(), targetV.get());
 
-      auto sourceH = blurFilterBuffer->toFilterSource(source->scale);
-      blurFilterH->updateParams(blurriness, 1.0f, repeatEdge, BlurMode::Picture);
+      auto sourceH = blurFilterBuffer->toFilterSource(scale);
+      blurFilterH->updateParams(blurriness, 1.0f, repeatEdge, BlurMode::Picture, levels);
+      if (levels > 0) {
+        auto targetH = blurPyramid->makeOutputTarget(context, blurVBounds, outputBounds, scale);
+        if (targetH == nullptr) {
+          return;
+        }
+        blurFilterH->draw(context, sourceH.get(), targetH.get());
+        blurPyramid->upsample(context, contentBounds, outputBounds, source->scale, target);
+        break;
+      }
       Matrix revertMatrix =
           Matrix::MakeTrans((blurVBounds.left - contentBounds.left) * source->scale.x,
                             (blurVBounds.top - contentBounds.top) * source->scale.y);
@@ -122,4 +139,28 @@ void GaussBlurFilter::draw(Context* context, const FilterSource* source,
       break;
   }
 }
+
+void GaussBlurFilter::drawSinglePass(Context* context, SinglePassBlurFilter* blurFilter,
+                                     const FilterSource* source, const FilterTarget* target) {
+  auto contentBounds = filtersBounds[0];
+  auto outputBounds = filtersBounds[1];
+  auto levels = BlurPyramid::LevelCount(scaledBlurriness, BLUR_MODE_PIC_MAX_RADIUS, contentBounds,
+                                        source->scale);
+  blurFilter->updateParams(blurriness, 1.0f, repeatEdge, BlurMode::Picture, levels);
+  if (levels == 0) {
+    blurFilter->draw(context, source, target);
+    return;
+  }
+  auto blurSource = blurPyramid->downsample(context, source, contentBounds, levels, blurDirection);
+  if (blurSource == nullptr) {
+    return;
+  }
+  auto blurTarget =
+      blurPyramid->makeOutputTarget(context, contentBounds, outputBounds, blurSource->scale);
+  if (blurTarget == nullptr) {
+    return;
+  }
+  blurFilter->draw(context, blurSource.get(), blurTarget.get());
+  blurPyramid->upsample(context, contentBounds, outputBounds, source->scale, target);
+}
 }  // namespace pag
@@ -20,6 +20,7 @@
 
 #include "SinglePassBlurFilter.h"
 #include "rendering/filters/LayerFilter.h"
+#include "rendering/filters/utils/BlurPyramid.h"
 #include "rendering/filters/utils/FilterBuffer.h"
 
 namespace pag {
@@ -40,12 +41,15 @@ class GaussBlurFilter : public LayerFilter {
 
   SinglePassBlurFilter* blurFilterH = nullptr;
   SinglePassBlurFilter* blurFilterV = nullptr;
-
-  std::shared_ptr<FilterBuffer> blurFilterBuffer = nullptr;
+  BlurPyramid* blurPyramid = nullptr;
 
   bool repeatEdge = true;
   BlurDirection blurDirection = BlurDirection::Both;
   float blurriness = 0.0f;
+  float scaledBlurriness = 0.0f;
   std::vector<Rect> filtersBounds = {};
+
+  void drawSinglePass(Context* context, SinglePassBlurFilter* blurFilter,
+                      const FilterSource* source, const FilterTarget* target);
 };
 }  // namespace pag
@@ -94,10 +94,12 @@ void SinglePassBlurFilter::onPrepareProgram(const GLInterface* gl, unsigned int
 }
 
 void SinglePassBlurFilter::updateParams(float blurrinessValue, float blurOpacityValue,
-                                        bool repeatEdgeValue, BlurMode mode) {
+                                        bool repeatEdgeValue, BlurMode mode,
+                                        int downsampleLevelsValue) {
   blurriness = blurrinessValue;
   opacity = blurOpacityValue;
   repeatEdge = repeatEdgeValue;
+  downsampleLevels = downsampleLevelsValue;
   switch (mode) {
     case BlurMode::Picture:
       this->maxRadius = BLUR_MODE_PIC_MAX_RADIUS;
@@ -129,6 +131,14 @@ void SinglePassBlurFilter::onUpdateParams(const GLInterface* gl, const Rect& con
   auto blurValue = std::min(blurriness * scale, BLUR_LIMIT_BLURRINESS);
   auto blurRadius = blurValue / BLUR_LIMIT_BLURRINESS * (maxRadius - 1.0) + 1.0;
   auto blurLevel = blurValue / BLUR_LIMIT_BLURRINESS * (maxLevel - 1.0) + 1.0;
+  if (downsampleLevels > 0) {
+    // uLevel 是基于 content bounds 的归一化步长, 与纹理分辨率无关,
+    // 减少采样次数的同时按比例增大步长, 模糊范围保持不变。
+    auto factor = static_cast<float>(1 << downsampleLevels);
+    auto radius = std::max(roundf(blurRadius / factor), 1.0f);
+    blurLevel *= blurRadius / radius;
+    blurRadius = radius;
+  }
 
   gl->uniform1f(radiusHandle, blurRadius);
   gl->uniform2f(levelHandle,
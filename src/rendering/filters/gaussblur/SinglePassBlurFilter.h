@@ -27,7 +27,12 @@ class SinglePassBlurFilter : public LayerFilter {
   explicit SinglePassBlurFilter(BlurDirection blurDirection);
   ~SinglePassBlurFilter() override = default;
 
-  void updateParams(float blurriness, float opacity, bool repeatEdge, BlurMode mode);
+  /**
+   * Updates the blur parameters. If the source has been halved downsampleLevels times by a
+   * BlurPyramid, the blur samples fewer taps that lie further apart to keep the same spread.
+   */
+  void updateParams(float blurriness, float opacity, bool repeatEdge, BlurMode mode,
+                    int downsampleLevels = 0);
 
   void enableBlurColor(Color blurColor);
   void disableBlurColor();
@@ -59,5 +64,6 @@ class SinglePassBlurFilter : public LayerFilter {
   bool repeatEdge = true;
   float maxRadius = 3.0f;
   float maxLevel = 13.0f;
+  int downsampleLevels = 0;
 };
 }  // namespace pag
@@ -62,25 +62,6 @@ void GlowFilter::update(Frame frame, const Rect& contentBounds, const Rect& tran
   targetFilter->update(frame, contentBounds, transformedBounds, filterScale);
 }
 
-bool GlowFilter::checkBuffer(Context* context, int blurWidth, int blurHeight) {
-  if (blurFilterBufferH == nullptr || blurFilterBufferH->width() != blurWidth ||
-      blurFilterBufferH->height() != blurHeight) {
-    blurFilterBufferH = FilterBuffer::Make(context, blurWidth, blurHeight);
-  }
-  if (blurFilterBufferH == nullptr) {
-    return false;
-  }
-  if (blurFilterBufferV == nullptr || blurFilterBufferV->width() != blurWidth ||
-      blurFilterBufferV->height() != blurHeight) {
-    blurFilterBufferV = FilterBuffer::Make(context, blurWidth, blurHeight);
-  }
-  if (blurFilterBufferV == nullptr) {
-    blurFilterBufferH = nullptr;
-    return false;
-  }
-  return true;
-}
-
 void GlowFilter::draw(Context* context, const FilterSource* source, const FilterTarget* target) {
   if (source == nullptr || target == nullptr) {
     LOGE("GlowFilter::draw() can not draw filter");
@@ -89,7 +70,9 @@ void GlowFilter::draw(Context* context, const FilterSource* source, const Filter
   auto blurWidth = static_cast<int>(ceilf(source->width * resizeRatio));
   auto blurHeight = static_cast<int>(ceilf(source->height * resizeRatio));
 
-  if (!checkBuffer(context, blurWidth, blurHeight)) {
+  auto blurFilterBufferH = FilterBuffer::Make(context, blurWidth, blurHeight);
+  auto blurFilterBufferV = FilterBuffer::Make(context, blurWidth, blurHeight);
+  if (blurFilterBufferH == nullptr || blurFilterBufferV == nullptr) {
     return;
   }
   auto gl = GLContext::Unwrap(context);
@@ -44,10 +44,5 @@ class GlowFilter : public LayerFilter {
   GlowBlurFilter* blurFilterH = nullptr;
   GlowBlurFilter* blurFilterV = nullptr;
   GlowMergeFilter* targetFilter = nullptr;
-
-  std::shared_ptr<FilterBuffer> blurFilterBufferH = nullptr;
-  std::shared_ptr<FilterBuffer> blurFilterBufferV = nullptr;
-
-  bool checkBuffer(Context* context, int blurWidth, int blurHeight);
 };
 }  // namespace pag
@@ -0,0 +1,156 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "BlurPyramid.h"
+#include <atomic>
+#include "gpu/opengl/GLUtil.h"
+#include "rendering/filters/utils/FilterHelper.h"
+
+namespace pag {
+// 每一级降采样后, 单方向的采样半径不能小于该值, 否则模糊效果会出现明显的块状感。
+static constexpr float MIN_RADIUS = 4.0f;
+// 每一级降采样后, 模糊范围(像素)不能小于该值。
+static constexpr float MIN_BLUR_PIXELS = 4.0f;
+// 每一级降采样后, 纹理的短边(像素)不能小于该值。
+static constexpr float MIN_SIZE = 16.0f;
+static constexpr int MAX_LEVELS = 3;
+
+static std::atomic_bool pyramidEnabled = {false};
+
+void BlurPyramid::SetEnabled(bool enabled) {
+  pyramidEnabled = enabled;
+}
+
+bool BlurPyramid::IsEnabled() {
+  return pyramidEnabled;
+}
+
+int BlurPyramid::LevelCount(float blurValue, float maxRadius, const Rect& bounds,
+                            const Point& scale) {
+  if (!pyramidEnabled) {
+    return 0;
+  }
+  auto value = std::min(blurValue, BLUR_LIMIT_BLURRINESS);
+  auto radius = value / BLUR_LIMIT_BLURRINESS * (maxRadius - 1.0f) + 1.0f;
+  auto minScale = std::min(scale.x, scale.y);
+  auto blurPixels = value * minScale;
+  auto size = std::min(bounds.width() * scale.x, bounds.height() * scale.y);
+  int levels = 0;
+  while (levels < MAX_LEVELS) {
+    auto factor = static_cast<float>(2 << levels);
+    if (radius / factor < MIN_RADIUS || blurPixels / factor < MIN_BLUR_PIXELS ||
+        size / factor < MIN_SIZE) {
+      break;
+    }
+    levels++;
+  }
+  return levels;
+}
+
+BlurPyramid::BlurPyramid() {
+  copyFilter = new SubsetCopyFilter();
+}
+
+BlurPyramid::~BlurPyramid() {
+  delete copyFilter;
+}
+
+bool BlurPyramid::initialize(Context* context) {
+  return copyFilter->initialize(context);
+}
+
+std::unique_ptr<FilterSource> BlurPyramid::downsample(Context* context, const FilterSource* source,
+                                                      const Rect& bounds, int levels,
+                                                      BlurDirection direction) {
+  if (levels <= 0) {
+    return std::make_unique<FilterSource>(*source);
+  }
+  levelBuffers.resize(static_cast<size_t>(levels));
+  auto gl = GLContext::Unwrap(context);
+  std::unique_ptr<FilterSource> levelSource = nullptr;
+  const FilterSource* lastSource = source;
+  copyFilter->update(0, bounds, bounds, {1.0f, 1.0f});
+  auto factorX = direction == BlurDirection::Vertical ? 1.0f : 0.5f;
+  auto factorY = direction == BlurDirection::Horizontal ? 1.0f : 0.5f;
+  for (size_t i = 0; i < levelBuffers.size(); i++) {
+    auto& buffer = levelBuffers[i];
+    Point scale = {lastSource->scale.x * factorX, lastSource->scale.y * factorY};
+    auto width = static_cast<int>(ceilf(bounds.width() * scale.x));
+    auto height = static_cast<int>(ceilf(bounds.height() * scale.y));
+    // 中间层级只被 SubsetCopyFilter 采样, 可以使用尺寸取整后的缓存; 最后一级交给模糊滤镜, 需要精确尺寸。
+    auto approximateFit = i + 1 < levelBuffers.size();
+    buffer = FilterBuffer::Make(context, width, height, false, approximateFit);
+    if (buffer == nullptr) {
+      return nullptr;
+    }
+    buffer->clearColor(gl);
+    // 目标像素中心正好落在源纹理 2x2 (单方向时为 2x1) 像素的交点上,
+    // 一次线性采样即可得到它们的平均值。
+    auto target = buffer->toFilterTarget(Matrix::MakeScale(factorX, factorY));
+    if (i == 0) {
+      copyFilter->setSubset(source->width, source->height, source->width, source->height);
+    } else {
+      auto& lastBuffer = levelBuffers[i - 1];
+      copyFilter->setSubset(lastBuffer->width(), lastBuffer->height(), lastBuffer->textureWidth(),
+                            lastBuffer->textureHeight());
+    }
+    copyFilter->draw(context, lastSource, target.get());
+    levelSource = buffer->toFilterSource(scale);
+    lastSource = levelSource.get();
+  }
+  return levelSource;
+}
+
+std::unique_ptr<FilterTarget> BlurPyramid::makeOutputTarget(Context* context,
+                                                            const Rect& inputBounds,
+                                                            const Rect& outputBounds,
+                                                            const Point& scale) {
+  auto width = static_cast<int>(ceilf(outputBounds.width() * scale.x));
+  auto height = static_cast<int>(ceilf(outputBounds.height() * scale.y));
+  // 输出缓存只被 SubsetCopyFilter 放大采样, 可以使用尺寸取整后的缓存。
+  outputBuffer = FilterBuffer::Make(context, width, height, false, true);
+  if (outputBuffer == nullptr) {
+    return nullptr;
+  }
+  outputBuffer->clearColor(GLContext::Unwrap(context));
+  outputScale = scale;
+  auto offsetMatrix = Matrix::MakeTrans((inputBounds.left - outputBounds.left) * scale.x,
+                                        (inputBounds.top - outputBounds.top) * scale.y);
+  return outputBuffer->toFilterTarget(offsetMatrix);
+}
+
+void BlurPyramid::upsample(Context* context, const Rect& contentBounds, const Rect& outputBounds,
+                           const Point& scale, const FilterTarget* target) {
+  if (outputBuffer == nullptr) {
+    return;
+  }
+  auto source = outputBuffer->toFilterSource(outputScale);
+  auto matrix = Matrix::MakeTrans((outputBounds.left - contentBounds.left) * scale.x,
+                                  (outputBounds.top - contentBounds.top) * scale.y);
+  matrix.preScale(scale.x / outputScale.x, scale.y / outputScale.y);
+  auto upsampleTarget = *target;
+  PreConcatMatrix(&upsampleTarget, matrix);
+  copyFilter->update(0, outputBounds, outputBounds, {1.0f, 1.0f});
+  copyFilter->setSubset(outputBuffer->width(), outputBuffer->height(),
+                        outputBuffer->textureWidth(), outputBuffer->textureHeight());
+  copyFilter->draw(context, source.get(), &upsampleTarget);
+  // Hands the buffers back to the surface pool, so that the other filters can reuse them.
+  levelBuffers.clear();
+  outputBuffer = nullptr;
+}
+}  // namespace pag
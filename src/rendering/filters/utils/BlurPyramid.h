@@ -0,0 +1,94 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "rendering/filters/LayerFilter.h"
+#include "rendering/filters/utils/BlurTypes.h"
+#include "rendering/filters/utils/FilterBuffer.h"
+#include "rendering/filters/utils/SubsetCopyFilter.h"
+
+namespace pag {
+/**
+ * BlurPyramid runs large blurs at a reduced resolution. The source is halved a number of times
+ * before blurring, the blur passes draw into a small output buffer, and the result is scaled back
+ * up onto the final target. Blur filters keep the same spread on the smaller textures by sampling
+ * fewer taps that lie further apart, see SinglePassBlurFilter::updateParams().
+ *
+ * The full resolution blur samples the source every few pixels, while the reduced one samples the
+ * averaged pixels, so the results differ visibly around sharp edges. The pyramid is disabled by
+ * default and can be enabled by PAG::SetBlurDownsamplingEnabled().
+ */
+class BlurPyramid {
+ public:
+  /**
+   * Sets whether blur filters can draw large blurs at a reduced resolution. The default value is
+   * false.
+   */
+  static void SetEnabled(bool enabled);
+
+  /**
+   * Returns true if blur filters can draw large blurs at a reduced resolution.
+   */
+  static bool IsEnabled();
+
+  /**
+   * Returns how many times the source should be halved before blurring it.
+   * @param blurValue : the blurriness multiplied by the filterScale.
+   * @param maxRadius : the max radius of the blur mode, see BlurTypes.h.
+   * @param bounds : the bounds of the source in layer coordinates.
+   * @param scale : the scale of the source texture to the bounds.
+   */
+  static int LevelCount(float blurValue, float maxRadius, const Rect& bounds, const Point& scale);
+
+  BlurPyramid();
+  ~BlurPyramid();
+
+  bool initialize(Context* context);
+
+  /**
+   * Halves the source the given number of times and returns the smallest one, which stays valid
+   * until upsample() is called. Only the axes that the direction blurs along are halved, so a
+   * one-direction blur keeps the full resolution across it. Returns a copy of the source if levels
+   * is 0.
+   */
+  std::unique_ptr<FilterSource> downsample(Context* context, const FilterSource* source,
+                                           const Rect& bounds, int levels,
+                                           BlurDirection direction = BlurDirection::Both);
+
+  /**
+   * Returns a cleared target covering outputBounds at the given scale for the last blur pass,
+   * whose input covers inputBounds.
+   */
+  std::unique_ptr<FilterTarget> makeOutputTarget(Context* context, const Rect& inputBounds,
+                                                 const Rect& outputBounds, const Point& scale);
+
+  /**
+   * Draws the content of the last output target onto the full resolution target, which is
+   * relative to contentBounds, and then releases all the intermediate buffers.
+   */
+  void upsample(Context* context, const Rect& contentBounds, const Rect& outputBounds,
+                const Point& scale, const FilterTarget* target);
+
+ private:
+  SubsetCopyFilter* copyFilter = nullptr;
+  std::vector<std::shared_ptr<FilterBuffer>> levelBuffers = {};
+  std::shared_ptr<FilterBuffer> outputBuffer = nullptr;
+  Point outputScale = {};
+};
+}  // namespace pag
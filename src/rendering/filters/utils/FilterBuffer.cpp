@@ -17,21 +17,28 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "FilterBuffer.h"
+#include "gpu/SurfacePool.h"
+#include "gpu/opengl/GLSurface.h"
 #include "gpu/opengl/GLUtil.h"
 
 namespace pag {
 std::shared_ptr<FilterBuffer> FilterBuffer::Make(Context* context, int width, int height,
-                                                 bool usesMSAA) {
-  auto texture = GLTexture::MakeRGBA(context, width, height);
-  auto gl = GLContext::Unwrap(context);
-  auto sampleCount = usesMSAA ? gl->caps->getSampleCount(4, PixelConfig::RGBA_8888) : 1;
-  auto renderTarget = GLRenderTarget::MakeFrom(context, texture.get(), sampleCount);
-  if (renderTarget == nullptr) {
+                                                 bool usesMSAA, bool approximateFit) {
+  if (context == nullptr || width <= 0 || height <= 0) {
+    return nullptr;
+  }
+  auto sampleCount = usesMSAA ? 4 : 1;
+  auto surface = std::static_pointer_cast<GLSurface>(
+      context->getSurfacePool()->getSurface(width, height, sampleCount, approximateFit));
+  if (surface == nullptr) {
     return nullptr;
   }
   auto buffer = new FilterBuffer();
-  buffer->texture = texture;
-  buffer->renderTarget = renderTarget;
+  buffer->surface = surface;
+  buffer->texture = surface->getBackingTexture();
+  buffer->renderTarget = surface->getRenderTarget();
+  buffer->contentWidth = width;
+  buffer->contentHeight = height;
   return std::shared_ptr<FilterBuffer>(buffer);
 }
 
@@ -46,22 +53,32 @@ void FilterBuffer::clearColor(const GLInterface* gl) const {
 std::unique_ptr<FilterSource> FilterBuffer::toFilterSource(const Point& scale) const {
   auto filterSource = new FilterSource();
   filterSource->textureID = getTexture().id;
-  filterSource->width = texture->width();
-  filterSource->height = texture->height();
+  filterSource->width = contentWidth;
+  filterSource->height = contentHeight;
   filterSource->scale = scale;
-  // TODO(domrjchen): 这里的 ImageOrigin 是错的
-  filterSource->textureMatrix =
-      ToGLTextureMatrix(Matrix::I(), texture->width(), texture->height(), ImageOrigin::BottomLeft);
+  if (contentWidth == texture->width() && contentHeight == texture->height()) {
+    // TODO(domrjchen): 这里的 ImageOrigin 是错的
+    filterSource->textureMatrix = ToGLTextureMatrix(Matrix::I(), texture->width(),
+                                                    texture->height(), ImageOrigin::BottomLeft);
+  } else {
+    // The content is drawn into the sub-rect at the origin of the framebuffer, which is the bottom
+    // left corner of the texture, so the texture coordinates are simply scaled down.
+    filterSource->textureMatrix = ToGLMatrix(Matrix::MakeScale(
+        static_cast<float>(contentWidth) / static_cast<float>(texture->width()),
+        static_cast<float>(contentHeight) / static_cast<float>(texture->height())));
+  }
   return std::unique_ptr<FilterSource>(filterSource);
 }
 
 std::unique_ptr<FilterTarget> FilterBuffer::toFilterTarget(const Matrix& drawingMatrix) const {
   auto filterTarget = new FilterTarget();
   filterTarget->frameBufferID = getFramebuffer().id;
-  filterTarget->width = renderTarget->width();
-  filterTarget->height = renderTarget->height();
-  filterTarget->vertexMatrix = ToGLVertexMatrix(drawingMatrix, renderTarget->width(),
-                                                renderTarget->height(), ImageOrigin::BottomLeft);
+  // The viewport covers only the content, which is a sub-rect of the framebuffer if the buffer was
+  // made with an approximate fit.
+  filterTarget->width = contentWidth;
+  filterTarget->height = contentHeight;
+  filterTarget->vertexMatrix =
+      ToGLVertexMatrix(drawingMatrix, contentWidth, contentHeight, ImageOrigin::BottomLeft);
   return std::unique_ptr<FilterTarget>(filterTarget);
 }
 }  // namespace pag
@@ -24,10 +24,22 @@
 #include "rendering/filters/Filter.h"
 
 namespace pag {
+/**
+ * FilterBuffer is a temporary render target for filters. The buffers are taken from the
+ * SurfacePool of the context and go back to the pool once released, so filters should only hold
+ * them while drawing.
+ */
 class FilterBuffer {
  public:
+  /**
+   * Creates a buffer of the specified size. If approximateFit is true, the buffer may be backed by
+   * a larger surface from the pool and only covers its sub-rect at the origin. The texture matrix
+   * of its FilterSource maps into that sub-rect, so the buffer must only be sampled by filters
+   * that read their source at the texture coordinates alone, such as SubsetCopyFilter, but not by
+   * the filters that compare the coordinates with the texture edges or step by texels.
+   */
   static std::shared_ptr<FilterBuffer> Make(Context* context, int width, int height,
-                                            bool usesMSAA = false);
+                                            bool usesMSAA = false, bool approximateFit = false);
 
   void clearColor(const GLInterface* gl) const;
 
@@ -36,11 +48,27 @@ class FilterBuffer {
   std::unique_ptr<FilterTarget> toFilterTarget(const Matrix& drawingMatrix) const;
 
   int width() const {
-    return renderTarget->width();
+    return contentWidth;
   }
 
   int height() const {
-    return renderTarget->height();
+    return contentHeight;
+  }
+
+  /**
+   * Returns the width of the texture backing the buffer, which is larger than width() if the buffer
+   * was made with an approximate fit.
+   */
+  int textureWidth() const {
+    return texture->width();
+  }
+
+  /**
+   * Returns the height of the texture backing the buffer, which is larger than height() if the
+   * buffer was made with an approximate fit.
+   */
+  int textureHeight() const {
+    return texture->height();
   }
 
   bool usesMSAA() const {
@@ -58,8 +86,11 @@ class FilterBuffer {
   void resolve(Context* context);
 
  private:
+  std::shared_ptr<Surface> surface = nullptr;
   std::shared_ptr<GLRenderTarget> renderTarget = nullptr;
   std::shared_ptr<GLTexture> texture = nullptr;
+  int contentWidth = 0;
+  int contentHeight = 0;
   FilterBuffer() = default;
 };
 }  // namespace pag
@@ -0,0 +1,55 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SubsetCopyFilter.h"
+
+namespace pag {
+static constexpr char FRAGMENT_SHADER[] = R"(
+    #version 100
+    precision mediump float;
+    varying vec2 vertexColor;
+    uniform sampler2D sTexture;
+    uniform vec4 uTextureBounds;
+
+    void main() {
+        vec2 position = clamp(vertexColor, uTextureBounds.xy, uTextureBounds.zw);
+        gl_FragColor = texture2D(sTexture, position);
+    }
+)";
+
+void SubsetCopyFilter::setSubset(int width, int height, int textureWidth, int textureHeight) {
+  auto w = static_cast<float>(textureWidth);
+  auto h = static_cast<float>(textureHeight);
+  textureBounds.setLTRB(0.5f / w, 0.5f / h, (static_cast<float>(width) - 0.5f) / w,
+                        (static_cast<float>(height) - 0.5f) / h);
+}
+
+std::string SubsetCopyFilter::onBuildFragmentShader() {
+  return FRAGMENT_SHADER;
+}
+
+void SubsetCopyFilter::onPrepareProgram(const GLInterface* gl, unsigned int program) {
+  textureBoundsHandle = gl->getUniformLocation(program, "uTextureBounds");
+}
+
+void SubsetCopyFilter::onUpdateParams(const GLInterface* gl, const Rect&, const Point&) {
+  float values[4] = {textureBounds.left, textureBounds.top, textureBounds.right,
+                     textureBounds.bottom};
+  gl->uniform4fv(textureBoundsHandle, 1, values);
+}
+}  // namespace pag
@@ -0,0 +1,52 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "rendering/filters/LayerFilter.h"
+
+namespace pag {
+/**
+ * SubsetCopyFilter copies its source like a plain LayerFilter, but never samples outside the
+ * content of the source. The content of a FilterBuffer made with an approximate fit only covers a
+ * sub-rect of its texture, and linear sampling near the edges of the content would otherwise blend
+ * in the cleared pixels around it. Clamping the coordinates to the centers of the edge pixels
+ * gives the same result as the CLAMP_TO_EDGE wrap mode does for a texture of the exact size.
+ */
+class SubsetCopyFilter : public LayerFilter {
+ public:
+  /**
+   * Sets the size of the content of the next source and the size of the texture backing it.
+   */
+  void setSubset(int width, int height, int textureWidth, int textureHeight);
+
+ protected:
+  std::string onBuildFragmentShader() override;
+
+  void onPrepareProgram(const GLInterface* gl, unsigned program) override;
+
+  void onUpdateParams(const GLInterface* gl, const Rect& contentBounds,
+                      const Point& filterScale) override;
+
+ private:
+  Rect textureBounds = Rect::MakeWH(1, 1);
+
+  // Handle
+  int textureBoundsHandle = -1;
+};
+}  // namespace pag
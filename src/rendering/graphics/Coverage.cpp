@@ -0,0 +1,72 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Coverage.h"
+#include "gpu/Surface.h"
+
+namespace pag {
+// 碰撞检测用的透明度遮罩的最大像素数，更大的内容会先缩小再读取。
+static constexpr float MAX_COVERAGE_PIXELS = 512 * 512;
+
+std::unique_ptr<Coverage> Coverage::Make(Context* context, const Rect& bounds,
+                                         const Texture* texture, const Matrix& matrix,
+                                         const RGBAAALayout* layout) {
+  if (context == nullptr || texture == nullptr || bounds.isEmpty()) {
+    return nullptr;
+  }
+  auto scale = std::min(1.0f, sqrtf(MAX_COVERAGE_PIXELS / (bounds.width() * bounds.height())));
+  auto width = std::max(1, static_cast<int>(ceilf(bounds.width() * scale)));
+  auto height = std::max(1, static_cast<int>(ceilf(bounds.height() * scale)));
+  auto surface = Surface::Make(context, width, height);
+  if (surface == nullptr) {
+    return nullptr;
+  }
+  auto canvas = surface->getCanvas();
+  auto totalMatrix = Matrix::MakeScale(static_cast<float>(width) / bounds.width(),
+                                       static_cast<float>(height) / bounds.height());
+  totalMatrix.preTranslate(-bounds.x(), -bounds.y());
+  totalMatrix.preConcat(matrix);
+  canvas->setMatrix(totalMatrix);
+  canvas->drawTexture(texture, layout);
+  auto info = ImageInfo::Make(width, height, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  std::vector<uint8_t> colors(info.byteSize());
+  if (!surface->readPixels(info, colors.data())) {
+    return nullptr;
+  }
+  auto coverage = new Coverage();
+  coverage->bounds = bounds;
+  coverage->width = width;
+  coverage->height = height;
+  coverage->pixels.resize(static_cast<size_t>(width * height));
+  for (size_t i = 0; i < coverage->pixels.size(); i++) {
+    coverage->pixels[i] = colors[i * 4 + 3];
+  }
+  return std::unique_ptr<Coverage>(coverage);
+}
+
+bool Coverage::hitTest(float x, float y) const {
+  auto column = static_cast<int>(
+      floorf((x - bounds.x()) * static_cast<float>(width) / bounds.width()));
+  auto row = static_cast<int>(
+      floorf((y - bounds.y()) * static_cast<float>(height) / bounds.height()));
+  if (column < 0 || column >= width || row < 0 || row >= height) {
+    return false;
+  }
+  return pixels[row * width + column] > 0;
+}
+}  // namespace pag
@@ -0,0 +1,64 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+#include "core/Paint.h"
+#include "gpu/Texture.h"
+
+namespace pag {
+/**
+ * Coverage keeps the alpha channel of a Picture in CPU memory at a reduced resolution, so the
+ * following hit tests of the Picture don't touch the GPU.
+ */
+class Coverage {
+ public:
+  /**
+   * Reads back the alpha channel of the texture drawn with the specified matrix and layout. The
+   * bounds are the content bounds of the Picture which the matrix maps the texture into. Returns
+   * nullptr if the bounds are empty or the pixels fail to read back.
+   */
+  static std::unique_ptr<Coverage> Make(Context* context, const Rect& bounds,
+                                        const Texture* texture, const Matrix& matrix,
+                                        const RGBAAALayout* layout = nullptr);
+
+  /**
+   * Returns true if the pixel at the specified point in the content coordinates is not fully
+   * transparent.
+   */
+  bool hitTest(float x, float y) const;
+
+  /**
+   * Returns memory usage information for this Coverage.
+   */
+  size_t memoryUsage() const {
+    return pixels.size();
+  }
+
+ private:
+  Rect bounds = Rect::MakeEmpty();
+  int width = 0;
+  int height = 0;
+  std::vector<uint8_t> pixels = {};
+  uint64_t makerKey = 0;
+  Frame idleFrames = 0;
+
+  friend class RenderCache;
+};
+}  // namespace pag
@@ -48,6 +48,7 @@ class MatrixGraphic : public ComposeGraphic {
   bool getPath(Path* path) const override;
   void prepare(RenderCache* cache) const override;
   void draw(Canvas* canvas, RenderCache* cache) const override;
+  size_t memoryUsage() const override;
   std::shared_ptr<Graphic> mergeWith(const Matrix& matrix) const override;
 
  protected:
@@ -106,6 +107,10 @@ void MatrixGraphic::draw(Canvas* canvas, RenderCache* cache) const {
   canvas->restore();
 }
 
+size_t MatrixGraphic::memoryUsage() const {
+  return sizeof(MatrixGraphic) + graphic->memoryUsage();
+}
+
 std::shared_ptr<Graphic> MatrixGraphic::mergeWith(const Matrix& m) const {
   auto totalMatrix = matrix;
   totalMatrix.postConcat(m);
@@ -128,6 +133,7 @@ class LayerGraphic : public ComposeGraphic {
   bool getPath(Path* path) const override;
   void prepare(RenderCache* cache) const override;
   void draw(Canvas* canvas, RenderCache* cache) const override;
+  size_t memoryUsage() const override;
   std::shared_ptr<Graphic> mergeWith(const Matrix& matrix) const override;
 
  private:
@@ -193,6 +199,14 @@ void LayerGraphic::draw(Canvas* canvas, RenderCache* cache) const {
   }
 }
 
+size_t LayerGraphic::memoryUsage() const {
+  auto memory = sizeof(LayerGraphic) + contents.size() * sizeof(std::shared_ptr<Graphic>);
+  for (auto& content : contents) {
+    memory += content->memoryUsage();
+  }
+  return memory;
+}
+
 std::shared_ptr<Graphic> LayerGraphic::mergeWith(const Matrix& m) const {
   std::vector<std::shared_ptr<Graphic>> newContents = {};
   for (auto& graphic : contents) {
@@ -221,6 +235,7 @@ class ModifierGraphic : public ComposeGraphic {
   bool getPath(Path* path) const override;
   void prepare(RenderCache* cache) const override;
   void draw(Canvas* canvas, RenderCache* cache) const override;
+  size_t memoryUsage() const override;
   std::shared_ptr<Graphic> mergeWith(const Modifier* target) const override;
 
  private:
@@ -280,6 +295,10 @@ void ModifierGraphic::draw(Canvas* canvas, RenderCache* cache) const {
   canvas->restore();
 }
 
+size_t ModifierGraphic::memoryUsage() const {
+  return sizeof(ModifierGraphic) + graphic->memoryUsage();
+}
+
 std::shared_ptr<Graphic> ModifierGraphic::mergeWith(const Modifier* target) const {
   if (target == nullptr || modifier->type() != target->type()) {
     return nullptr;
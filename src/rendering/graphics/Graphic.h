@@ -97,5 +97,11 @@ class Graphic {
    * Draw this Graphic into specified Canvas.
    */
   virtual void draw(Canvas* canvas, RenderCache* cache) const = 0;
+
+  /**
+   * Returns the estimated CPU memory in bytes held by this Graphic, such as paths and glyphs. The
+   * pixels of images are not included, since they are owned by the image and render caches.
+   */
+  virtual size_t memoryUsage() const = 0;
 };
 }  // namespace pag
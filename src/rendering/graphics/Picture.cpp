@@ -89,6 +89,24 @@ static std::shared_ptr<Texture> RescaleTexture(Context* context, Texture* textur
   return surface->getTexture();
 }
 
+// 使用 CPU 上缓存的透明度遮罩进行碰撞检测，已有 Snapshot 时直接从它读取遮罩。
+// 没有可用的遮罩时返回 false。
+static bool HitTestCoverage(RenderCache* cache, const Picture* picture, ID assetID, float x,
+                            float y, bool* result) {
+  auto coverage = cache->getCoverage(picture);
+  if (coverage == nullptr) {
+    auto snapshot = cache->getSnapshot(assetID);
+    if (snapshot != nullptr) {
+      coverage = cache->makeCoverage(picture, snapshot->getTexture(), snapshot->getMatrix());
+    }
+  }
+  if (coverage == nullptr) {
+    return false;
+  }
+  *result = coverage->hitTest(x, y);
+  return true;
+}
+
 //================================= TextureProxySnapshotPicture ====================================
 class TextureProxyPicture : public Picture {
  public:
@@ -106,10 +124,11 @@ class TextureProxyPicture : public Picture {
 
   bool hitTest(RenderCache* cache, float x, float y) override {
     // 碰撞检测过程不允许生成新的GPU缓存，因为碰撞结束不会触发缓存清理操作，长时间不进入下一次绘制有可能导致显存泄露。
-    auto snapshot = cache->getSnapshot(assetID);
-    if (snapshot) {
-      return snapshot->hitTest(cache, x, y);
+    bool result = false;
+    if (HitTestCoverage(cache, this, assetID, x, y, &result)) {
+      return result;
     }
+    // 还没有透明度遮罩时只读取一个像素，遮罩在下一次绘制纹理时生成。
     auto texture = proxy->getTexture(cache);
     if (texture == nullptr) {
       return false;
@@ -119,7 +138,9 @@ class TextureProxyPicture : public Picture {
       return false;
     }
     auto canvas = surface->getCanvas();
-    canvas->setMatrix(Matrix::MakeTrans(-x, -y));
+    auto matrix = Matrix::MakeTrans(-x, -y);
+    matrix.preConcat(getTextureMatrix(texture.get()));
+    canvas->setMatrix(matrix);
     canvas->drawTexture(texture.get());
     return surface->hitTest(0, 0);
   }
@@ -132,6 +153,10 @@ class TextureProxyPicture : public Picture {
     proxy->prepare(cache);
   }
 
+  size_t memoryUsage() const override {
+    return sizeof(TextureProxyPicture);
+  }
+
   void draw(Canvas* canvas, RenderCache* cache) const override {
     auto oldMatrix = canvas->getMatrix();
     canvas->concat(extraMatrix);
@@ -139,23 +164,66 @@ class TextureProxyPicture : public Picture {
       auto texture = proxy->getTexture(cache);
       if (TryDrawDirectly(canvas, texture.get(), nullptr)) {
         canvas->setMatrix(oldMatrix);
+        updateCoverage(cache, texture.get());
         return;
       }
     }
     auto snapshot = cache->getSnapshot(this);
     if (snapshot) {
       canvas->drawTexture(snapshot->getTexture(), snapshot->getMatrix());
-    } else {
-      auto texture = proxy->getTexture(cache);
-      DrawDirectly(canvas, texture.get(), nullptr);
+      canvas->setMatrix(oldMatrix);
+      if (cache->coverageRequested(this)) {
+        canvas->flush();
+        cache->makeCoverage(this, snapshot->getTexture(), snapshot->getMatrix());
+      }
+      return;
+    }
+    auto texture = proxy->getTexture(cache);
+    if (texture != nullptr) {
+      canvas->concat(getTextureMatrix(texture.get()));
     }
+    DrawDirectly(canvas, texture.get(), nullptr);
     canvas->setMatrix(oldMatrix);
+    updateCoverage(cache, texture.get());
   }
 
  private:
   TextureProxy* proxy = nullptr;
   bool externalMemory = false;
   Matrix extraMatrix = Matrix::I();
+  // 为 true 时表示纹理来自 Image 解码，有可能按照缩小后的尺寸解码。
+  bool scaledDecoding = false;
+
+  /**
+   * Returns the size of the content before the extraMatrix is applied.
+   */
+  Rect getContentBounds() const {
+    auto bounds = Rect::MakeWH(proxy->width(), proxy->height());
+    auto invertMatrix = Matrix::I();
+    if (extraMatrix.invert(&invertMatrix)) {
+      invertMatrix.mapRect(&bounds);
+    }
+    return bounds;
+  }
+
+  void updateCoverage(RenderCache* cache, const Texture* texture) const {
+    if (texture != nullptr && cache->coverageRequested(this)) {
+      cache->makeCoverage(this, texture, getTextureMatrix(texture));
+    }
+  }
+
+  /**
+   * Returns the matrix that maps the texture to the content size. The texture of an image may be
+   * decoded at a reduced size.
+   */
+  Matrix getTextureMatrix(const Texture* texture) const {
+    if (!scaledDecoding) {
+      return Matrix::I();
+    }
+    auto bounds = getContentBounds();
+    return Matrix::MakeScale(bounds.width() / static_cast<float>(texture->width()),
+                             bounds.height() / static_cast<float>(texture->height()));
+  }
 
   float getScaleFactor(float maxScaleFactor) const override {
     if (externalMemory) {
@@ -170,8 +238,20 @@ class TextureProxyPicture : public Picture {
     if (texture == nullptr) {
       return nullptr;
     }
-    if (scaleFactor != 1.0f || texture->isYUV()) {
-      texture = RescaleTexture(cache->getContext(), texture.get(), scaleFactor);
+    auto rescaleFactor = scaleFactor;
+    if (scaledDecoding) {
+      // 图片纹理有可能已经按照目标尺寸解码，尺寸一致时无需再缩放。
+      auto bounds = getContentBounds();
+      auto width = static_cast<int>(ceilf(bounds.width() * scaleFactor));
+      auto height = static_cast<int>(ceilf(bounds.height() * scaleFactor));
+      if (width == texture->width() && height == texture->height()) {
+        rescaleFactor = 1.0f;
+      } else {
+        rescaleFactor = scaleFactor * bounds.width() / static_cast<float>(texture->width());
+      }
+    }
+    if (rescaleFactor != 1.0f || texture->isYUV()) {
+      texture = RescaleTexture(cache->getContext(), texture.get(), rescaleFactor);
     }
     if (texture == nullptr) {
       return nullptr;
@@ -201,10 +281,11 @@ class RGBAAAPicture : public Picture {
 
   bool hitTest(RenderCache* cache, float x, float y) override {
     // 碰撞检测过程不允许生成新的GPU缓存，因为碰撞结束不会触发缓存清理操作，长时间不进入下一次绘制有可能导致显存泄露。
-    auto snapshot = cache->getSnapshot(assetID);
-    if (snapshot) {
-      return snapshot->hitTest(cache, x, y);
+    bool result = false;
+    if (HitTestCoverage(cache, this, assetID, x, y, &result)) {
+      return result;
     }
+    // 还没有透明度遮罩时只读取一个像素，遮罩在下一次绘制纹理时生成。
     auto texture = proxy->getTexture(cache);
     auto surface = Surface::Make(cache->getContext(), 1, 1);
     if (surface == nullptr) {
@@ -225,12 +306,17 @@ class RGBAAAPicture : public Picture {
     proxy->prepare(cache);
   }
 
+  size_t memoryUsage() const override {
+    return sizeof(RGBAAAPicture);
+  }
+
   void draw(Canvas* canvas, RenderCache* cache) const override {
     if (proxy->cacheEnabled()) {
       // proxy在纯静态视频序列帧中不会缓存解码器
       // 如果将texture获取放在snapshot获取之前，会导致每帧都创建解码器
       auto texture = proxy->getTexture(cache);
       if (TryDrawDirectly(canvas, texture.get(), &layout)) {
+        updateCoverage(cache, texture.get());
         return;
       }
     }
@@ -240,16 +326,27 @@ class RGBAAAPicture : public Picture {
     auto snapshot = cache->getSnapshot(this);
     if (snapshot) {
       canvas->drawTexture(snapshot->getTexture(), snapshot->getMatrix());
+      if (cache->coverageRequested(this)) {
+        canvas->flush();
+        cache->makeCoverage(this, snapshot->getTexture(), snapshot->getMatrix());
+      }
       return;
     }
     auto texture = proxy->getTexture(cache);
     DrawDirectly(canvas, texture.get(), &layout);
+    updateCoverage(cache, texture.get());
   }
 
  private:
   TextureProxy* proxy = nullptr;
   RGBAAALayout layout = {};
 
+  void updateCoverage(RenderCache* cache, const Texture* texture) const {
+    if (texture != nullptr && cache->coverageRequested(this)) {
+      cache->makeCoverage(this, texture, Matrix::I(), &layout);
+    }
+  }
+
   float getScaleFactor(float maxScaleFactor) const override {
     // 视频帧缩放值不需要大于 1.0f，清晰度无法继续提高。
     return std::min(maxScaleFactor, 1.0f);
@@ -292,9 +389,9 @@ class SnapshotPicture : public Picture {
 
   bool hitTest(RenderCache* cache, float x, float y) override {
     // 碰撞检测过程不允许生成新的GPU缓存，因为碰撞结束不会触发缓存清理操作，长时间不进入下一次绘制有可能导致显存泄露。
-    auto snapshot = cache->getSnapshot(assetID);
-    if (snapshot) {
-      return snapshot->hitTest(cache, x, y);
+    bool result = false;
+    if (HitTestCoverage(cache, this, assetID, x, y, &result)) {
+      return result;
     }
     return graphic->hitTest(cache, x, y);
   }
@@ -307,6 +404,10 @@ class SnapshotPicture : public Picture {
     graphic->prepare(cache);
   }
 
+  size_t memoryUsage() const override {
+    return sizeof(SnapshotPicture) + graphic->memoryUsage();
+  }
+
   void draw(Canvas* canvas, RenderCache* cache) const override {
     auto options = static_cast<const SnapshotPictureOptions*>(canvas->surfaceOptions());
     if (options && options->skipSnapshotPictureCache) {
@@ -319,6 +420,10 @@ class SnapshotPicture : public Picture {
       return;
     }
     canvas->drawTexture(snapshot->getTexture(), snapshot->getMatrix());
+    if (cache->coverageRequested(this)) {
+      canvas->flush();
+      cache->makeCoverage(this, snapshot->getTexture(), snapshot->getMatrix());
+    }
   }
 
  protected:
@@ -390,7 +495,8 @@ class ImageTextureProxy : public TextureProxy {
   }
 
   void prepare(RenderCache* cache) const override {
-    cache->prepareImage(assetID, image);
+    // The graphic being prepared is going to be drawn in the current frame.
+    cache->prepareImage(assetID, image, TaskPriority::High);
   }
 
   std::shared_ptr<Texture> getTexture(RenderCache* cache) const override {
@@ -472,6 +578,7 @@ std::shared_ptr<Graphic> Picture::MakeFrom(ID assetID, std::shared_ptr<Image> im
                                             static_cast<int>(bounds.height()), image);
   auto picture = std::make_shared<TextureProxyPicture>(assetID, textureProxy, false);
   picture->extraMatrix = extraMatrix;
+  picture->scaledDecoding = true;
   return picture;
 }
 
@@ -76,4 +76,9 @@ void Shape::draw(Canvas* canvas, RenderCache*) const {
   }
 }
 
+size_t Shape::memoryUsage() const {
+  return sizeof(Shape) + sizeof(GradientFill) + path.countPoints() * sizeof(Point) +
+         path.countVerbs();
+}
+
 }  // namespace pag
\ No newline at end of file
@@ -71,6 +71,7 @@ class Shape : public Graphic {
   bool getPath(Path* result) const override;
   void prepare(RenderCache* cache) const override;
   void draw(Canvas* canvas, RenderCache* cache) const override;
+  size_t memoryUsage() const override;
 
  private:
   Path path = {};
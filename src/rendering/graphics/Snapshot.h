@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <list>
 #include "gpu/Texture.h"
 
 namespace pag {
@@ -71,6 +72,8 @@ class Snapshot {
   ID assetID = 0;
   uint64_t makerKey = 0;
   Frame idleFrames = 0;
+  int64_t makingCost = 0;
+  std::list<Snapshot*>::iterator lruPosition = {};
 
   friend class RenderCache;
 };
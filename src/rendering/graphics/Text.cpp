@@ -241,6 +241,15 @@ void Text::draw(Canvas* canvas, RenderCache*) const {
   drawTextRuns(static_cast<Canvas*>(canvas), 1);
 }
 
+size_t Text::memoryUsage() const {
+  auto memory = sizeof(Text);
+  for (auto textRun : textRuns) {
+    memory += sizeof(TextRun) + textRun->glyphIDs.size() * sizeof(GlyphID) +
+              textRun->positions.size() * sizeof(Point);
+  }
+  return memory;
+}
+
 void Text::drawTextRuns(Canvas* canvas, int paintIndex) const {
   auto totalMatrix = canvas->getMatrix();
   for (auto& textRun : textRuns) {
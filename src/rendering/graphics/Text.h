@@ -56,6 +56,7 @@ class Text : public Graphic {
   bool getPath(Path* path) const override;
   void prepare(RenderCache* cache) const override;
   void draw(Canvas* canvas, RenderCache* cache) const override;
+  size_t memoryUsage() const override;
 
  private:
   std::vector<TextRun*> textRuns;
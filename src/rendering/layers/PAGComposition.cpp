@@ -25,6 +25,7 @@
 #include "rendering/graphics/Recorder.h"
 #include "rendering/layers/PAGStage.h"
 #include "rendering/renderers/LayerRenderer.h"
+#include "rendering/utils/BoundsIndex.h"
 #include "rendering/utils/LockGuard.h"
 #include "rendering/utils/ScopedLock.h"
 
@@ -60,6 +61,7 @@ PAGComposition::PAGComposition(std::shared_ptr<File> file, PreComposeLayer* laye
 }
 
 PAGComposition::~PAGComposition() {
+  delete childBoundsIndex;
   removeAllLayers();
   if (emptyComposition) {
     delete emptyComposition;  // created by PAGComposition(width, height).
@@ -567,8 +569,10 @@ bool PAGComposition::getLayersUnderPointInternal(float x, float y,
     return false;
   }
   bool found = false;
-  for (int i = static_cast<int>(layers.size()) - 1; i >= 0; i--) {
-    auto childLayer = layers[i];
+  std::vector<int> childIndices = {};
+  findChildIndicesAt(x, y, &childIndices);
+  for (auto i = childIndices.rbegin(); i != childIndices.rend(); i++) {
+    auto childLayer = layers[*i];
     if (!childLayer->layerVisible) {
       continue;
     }
@@ -585,6 +589,56 @@ bool PAGComposition::getLayersUnderPointInternal(float x, float y,
   return found;
 }
 
+// Compositions with fewer children are cheaper to walk through than to build the index.
+static constexpr size_t MIN_INDEXED_CHILD_COUNT = 8;
+
+bool PAGComposition::HasTrackMatteLayer(PAGLayer* pagLayer) {
+  if (pagLayer->_trackMatteLayer != nullptr) {
+    return true;
+  }
+  if (pagLayer->layerType() != LayerType::PreCompose) {
+    return false;
+  }
+  for (auto& childLayer : static_cast<PAGComposition*>(pagLayer)->layers) {
+    if (HasTrackMatteLayer(childLayer.get())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PAGComposition::findChildIndicesAt(float x, float y, std::vector<int>* results) {
+  if (stage == nullptr || layers.size() < MIN_INDEXED_CHILD_COUNT) {
+    for (int i = 0; i < static_cast<int>(layers.size()); i++) {
+      results->push_back(i);
+    }
+    return;
+  }
+  // Any change of the descendants, including their frames, bumps the content version of the stage.
+  if (childBoundsIndex == nullptr || childBoundsVersion != stage->getContentVersion()) {
+    std::vector<Rect> boundsList = {};
+    for (auto& childLayer : layers) {
+      Rect bounds = Rect::MakeEmpty();
+      if (HasTrackMatteLayer(childLayer.get())) {
+        // The track matte layers are reported even if they lie outside the bounds of the layers
+        // they belong to, so these layers are always tested.
+        bounds.setLTRB(-INFINITY, -INFINITY, INFINITY, INFINITY);
+      } else if (childLayer->layerVisible) {
+        MeasureChildLayer(&bounds, childLayer.get());
+        if (!bounds.isEmpty()) {
+          // Leaves some room for the rounding errors of mapping the bounds by the layer matrices.
+          bounds.outset(1.0f, 1.0f);
+        }
+      }
+      boundsList.push_back(bounds);
+    }
+    delete childBoundsIndex;
+    childBoundsIndex = new BoundsIndex(boundsList);
+    childBoundsVersion = stage->getContentVersion();
+  }
+  childBoundsIndex->query(x, y, results);
+}
+
 bool PAGComposition::cacheFilters() const {
   return layerCache->cacheFilters() && !contentModified() && layerCache->contentStatic();
 }
@@ -221,8 +221,12 @@ void PAGImageLayer::replaceImageInternal(std::shared_ptr<PAGImage> image) {
   });
 }
 
-Content* PAGImageLayer::getContent() {
-  return hasPAGImage() ? replacement : layerCache->getContent(contentFrame);
+std::shared_ptr<Content> PAGImageLayer::getContent() {
+  if (hasPAGImage()) {
+    // The replacement is owned by this layer, the returned pointer does not own it.
+    return std::shared_ptr<Content>(std::shared_ptr<Content>(), replacement);
+  }
+  return layerCache->getContent(contentFrame);
 }
 
 bool PAGImageLayer::contentModified() const {
@@ -54,9 +54,10 @@ PAGSolidLayer::~PAGSolidLayer() {
   delete emptySolidLayer;
 }
 
-Content* PAGSolidLayer::getContent() {
+std::shared_ptr<Content> PAGSolidLayer::getContent() {
   if (replacement != nullptr) {
-    return replacement;
+    // The replacement is owned by this layer, the returned pointer does not own it.
+    return std::shared_ptr<Content>(std::shared_ptr<Content>(), replacement);
   }
   return layerCache->getContent(contentFrame);
 }
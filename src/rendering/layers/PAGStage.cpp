@@ -343,6 +343,9 @@ Point PAGStage::GetLayerContentScaleFactor(PAGLayer* pagLayer, bool isPAGImage)
     if (composition->type() == CompositionType::Video ||
         composition->type() == CompositionType::Bitmap) {
       auto sequence = Sequence::Get(composition);
+      if (sequence == nullptr) {
+        return scale;
+      }
       scale.x = static_cast<float>(composition->width) / static_cast<float>(sequence->width);
       scale.y = static_cast<float>(composition->height) / static_cast<float>(sequence->height);
     }
@@ -166,7 +166,7 @@ void PAGTextLayer::reset() {
   }
 }
 
-Content* PAGTextLayer::getContent() {
+std::shared_ptr<Content> PAGTextLayer::getContent() {
   if (replacement != nullptr) {
     return replacement->getContent(contentFrame);
   }
@@ -80,7 +80,7 @@ void BitmapSequenceReader::prepareAsync(Frame targetFrame) {
       pendingFrame = targetFrame;
     }
   } else {
-    lastTask = BitmapDecodingTask::MakeAndRun(this, targetFrame);
+    lastTask = BitmapDecodingTask::MakeAndRun(this, targetFrame, TaskPriority::Low);
   }
 }
 
@@ -106,7 +106,7 @@ std::shared_ptr<Texture> BitmapSequenceReader::readTexture(Frame targetFrame, Re
       pendingFrame = -1;
     }
     if (nextFrame < sequence->duration()) {
-      lastTask = BitmapDecodingTask::MakeAndRun(this, nextFrame);
+      lastTask = BitmapDecodingTask::MakeAndRun(this, nextFrame, TaskPriority::High);
     }
   }
   return lastTexture;
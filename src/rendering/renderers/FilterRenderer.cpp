@@ -184,7 +184,7 @@ std::shared_ptr<Graphic> GetDisplacementMapGraphic(const FilterList* filterList,
   auto contentFrame = filterList->layerFrame - mapLayer->startTime;
   auto layerCache = LayerCache::Get(mapLayer);
   auto content = layerCache->getContent(contentFrame);
-  return static_cast<GraphicContent*>(content)->graphic;
+  return static_cast<GraphicContent*>(content.get())->graphic;
 }
 
 static bool MakeLayerStyleNode(std::vector<FilterNode>& filterNodes, Rect& clipBounds,
@@ -306,11 +306,9 @@ void ApplyFilters(Context* context, std::vector<FilterNode> filterNodes, const R
   GLStateGuard stateGuard(context);
   auto gl = GLContext::Unwrap(context);
   auto scale = filterSource->scale;
-  std::shared_ptr<FilterBuffer> freeBuffer = nullptr;
   std::shared_ptr<FilterBuffer> lastBuffer = nullptr;
   std::shared_ptr<FilterSource> lastSource = nullptr;
   auto lastBounds = contentBounds;
-  auto lastUsesMSAA = false;
   auto size = static_cast<int>(filterNodes.size());
   for (int i = 0; i < size; i++) {
     auto& node = filterNodes[i];
@@ -319,15 +317,11 @@ void ApplyFilters(Context* context, std::vector<FilterNode> filterNodes, const R
       node.filter->draw(context, source, filterTarget);
       break;
     }
-    std::shared_ptr<FilterBuffer> currentBuffer = nullptr;
-    if (freeBuffer && node.bounds.width() == lastBounds.width() &&
-        node.bounds.height() == lastBounds.height() && node.filter->needsMSAA() == lastUsesMSAA) {
-      currentBuffer = freeBuffer;
-    } else {
-      currentBuffer = FilterBuffer::Make(
-          context, static_cast<int>(ceilf(node.bounds.width() * scale.x)),
-          static_cast<int>(ceilf(node.bounds.height() * scale.y)), node.filter->needsMSAA());
-    }
+    // Only the buffer of the previous node is still referenced, so the buffers of the same size
+    // are taken from the pool in turn.
+    auto currentBuffer = FilterBuffer::Make(
+        context, static_cast<int>(ceilf(node.bounds.width() * scale.x)),
+        static_cast<int>(ceilf(node.bounds.height() * scale.y)), node.filter->needsMSAA());
     if (currentBuffer == nullptr) {
       return;
     }
@@ -338,10 +332,8 @@ void ApplyFilters(Context* context, std::vector<FilterNode> filterNodes, const R
     node.filter->draw(context, source, currentTarget.get());
     currentBuffer->resolve(context);
     lastSource = currentBuffer->toFilterSource(scale);
-    freeBuffer = lastBuffer;
     lastBuffer = currentBuffer;
     lastBounds = node.bounds;
-    lastUsesMSAA = currentBuffer->usesMSAA();
   }
 }
 
@@ -46,7 +46,9 @@ void LayerRenderer::DrawLayer(Recorder* recorder, Layer* layer, Frame layerFrame
   if (!layerCache->contentVisible(contentFrame)) {
     return;
   }
-  auto content = layerContent ? layerContent : layerCache->getContent(contentFrame);
+  // Holds the cached content until drawing is done, in case the frame is evicted meanwhile.
+  auto cachedContent = layerContent ? nullptr : layerCache->getContent(contentFrame);
+  auto content = layerContent ? layerContent : cachedContent.get();
   auto layerTransform = layerCache->getTransform(contentFrame);
   auto opacity = layerTransform->opacity;
   if (extraTransform) {
@@ -110,7 +112,8 @@ void LayerRenderer::MeasureLayerBounds(Rect* bounds, Layer* layer, Frame layerFr
   if (!layerCache->contentVisible(contentFrame)) {
     return;
   }
-  auto content = layerContent ? layerContent : layerCache->getContent(contentFrame);
+  auto cachedContent = layerContent ? nullptr : layerCache->getContent(contentFrame);
+  auto content = layerContent ? layerContent : cachedContent.get();
   auto masks = layerCache->getMasks(contentFrame);
   content->measureBounds(bounds);
   if (masks) {
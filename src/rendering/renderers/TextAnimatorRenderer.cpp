@@ -21,7 +21,7 @@
 namespace pag {
 
 // 判断是否包含动画
-static bool HasAnimator(const std::vector<TextAnimator*>* animators) {
+bool TextAnimatorRenderer::HasAnimator(const std::vector<TextAnimator*>* animators) {
   if (animators != nullptr) {
     for (auto animator : *animators) {
       auto typographyProperties = animator->typographyProperties;
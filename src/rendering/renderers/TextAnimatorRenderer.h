@@ -26,6 +26,8 @@ namespace pag {
 
 class TextAnimatorRenderer {
  public:
+  // 判断是否含有会修改 Glyphs 的文本动画
+  static bool HasAnimator(const std::vector<TextAnimator*>* animators);
   // 应用动画到Glyphs, 如果含有动画内容返回 true
   static bool ApplyToGlyphs(std::vector<std::vector<GlyphHandle>>& glyphList,
                             const std::vector<TextAnimator*>* animators,
@@ -19,6 +19,7 @@
 #include "TextRenderer.h"
 #include "TextAnimatorRenderer.h"
 #include "raster/PathEffect.h"
+#include "rendering/FontManager.h"
 #include "rendering/graphics/Shape.h"
 #include "rendering/graphics/Text.h"
 
@@ -26,6 +27,7 @@ namespace pag {
 
 #define LINE_GAP_FACTOR 1.2f
 #define EMPTY_LINE_WIDTH 1.0f
+#define MAX_CACHED_LAYOUTS 4  // 关键帧较多的文本只保留最近使用的几份排版。
 
 struct GlyphInfo {
   int glyphIndex = 0;
@@ -471,24 +473,97 @@ std::shared_ptr<Graphic> RenderTextBackground(const std::vector<std::vector<Glyp
   return Graphic::MakeCompose(graphic, modifier);
 }
 
-std::unique_ptr<TextContent> RenderTexts(Property<TextDocumentHandle>* sourceText, TextPathOptions*,
-                                         TextMoreOptions*, std::vector<TextAnimator*>* animators,
-                                         Frame layerFrame) {
-  auto textDocument = sourceText->getValueAt(layerFrame);
-  auto textPaint = CreateTextPaint(textDocument.get());
+struct GlyphLayout {
+  std::vector<std::vector<GlyphHandle>> glyphLines;
+  Rect textBounds = Rect::MakeEmpty();
+};
+
+static std::shared_ptr<GlyphLayout> MakeGlyphLayout(const TextDocument* textDocument) {
+  auto textPaint = CreateTextPaint(textDocument);
   auto glyphList = Glyph::BuildFromText(textDocument->text, textPaint);
   // 无论文字朝向，都先按从(0,0)点开始的横向矩形排版。
   // 提取出跟文字朝向无关的 GlyphInfo 列表与 TextLayout,
   // 复用同一套排版规则。如果最终是纵向排版，再把坐标转成纵向坐标应用到 glyphList 上。
   auto glyphInfos = CreateGlyphInfos(glyphList);
-  auto textLayout = CreateTextLayout(textDocument.get(), glyphList);
+  auto textLayout = CreateTextLayout(textDocument, glyphList);
   if (textDocument->boxText) {
     AdjustToFitBox(&textLayout, &glyphInfos, textDocument->fontSize);
   }
-  Rect textBounds = Rect::MakeEmpty();
-  auto glyphInfoLines = ApplyLayoutToGlyphInfos(textLayout, &glyphInfos, &textBounds);
-  auto glyphLines = ApplyMatrixToGlyphs(textLayout, glyphInfoLines, &glyphList);
-  textLayout.coordinateMatrix.mapRect(&textBounds);
+  auto glyphLayout = std::make_shared<GlyphLayout>();
+  auto glyphInfoLines = ApplyLayoutToGlyphInfos(textLayout, &glyphInfos, &glyphLayout->textBounds);
+  glyphLayout->glyphLines = ApplyMatrixToGlyphs(textLayout, glyphInfoLines, &glyphList);
+  textLayout.coordinateMatrix.mapRect(&glyphLayout->textBounds);
+  return glyphLayout;
+}
+
+static void ComputeLayoutKey(BytesKey* layoutKey, const TextDocument* textDocument) {
+  // The glyphs are shaped with the registered and fallback fonts at the time.
+  layoutKey->write(FontManager::Generation());
+  layoutKey->write(textDocument->text);
+  layoutKey->write(textDocument->fontFamily);
+  layoutKey->write(textDocument->fontStyle);
+  layoutKey->write(textDocument->fontSize);
+  uint8_t flags[] = {static_cast<uint8_t>(textDocument->fauxBold),
+                     static_cast<uint8_t>(textDocument->fauxItalic),
+                     static_cast<uint8_t>(textDocument->boxText), textDocument->direction};
+  layoutKey->write(flags);
+  layoutKey->write(textDocument->boxTextPos.x);
+  layoutKey->write(textDocument->boxTextPos.y);
+  layoutKey->write(textDocument->boxTextSize.x);
+  layoutKey->write(textDocument->boxTextSize.y);
+  layoutKey->write(textDocument->firstBaseLine);
+  layoutKey->write(textDocument->baselineShift);
+  layoutKey->write(textDocument->leading);
+  layoutKey->write(textDocument->tracking);
+  layoutKey->write(static_cast<uint32_t>(textDocument->justification));
+  // The glyphs carry the paint of the document as their initial style.
+  uint8_t fillValues[] = {textDocument->fillColor.red, textDocument->fillColor.green,
+                          textDocument->fillColor.blue,
+                          static_cast<uint8_t>(textDocument->applyFill)};
+  layoutKey->write(fillValues);
+  uint8_t strokeValues[] = {textDocument->strokeColor.red, textDocument->strokeColor.green,
+                            textDocument->strokeColor.blue,
+                            static_cast<uint8_t>(textDocument->applyStroke)};
+  layoutKey->write(strokeValues);
+  layoutKey->write(textDocument->strokeWidth);
+  layoutKey->write(static_cast<uint32_t>(textDocument->strokeOverFill));
+}
+
+std::shared_ptr<GlyphLayout> TextLayoutCache::getLayout(const TextDocument* textDocument) {
+  BytesKey layoutKey = {};
+  ComputeLayoutKey(&layoutKey, textDocument);
+  std::lock_guard<std::mutex> autoLock(locker);
+  for (auto item = layouts.begin(); item != layouts.end(); item++) {
+    if (item->first == layoutKey) {
+      layouts.splice(layouts.begin(), layouts, item);
+      return item->second;
+    }
+  }
+  auto glyphLayout = MakeGlyphLayout(textDocument);
+  layouts.emplace_front(layoutKey, glyphLayout);
+  if (layouts.size() > MAX_CACHED_LAYOUTS) {
+    layouts.pop_back();
+  }
+  return glyphLayout;
+}
+
+std::unique_ptr<TextContent> RenderTexts(Property<TextDocumentHandle>* sourceText, TextPathOptions*,
+                                         TextMoreOptions*, std::vector<TextAnimator*>* animators,
+                                         Frame layerFrame, TextLayoutCache* layoutCache) {
+  auto textDocument = sourceText->getValueAt(layerFrame);
+  auto glyphLayout = layoutCache ? layoutCache->getLayout(textDocument.get())
+                                 : MakeGlyphLayout(textDocument.get());
+  auto& textBounds = glyphLayout->textBounds;
+  auto glyphLines = glyphLayout->glyphLines;
+  if (layoutCache && TextAnimatorRenderer::HasAnimator(animators)) {
+    // The text animators modify the glyphs in place, so the cached glyphs are copied for each
+    // frame, which is much cheaper than shaping them again.
+    for (auto& line : glyphLines) {
+      for (auto& glyph : line) {
+        glyph = std::make_shared<Glyph>(*glyph);
+      }
+    }
+  }
   auto hasAnimators =
       TextAnimatorRenderer::ApplyToGlyphs(glyphLines, animators, textDocument.get(), layerFrame);
   std::vector<std::shared_ptr<Graphic>> contents = {};
@@ -18,15 +18,44 @@
 
 #pragma once
 
+#include <list>
+#include <mutex>
+#include "base/utils/BytesKey.h"
 #include "pag/file.h"
 #include "pag/pag.h"
 #include "rendering/caches/TextContent.h"
 #include "rendering/graphics/Recorder.h"
 
 namespace pag {
+struct GlyphLayout;
+
+/**
+ * TextLayoutCache keeps the glyphs of text documents after shaping and line layout. They only
+ * depend on the content, font and box of a document, so the frames that differ only by text
+ * animators share the same layout. Only the few most recently used layouts are kept, and they are
+ * laid out again after the registered or fallback fonts change. It is safe to use from multiple
+ * threads.
+ */
+class TextLayoutCache {
+ public:
+  /**
+   * Returns the cached layout of the specified text document, creating it if not found.
+   */
+  std::shared_ptr<GlyphLayout> getLayout(const TextDocument* textDocument);
+
+ private:
+  std::mutex locker = {};
+  std::list<std::pair<BytesKey, std::shared_ptr<GlyphLayout>>> layouts = {};
+};
+
+/**
+ * Renders the text content at the specified frame. If the layoutCache is not null, the shaped
+ * glyphs are taken from it and only the text animators are evaluated for the frame.
+ */
 std::unique_ptr<TextContent> RenderTexts(Property<TextDocumentHandle>* sourceText,
                                          TextPathOptions* pathOption, TextMoreOptions* moreOption,
-                                         std::vector<TextAnimator*>* animators, Frame layerFrame);
+                                         std::vector<TextAnimator*>* animators, Frame layerFrame,
+                                         TextLayoutCache* layoutCache = nullptr);
 
 void CalculateTextAscentAndDescent(TextDocumentHandle textDocument, float* pMinAscent,
                                    float* pMaxDescent);
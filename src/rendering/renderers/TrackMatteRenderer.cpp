@@ -31,8 +31,8 @@ static std::shared_ptr<Graphic> RenderColorGlyphs(TextLayer* layer, Frame layerF
   }
   auto layerCache = LayerCache::Get(layer);
   auto contentFrame = layerFrame - layer->startTime;
-  auto content =
-      textContent ? textContent : static_cast<TextContent*>(layerCache->getContent(contentFrame));
+  auto cachedContent = textContent ? nullptr : layerCache->getContent(contentFrame);
+  auto content = textContent ? textContent : static_cast<TextContent*>(cachedContent.get());
   if (content->colorGlyphs == nullptr) {
     return nullptr;
   }
@@ -81,7 +81,8 @@ std::unique_ptr<TrackMatte> TrackMatteRenderer::Make(PAGLayer* trackMatteOwner)
     return nullptr;
   }
   if (trackMatteLayer->layerType() == LayerType::Text) {
-    auto textContent = static_cast<TextContent*>(trackMatteLayer->getContent());
+    auto content = trackMatteLayer->getContent();
+    auto textContent = static_cast<TextContent*>(content.get());
     trackMatte->colorGlyphs = RenderColorGlyphs(static_cast<TextLayer*>(trackMatteLayer->layer),
                                                 layerFrame, textContent, &extraTransform);
   }
@@ -0,0 +1,92 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "BoundsIndex.h"
+#include <algorithm>
+#include <cmath>
+
+namespace pag {
+// The grid has about as many cells as bounds, but no more than MAX_GRID_SIZE in each direction.
+static constexpr int MAX_GRID_SIZE = 32;
+
+static bool IsFinite(const Rect& rect) {
+  return std::isfinite(rect.left) && std::isfinite(rect.top) && std::isfinite(rect.right) &&
+         std::isfinite(rect.bottom);
+}
+
+BoundsIndex::BoundsIndex(const std::vector<Rect>& boundsList) : boundsList(boundsList) {
+  for (int index = 0; index < static_cast<int>(boundsList.size()); index++) {
+    auto& bounds = boundsList[index];
+    if (IsFinite(bounds)) {
+      gridBounds.join(bounds);
+    } else {
+      unboundedIndices.push_back(index);
+    }
+  }
+  if (gridBounds.isEmpty()) {
+    return;
+  }
+  auto gridSize = static_cast<int>(ceilf(sqrtf(static_cast<float>(boundsList.size()))));
+  columns = std::min(gridSize, MAX_GRID_SIZE);
+  rows = columns;
+  cellWidth = gridBounds.width() / static_cast<float>(columns);
+  cellHeight = gridBounds.height() / static_cast<float>(rows);
+  cells.resize(static_cast<size_t>(columns * rows));
+  for (int index = 0; index < static_cast<int>(boundsList.size()); index++) {
+    auto& bounds = boundsList[index];
+    if (bounds.isEmpty() || !IsFinite(bounds)) {
+      continue;
+    }
+    auto right = getColumn(bounds.right);
+    auto bottom = getRow(bounds.bottom);
+    for (int row = getRow(bounds.top); row <= bottom; row++) {
+      for (int column = getColumn(bounds.left); column <= right; column++) {
+        cells[row * columns + column].push_back(index);
+      }
+    }
+  }
+}
+
+int BoundsIndex::getColumn(float x) const {
+  auto column = cellWidth > 0 ? static_cast<int>((x - gridBounds.left) / cellWidth) : 0;
+  return std::max(0, std::min(column, columns - 1));
+}
+
+int BoundsIndex::getRow(float y) const {
+  auto row = cellHeight > 0 ? static_cast<int>((y - gridBounds.top) / cellHeight) : 0;
+  return std::max(0, std::min(row, rows - 1));
+}
+
+void BoundsIndex::query(float x, float y, std::vector<int>* results) const {
+  if (!gridBounds.contains(x, y)) {
+    results->insert(results->end(), unboundedIndices.begin(), unboundedIndices.end());
+    return;
+  }
+  auto& cell = cells[getRow(y) * columns + getColumn(x)];
+  auto unbounded = unboundedIndices.begin();
+  for (auto index : cell) {
+    while (unbounded != unboundedIndices.end() && *unbounded < index) {
+      results->push_back(*unbounded++);
+    }
+    if (boundsList[index].contains(x, y)) {
+      results->push_back(index);
+    }
+  }
+  results->insert(results->end(), unbounded, unboundedIndices.end());
+}
+}  // namespace pag
@@ -0,0 +1,57 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+#include "pag/types.h"
+
+namespace pag {
+/**
+ * BoundsIndex is a uniform grid over a list of bounds, which finds the bounds that contain a point
+ * without testing all of them. Each cell of the grid keeps the indices of the bounds overlapping
+ * it in ascending order.
+ */
+class BoundsIndex {
+ public:
+  /**
+   * Builds the grid for the specified bounds. The empty ones never contain a point, and the ones
+   * that are not finite contain every point.
+   */
+  explicit BoundsIndex(const std::vector<Rect>& boundsList);
+
+  /**
+   * Appends the indices of the bounds that contain the point (x, y) to results, in ascending
+   * order.
+   */
+  void query(float x, float y, std::vector<int>* results) const;
+
+ private:
+  std::vector<Rect> boundsList = {};
+  Rect gridBounds = Rect::MakeEmpty();
+  int columns = 0;
+  int rows = 0;
+  float cellWidth = 0;
+  float cellHeight = 0;
+  std::vector<std::vector<int>> cells = {};
+  std::vector<int> unboundedIndices = {};
+
+  int getColumn(float x) const;
+  int getRow(float y) const;
+};
+}  // namespace pag
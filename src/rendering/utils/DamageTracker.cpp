@@ -0,0 +1,126 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "DamageTracker.h"
+#include "rendering/caches/LayerCache.h"
+#include "rendering/layers/PAGStage.h"
+
+namespace pag {
+static void WriteMatrix(BytesKey* key, const Matrix& matrix) {
+  for (int i = 0; i < 9; i++) {
+    key->write(matrix.get(i));
+  }
+}
+
+void DamageTracker::update(PAGStage* stage) {
+  std::unordered_map<ID, LayerState> states = {};
+  uint32_t order = 0;
+  CollectLayers(stage, Matrix::I(), 1.0f, &order, &states);
+  _damagedBounds.setEmpty();
+  for (auto& item : states) {
+    auto result = layerStates.find(item.first);
+    if (result == layerStates.end()) {
+      _damagedBounds.join(item.second.bounds);
+      continue;
+    }
+    auto& lastState = result->second;
+    if (!(lastState.key == item.second.key) || lastState.bounds != item.second.bounds) {
+      _damagedBounds.join(lastState.bounds);
+      _damagedBounds.join(item.second.bounds);
+    }
+    layerStates.erase(result);
+  }
+  // The layers left are removed or invisible in the current frame.
+  for (auto& item : layerStates) {
+    _damagedBounds.join(item.second.bounds);
+  }
+  layerStates = std::move(states);
+  _baseVersion = currentVersion;
+  currentVersion = stage->getContentVersion();
+}
+
+void DamageTracker::reset() {
+  layerStates = {};
+  _baseVersion = 0;
+  currentVersion = 0;
+  _damagedBounds.setEmpty();
+}
+
+bool DamageTracker::CanFlatten(PAGLayer* pagLayer) {
+  if (pagLayer->layerType() != LayerType::PreCompose) {
+    return false;
+  }
+  auto layer = pagLayer->layer;
+  if (static_cast<PreComposeLayer*>(layer)->composition->type() != CompositionType::Vector) {
+    return false;
+  }
+  // The masks, effects and track matte of a composition apply to all of its children as a whole,
+  // so the children can only be tracked separately if the composition has none of them.
+  return pagLayer->_trackMatteLayer == nullptr && layer->masks.empty() && layer->effects.empty() &&
+         layer->layerStyles.empty() && !layer->motionBlur;
+}
+
+void DamageTracker::WriteLayerKey(BytesKey* key, PAGLayer* pagLayer) {
+  key->write(pagLayer->_uniqueID);
+  key->write(pagLayer->contentVersion);
+  auto staticFrame = pagLayer->layerCache->getStaticFrame(pagLayer->contentFrame);
+  key->write(static_cast<uint32_t>(staticFrame));
+  WriteMatrix(key, pagLayer->layerMatrix);
+  key->write(static_cast<uint32_t>(pagLayer->layerOpacity));
+  key->write(static_cast<uint32_t>(pagLayer->layerVisible));
+  if (pagLayer->_trackMatteLayer != nullptr) {
+    WriteLayerKey(key, pagLayer->_trackMatteLayer.get());
+  }
+  if (pagLayer->layerType() == LayerType::PreCompose) {
+    // The children of a composition do not change its version when they go to another frame.
+    for (auto& childLayer : static_cast<PAGComposition*>(pagLayer)->layers) {
+      WriteLayerKey(key, childLayer.get());
+    }
+  }
+}
+
+void DamageTracker::CollectLayers(PAGComposition* composition, const Matrix& matrix, float alpha,
+                                  uint32_t* order, std::unordered_map<ID, LayerState>* states) {
+  for (auto& childLayer : composition->layers) {
+    if (!childLayer->layerVisible ||
+        !childLayer->layerCache->contentVisible(childLayer->contentFrame)) {
+      continue;
+    }
+    if (CanFlatten(childLayer.get())) {
+      auto layerTransform = childLayer->layerCache->getTransform(childLayer->contentFrame);
+      auto childMatrix = childLayer->getTotalMatrixInternal();
+      childMatrix.postConcat(matrix);
+      auto childAlpha = alpha * static_cast<float>(layerTransform->opacity) / 255.0f *
+                        static_cast<float>(childLayer->layerOpacity) / 255.0f;
+      CollectLayers(static_cast<PAGComposition*>(childLayer.get()), childMatrix, childAlpha, order,
+                    states);
+      continue;
+    }
+    LayerState state = {};
+    PAGComposition::MeasureChildLayer(&state.bounds, childLayer.get());
+    matrix.mapRect(&state.bounds);
+    // The stacking order is part of the key, the overlapping area of two layers needs redrawing
+    // if their order changes.
+    state.key.write((*order)++);
+    WriteMatrix(&state.key, matrix);
+    state.key.write(alpha);
+    WriteLayerKey(&state.key, childLayer.get());
+    (*states)[childLayer->_uniqueID] = std::move(state);
+  }
+}
+}  // namespace pag
@@ -0,0 +1,79 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <unordered_map>
+#include "base/utils/BytesKey.h"
+#include "pag/pag.h"
+
+namespace pag {
+class PAGStage;
+
+/**
+ * DamageTracker finds out the region of the stage that changed since the last flush by comparing
+ * the visible layers of the current frame with the ones collected last time. The layers are
+ * compared by their frames, versions, matrices and stacking orders, a changed layer damages both
+ * its old bounds and its new bounds.
+ */
+class DamageTracker {
+ public:
+  /**
+   * Collects the visible layers of the stage and computes the damaged bounds against the layers
+   * collected by the previous call.
+   */
+  void update(PAGStage* stage);
+
+  /**
+   * Returns the content version of the stage collected by the previous call of update(). The
+   * damaged bounds only applies to a surface that holds the content of this version. Returns 0 if
+   * there is no previous content to compare with.
+   */
+  uint32_t baseVersion() const {
+    return _baseVersion;
+  }
+
+  /**
+   * Returns the damaged bounds in the stage coordinates.
+   */
+  const Rect& damagedBounds() const {
+    return _damagedBounds;
+  }
+
+  /**
+   * Discards all collected layers, the next update() will damage the whole stage.
+   */
+  void reset();
+
+ private:
+  struct LayerState {
+    BytesKey key = {};
+    Rect bounds = Rect::MakeEmpty();
+  };
+
+  uint32_t _baseVersion = 0;
+  uint32_t currentVersion = 0;
+  Rect _damagedBounds = Rect::MakeEmpty();
+  std::unordered_map<ID, LayerState> layerStates = {};
+
+  static bool CanFlatten(PAGLayer* pagLayer);
+  static void WriteLayerKey(BytesKey* key, PAGLayer* pagLayer);
+  static void CollectLayers(PAGComposition* composition, const Matrix& matrix, float alpha,
+                            uint32_t* order, std::unordered_map<ID, LayerState>* states);
+};
+}  // namespace pag
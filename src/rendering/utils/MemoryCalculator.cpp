@@ -108,7 +108,10 @@ void MemoryCalculator::FillBitmapGraphicsMemories(
     std::unordered_map<void*, std::vector<TimeRange>*>& resourcesTimeRangesMap,
     std::vector<int64_t>& memoriesPreFrame, int64_t& graphicsMemory) {
   // Just use the last one for best rendering quality, ignore all others.
-  auto sequence = static_cast<BitmapComposition*>(composition)->sequences.back();
+  auto sequence = Sequence::Get(composition);
+  if (sequence == nullptr) {
+    return;
+  }
   graphicsMemory += sequence->width * sequence->height * 4;
   FillGraphicsMemories(composition, resourcesTimeRangesMap, memoriesPreFrame, graphicsMemory);
 }
@@ -118,7 +121,10 @@ void MemoryCalculator::FillVideoGraphicsMemories(
     std::unordered_map<void*, std::vector<TimeRange>*>& resourcesTimeRangesMap,
     std::vector<int64_t>& memoriesPreFrame, int64_t& graphicsMemory) {
   // Just use the last one for best rendering quality, ignore all others.
-  auto sequence = static_cast<VideoComposition*>(composition)->sequences.back();
+  auto sequence = static_cast<VideoSequence*>(Sequence::Get(composition));
+  if (sequence == nullptr) {
+    return;
+  }
   auto factor = sequence->alphaStartX > 0 || sequence->alphaStartY > 0 ? 3 : 2;
   graphicsMemory += sequence->width * sequence->height * 4 * factor;
   FillGraphicsMemories(composition, resourcesTimeRangesMap, memoriesPreFrame, graphicsMemory);
@@ -329,4 +335,24 @@ int64_t CalculateGraphicsMemory(std::shared_ptr<File> file) {
   }
   return maxGraphicsMemory;
 }
+
+int64_t CalculateFrameCacheMemory(std::shared_ptr<File> file) {
+  if (file == nullptr) {
+    return 0;
+  }
+  int64_t frameCacheMemory = 0;
+  for (auto composition : file->compositions) {
+    if (composition->type() != CompositionType::Vector) {
+      continue;
+    }
+    for (auto layer : static_cast<VectorComposition*>(composition)->layers) {
+      // Only counts the caches already created, LayerCache::Get() would create a new one.
+      std::lock_guard<std::mutex> autoLock(layer->locker);
+      if (layer->cache != nullptr) {
+        frameCacheMemory += static_cast<LayerCache*>(layer->cache)->memoryUsage();
+      }
+    }
+  }
+  return frameCacheMemory;
+}
 }  // namespace pag
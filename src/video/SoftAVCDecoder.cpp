@@ -18,6 +18,8 @@
 
 #include "SoftAVCDecoder.h"
 #include <cstdlib>
+#include "VideoDecoder.h"
+#include "base/utils/Task.h"
 
 #ifdef PAG_USE_LIBAVC
 
@@ -70,6 +72,11 @@ bool SoftAVCDecoder::onConfigure(const std::vector<HeaderData>& headers, std::st
   if (mimeType != "video/avc") {
     return false;
   }
+  auto cores = VideoDecoder::GetSoftwareDecoderCores();
+  if (cores <= 0) {
+    cores = GetCPUCores();
+  }
+  numCores = static_cast<uint32_t>(cores);
   if (!initDecoder()) {
     return false;
   }
@@ -276,7 +283,9 @@ bool SoftAVCDecoder::setNumCores() {
   ih264d_ctl_set_num_cores_op_t s_set_cores_op;
   s_set_cores_ip.e_cmd = IVD_CMD_VIDEO_CTL;
   s_set_cores_ip.e_sub_cmd = (IVD_CONTROL_API_COMMAND_TYPE_T)IH264D_CMD_CTL_SET_NUM_CORES;
-  s_set_cores_ip.u4_num_cores = 1;
+  // libavc parses and decodes slices in separate threads once it has more than one core, and it
+  // uses at most three of them (parsing, decoding and deblocking).
+  s_set_cores_ip.u4_num_cores = numCores;
   s_set_cores_ip.u4_size = sizeof(ih264d_ctl_set_num_cores_ip_t);
   s_set_cores_op.u4_size = sizeof(ih264d_ctl_set_num_cores_op_t);
   auto status = ih264d_api_function(codecContext, &s_set_cores_ip, &s_set_cores_op);
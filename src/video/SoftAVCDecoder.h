@@ -63,6 +63,7 @@ class SoftAVCDecoder : public SoftwareDecoder {
   ivd_video_decode_ip_t decodeInput = {};
   ivd_video_decode_op_t decodeOutput = {};
   bool flushed = true;
+  uint32_t numCores = 1;
 
   bool initDecoder();
   bool openDecoder();
@@ -28,11 +28,16 @@ namespace pag {
 static std::atomic<SoftwareDecoderFactory*> softwareDecoderFactory = {nullptr};
 static std::atomic_int maxHardwareDecoderCount = {65535};
 static std::atomic_int globalGPUDecoderCount = {0};
+static std::atomic_int softwareDecoderCores = {0};
 
 void PAGVideoDecoder::SetMaxHardwareDecoderCount(int count) {
   maxHardwareDecoderCount = count;
 }
 
+void PAGVideoDecoder::SetSoftwareDecoderCores(int count) {
+  softwareDecoderCores = count;
+}
+
 void PAGVideoDecoder::RegisterSoftwareDecoderFactory(SoftwareDecoderFactory* decoderFactory) {
   softwareDecoderFactory = decoderFactory;
 }
@@ -45,6 +50,10 @@ int VideoDecoder::GetMaxHardwareDecoderCount() {
   return maxHardwareDecoderCount;
 }
 
+int VideoDecoder::GetSoftwareDecoderCores() {
+  return softwareDecoderCores;
+}
+
 bool VideoDecoder::HasSoftwareDecoder() {
 #ifdef PAG_USE_LIBAVC
   return true;
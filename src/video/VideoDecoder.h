@@ -71,6 +71,12 @@ class VideoDecoder {
    */
   static int GetMaxHardwareDecoderCount();
 
+  /**
+   * Returns the number of CPU cores that the embedded software decoder can use. Returns 0 if it is
+   * not set by PAGVideoDecoder::SetSoftwareDecoderCores(), which means using all cores available.
+   */
+  static int GetSoftwareDecoderCores();
+
   /**
    * Creates a new video decoder by specified type. Returns a hardware video decoder if useHardware
    * is true, otherwise, returns a software video decoder.
@@ -30,7 +30,8 @@ class GPUDecoderTask : public Executor {
  public:
   static std::shared_ptr<Task> MakeAndRun(const VideoConfig& config) {
     auto task = Task::Make(std::unique_ptr<GPUDecoderTask>(new GPUDecoderTask(config)));
-    task->run();
+    // The software decoder keeps working until the hardware decoder is ready.
+    task->run(TaskPriority::Low);
     return task;
   }
 
@@ -61,7 +61,7 @@ void VideoSequenceReader::prepareAsync(Frame targetFrame) {
       pendingTime = targetTime;
     }
   } else {
-    lastTask = VideoDecodingTask::MakeAndRun(reader.get(), targetTime);
+    lastTask = VideoDecodingTask::MakeAndRun(reader.get(), targetTime, TaskPriority::Low);
   }
 }
 
@@ -95,7 +95,8 @@ std::shared_ptr<Texture> VideoSequenceReader::readTexture(Frame targetFrame, Ren
         pendingTime = -1;
       }
       if (nextSampleTime != INT64_MAX) {
-        lastTask = VideoDecodingTask::MakeAndRun(reader.get(), nextSampleTime);
+        lastTask =
+            VideoDecodingTask::MakeAndRun(reader.get(), nextSampleTime, TaskPriority::High);
       }
     }
   }
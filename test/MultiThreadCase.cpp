@@ -16,12 +16,15 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <atomic>
 #include <thread>
 #include "HitTestCase.h"
+#include "base/utils/Task.h"
 #include "base/utils/TimeUtil.h"
 #include "framework/pag_test.h"
 #include "framework/utils/PAGTestUtils.h"
 #include "nlohmann/json.hpp"
+#include "raster/Font.h"
 
 namespace pag {
 PAG_TEST_CASE(MultiThreadCase)
@@ -62,6 +65,89 @@ PAG_TEST(SimpleMultiThreadCase, MultiPAGView) {
   }
 }
 
+class CountingExecutor : public Executor {
+ public:
+  explicit CountingExecutor(std::atomic<int>* counter) : counter(counter) {
+  }
+
+ private:
+  std::atomic<int>* counter = nullptr;
+
+  void execute() override {
+    (*counter)++;
+  }
+};
+
+/**
+ * 用例描述: 多个线程同时提交、等待和取消不同优先级的异步任务
+ */
+PAG_TEST(SimpleMultiThreadCase, TaskGroup) {
+  std::atomic<int> executedCount = {0};
+  std::atomic<int> waitedCount = {0};
+  std::vector<std::thread> threads;
+  int threadCount = 8;
+  int taskCount = 999;
+  for (int i = 0; i < threadCount; i++) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < taskCount; j++) {
+        auto task = Task::Make(std::make_unique<CountingExecutor>(&executedCount));
+        task->run(j % 2 == 0 ? TaskPriority::High : TaskPriority::Low);
+        if (j % 3 == 0) {
+          task->cancel();
+        } else {
+          task->wait();
+          waitedCount++;
+        }
+        EXPECT_FALSE(task->isRunning());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(waitedCount, threadCount * taskCount * 2 / 3);
+  EXPECT_GE(executedCount, waitedCount);
+}
+
+/**
+ * 用例描述: 多个线程同时读取同一个字体的字形路径和度量，结果与单线程读取一致
+ */
+PAG_TEST(SimpleMultiThreadCase, TypefaceGlyphs) {
+  auto typeface = Typeface::MakeFromPath("../resources/font/NotoSansSC-Regular.otf");
+  ASSERT_TRUE(typeface != nullptr);
+  Font font(typeface, 36);
+  std::vector<GlyphID> glyphIDs = {};
+  for (auto& name : {"P", "A", "G", "文", "字", "渲", "染"}) {
+    glyphIDs.push_back(font.getGlyphID(name));
+  }
+  std::vector<Path> expectedPaths = {};
+  for (auto glyphID : glyphIDs) {
+    Path path = {};
+    ASSERT_TRUE(font.getGlyphPath(glyphID, &path));
+    expectedPaths.push_back(path);
+  }
+  std::atomic<int> mismatchCount = {0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < 50; j++) {
+        for (size_t k = 0; k < glyphIDs.size(); k++) {
+          Path path = {};
+          font.getGlyphPath(glyphIDs[k], &path);
+          font.getGlyphAdvance(glyphIDs[k]);
+          if (path != expectedPaths[k]) {
+            mismatchCount++;
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(mismatchCount, 0);
+}
+
 void mockAsyncFlush(int num = 30) {
   ASSERT_NE(PAGCpuTest::TestPAGSurface, nullptr);
   for (int i = 0; i < num; i++) {
@@ -20,6 +20,7 @@
 #include "framework/pag_test.h"
 #include "framework/utils/PAGTestUtils.h"
 #include "nlohmann/json.hpp"
+#include "rendering/caches/RenderCache.h"
 
 namespace pag {
 using nlohmann::json;
@@ -471,4 +472,87 @@ PAG_TEST_F(ContainerTest, GetLayersUnderPointText) {
 PAG_TEST_F(ContainerTest, GetLayersUnderPointImage) {
   HitTestCase::GetLayersUnderPointImage(TestPAGPlayer, TestPAGFile);
 }
+
+/**
+ * 用例描述: 子图层较多时按图层边界索引查找点击位置下的图层，图层移动后索引随之更新
+ */
+PAG_TEST_F(PAGCompositionTest, GetLayersUnderPointIndexed) {
+  auto composition = PAGComposition::Make(400, 400);
+  std::vector<std::shared_ptr<PAGSolidLayer>> solidLayers = {};
+  for (int i = 0; i < 16; i++) {
+    auto solidLayer = PAGSolidLayer::Make(1000000, 100, 100, i % 2 == 0 ? Red : Blue);
+    solidLayer->setMatrix(Matrix::MakeTrans(static_cast<float>(i % 4 * 100),
+                                            static_cast<float>(i / 4 * 100)));
+    composition->addLayer(solidLayer);
+    solidLayers.push_back(solidLayer);
+  }
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(PAGSurface::MakeOffscreen(400, 400));
+  pagPlayer->setComposition(composition);
+  pagPlayer->flush();
+
+  auto layers = pagPlayer->getLayersUnderPoint(150, 250);
+  ASSERT_EQ(layers.size(), 2u);
+  EXPECT_EQ(layers[0], solidLayers[9]);
+  EXPECT_EQ(layers[1], composition);
+
+  solidLayers[0]->setMatrix(Matrix::MakeTrans(120, 220));
+  layers = pagPlayer->getLayersUnderPoint(150, 250);
+  ASSERT_EQ(layers.size(), 3u);
+  EXPECT_EQ(layers[0], solidLayers[9]);
+  EXPECT_EQ(layers[1], solidLayers[0]);
+  EXPECT_EQ(layers[2], composition);
+  EXPECT_TRUE(pagPlayer->getLayersUnderPoint(50, 50).size() == 1);
+}
+/**
+ * 用例描述: 像素级碰撞检测使用 Snapshot 的透明度遮罩，遮罩计入显存占用，没有 Snapshot 时在绘制时生成遮罩
+ */
+PAG_TEST_F(PAGCompositionTest, HitTestCoverage) {
+  int width = 200;
+  int height = 200;
+  size_t rowBytes = width * 4;
+  // 左半边为不透明的红色，右半边全透明。
+  std::vector<uint8_t> pixels(rowBytes * height, 0);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width / 2; x++) {
+      auto pixel = pixels.data() + y * rowBytes + x * 4;
+      pixel[0] = 255;
+      pixel[3] = 255;
+    }
+  }
+  auto image = PAGImage::FromPixels(pixels.data(), width, height, rowBytes, ColorType::RGBA_8888,
+                                    AlphaType::Premultiplied);
+  ASSERT_NE(image, nullptr);
+  auto imageLayer = PAGImageLayer::Make(width, height, 1000000);
+  imageLayer->replaceImage(image);
+  auto composition = PAGComposition::Make(width, height);
+  composition->addLayer(imageLayer);
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(PAGSurface::MakeOffscreen(width, height));
+  pagPlayer->setComposition(composition);
+  ASSERT_TRUE(pagPlayer->flush());
+  auto renderCache = pagPlayer->renderCache;
+  ASSERT_TRUE(renderCache->hasSnapshot(image->uniqueID()));
+  EXPECT_TRUE(renderCache->coverageCaches.empty());
+
+  auto memoryUsage = renderCache->memoryUsage();
+  EXPECT_TRUE(pagPlayer->hitTestPoint(imageLayer, 50, 100, true));
+  EXPECT_FALSE(pagPlayer->hitTestPoint(imageLayer, 150, 100, true));
+  ASSERT_EQ(renderCache->coverageCaches.size(), 1u);
+  auto coverage = renderCache->coverageCaches.begin()->second;
+  EXPECT_EQ(coverage->memoryUsage(), static_cast<size_t>(width * height));
+  EXPECT_EQ(renderCache->memoryUsage(), memoryUsage + coverage->memoryUsage());
+
+  // 没有 Snapshot 时只读取单个像素，遮罩在下一次绘制时生成。
+  renderCache->setSnapshotEnabled(false);
+  renderCache->clearAllCoverages();
+  EXPECT_TRUE(pagPlayer->hitTestPoint(imageLayer, 50, 100, true));
+  EXPECT_FALSE(pagPlayer->hitTestPoint(imageLayer, 150, 100, true));
+  EXPECT_TRUE(renderCache->coverageCaches.empty());
+  pagPlayer->getSurface()->clearAll();
+  ASSERT_TRUE(pagPlayer->flush());
+  EXPECT_EQ(renderCache->coverageCaches.size(), 1u);
+  EXPECT_TRUE(pagPlayer->hitTestPoint(imageLayer, 50, 100, true));
+  EXPECT_FALSE(pagPlayer->hitTestPoint(imageLayer, 150, 100, true));
+}
 }  // namespace pag
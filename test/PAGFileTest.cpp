@@ -16,7 +16,9 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "TestUtils.h"
 #include "base/utils/TimeUtil.h"
+#include "codec/Compression.h"
 #include "framework/pag_test.h"
 #include "framework/utils/PAGTestUtils.h"
 #include "nlohmann/json.hpp"
@@ -671,4 +673,165 @@ PAG_TEST_F(PAGFileBaseTest, SetStartTime) {
   TestPAGPlayer->flush();
   EXPECT_TRUE(Baseline::Compare(TestPAGSurface, "PAGFileBaseTest/SetStartTime"));
 }
+
+/**
+ * 用例描述: 压缩格式的PAG文件编解码测试
+ */
+PAG_TEST(PAGFileCompressionCodec, CompressionCodec) {
+  auto testFile = PAGFile::Load(PAG_COMPLEX_FILE_PATH);
+  ASSERT_NE(testFile, nullptr);
+  auto file = testFile->getFile();
+  auto uncompressedData = Codec::Encode(file);
+  ASSERT_NE(uncompressedData, nullptr);
+  for (auto compressionType : {CompressionType::Zlib, CompressionType::Lzma}) {
+    auto compressedData = Codec::Encode(file, nullptr, compressionType);
+    ASSERT_NE(compressedData, nullptr);
+    EXPECT_LT(compressedData->length(), uncompressedData->length());
+    auto decodedFile = Codec::Decode(compressedData->data(),
+                                     static_cast<uint32_t>(compressedData->length()), "");
+    ASSERT_NE(decodedFile, nullptr);
+    EXPECT_EQ(decodedFile->numLayers(), file->numLayers());
+    EXPECT_EQ(decodedFile->tagLevel(), file->tagLevel());
+    auto reencodedData = Codec::Encode(decodedFile);
+    ASSERT_EQ(reencodedData->length(), uncompressedData->length());
+    EXPECT_EQ(memcmp(reencodedData->data(), uncompressedData->data(), reencodedData->length()), 0);
+    // 截断的压缩数据应当解码失败
+    auto truncatedFile = Codec::Decode(compressedData->data(),
+                                       static_cast<uint32_t>(compressedData->length() / 2), "");
+    EXPECT_EQ(truncatedFile, nullptr);
+  }
+}
+
+/**
+ * 用例描述: LZMA 压缩数据声明的字典过大时拒绝解码，不会按照文件中的属性分配内存
+ */
+PAG_TEST(PAGFileCompressionCodec, LzmaDictionaryLimit) {
+  std::vector<uint8_t> data(4096, 'p');
+  auto compressedData = Compress(CompressionAlgorithm::LZMA, data.data(),
+                                 static_cast<uint32_t>(data.size()));
+  if (compressedData == nullptr) {
+    return;
+  }
+  std::vector<uint8_t> output(data.size());
+  StreamContext context = {};
+  auto decompressor = Decompressor::Make(CompressionAlgorithm::LZMA, &context,
+                                         compressedData->data(),
+                                         static_cast<uint32_t>(compressedData->length()));
+  ASSERT_NE(decompressor, nullptr);
+  EXPECT_TRUE(decompressor->read(output.data(), static_cast<uint32_t>(output.size())));
+  EXPECT_TRUE(output == data);
+
+  // 属性值 39 对应 3GB 的字典，40 对应 4GB 的字典。
+  for (uint8_t property : {39, 40, 41}) {
+    std::vector<uint8_t> craftedData(compressedData->data(),
+                                     compressedData->data() + compressedData->length());
+    craftedData[0] = property;
+    StreamContext craftedContext = {};
+    decompressor = Decompressor::Make(CompressionAlgorithm::LZMA, &craftedContext,
+                                      craftedData.data(),
+                                      static_cast<uint32_t>(craftedData.size()));
+    ASSERT_NE(decompressor, nullptr);
+    EXPECT_FALSE(decompressor->read(output.data(), static_cast<uint32_t>(output.size())));
+    EXPECT_TRUE(craftedContext.hasException());
+  }
+}
+
+/**
+ * 用例描述: 从共享的 ByteData 解码时内嵌数据直接引用原始数据, 原始数据的引用释放后仍然有效
+ */
+PAG_TEST(PAGFileMappedLoading, SharedByteData) {
+  std::shared_ptr<ByteData> byteData = ByteData::FromPath(PAG_CORRECT_FILE_PATH);
+  ASSERT_NE(byteData, nullptr);
+  auto begin = byteData->data();
+  auto end = begin + byteData->length();
+  auto file = Codec::Decode(byteData, "");
+  ASSERT_NE(file, nullptr);
+  ASSERT_FALSE(file->images.empty());
+  for (auto imageBytes : file->images) {
+    auto bytes = imageBytes->fileBytes->data();
+    EXPECT_TRUE(bytes >= begin && bytes < end);
+  }
+  auto copiedFile = Codec::Decode(byteData->data(), static_cast<uint32_t>(byteData->length()), "");
+  ASSERT_NE(copiedFile, nullptr);
+  byteData = nullptr;
+  auto encodedData = Codec::Encode(file);
+  auto copiedData = Codec::Encode(copiedFile);
+  ASSERT_EQ(encodedData->length(), copiedData->length());
+  EXPECT_EQ(memcmp(encodedData->data(), copiedData->data(), encodedData->length()), 0);
+}
+
+/**
+ * 用例描述: 延迟解码时序列帧在首次引用时才解码, 解码结果与直接解码一致
+ */
+PAG_TEST(PAGFileLazyDecoding, DeferredSequences) {
+  std::vector<std::string> paths = {"../resources/apitest/bitmap_sequence_test.pag",
+                                    "../resources/apitest/video_sequence_test.pag"};
+  for (auto& path : paths) {
+    std::shared_ptr<ByteData> byteData = ByteData::FromPath(path);
+    ASSERT_NE(byteData, nullptr);
+    auto lazyFile = Codec::Decode(byteData, path, true);
+    ASSERT_NE(lazyFile, nullptr);
+    auto eagerFile = Codec::Decode(byteData, path);
+    ASSERT_NE(eagerFile, nullptr);
+    int sequenceCount = 0;
+    for (auto composition : lazyFile->compositions) {
+      if (composition->type() == CompositionType::Bitmap) {
+        EXPECT_TRUE(static_cast<BitmapComposition*>(composition)->sequences.empty());
+      } else if (composition->type() == CompositionType::Video) {
+        EXPECT_TRUE(static_cast<VideoComposition*>(composition)->sequences.empty());
+      } else {
+        continue;
+      }
+      EXPECT_NE(Sequence::Get(composition), nullptr);
+      sequenceCount++;
+    }
+    EXPECT_GT(sequenceCount, 0);
+    // 序列帧解码后, 引用它们的 VectorComposition 也需要重新计算静态区间。
+    for (auto composition : lazyFile->compositions) {
+      composition->decodeDeferredContent();
+    }
+    ASSERT_EQ(lazyFile->compositions.size(), eagerFile->compositions.size());
+    for (size_t i = 0; i < lazyFile->compositions.size(); i++) {
+      auto& lazyRanges = lazyFile->compositions[i]->staticTimeRanges;
+      auto& eagerRanges = eagerFile->compositions[i]->staticTimeRanges;
+      ASSERT_EQ(lazyRanges.size(), eagerRanges.size());
+      for (size_t j = 0; j < lazyRanges.size(); j++) {
+        EXPECT_EQ(lazyRanges[j].start, eagerRanges[j].start);
+        EXPECT_EQ(lazyRanges[j].end, eagerRanges[j].end);
+      }
+    }
+    auto lazyData = Codec::Encode(lazyFile);
+    auto eagerData = Codec::Encode(eagerFile);
+    ASSERT_EQ(lazyData->length(), eagerData->length());
+    EXPECT_EQ(memcmp(lazyData->data(), eagerData->data(), lazyData->length()), 0);
+  }
+}
+
+/**
+ * 用例描述: 并行解码和顺序解码得到的文件完全一致
+ */
+PAG_TEST(PAGFileParallelDecoding, SameAsSequential) {
+  std::vector<std::string> files;
+  GetAllPAGFiles("../resources/apitest", files);
+  ASSERT_FALSE(files.empty());
+  for (auto& filePath : files) {
+    std::shared_ptr<ByteData> byteData = ByteData::FromPath(filePath);
+    ASSERT_NE(byteData, nullptr);
+    Codec::SetParallelDecoding(false);
+    auto sequentialFile = Codec::Decode(byteData, filePath);
+    Codec::SetParallelDecoding(true);
+    auto parallelFile = Codec::Decode(byteData, filePath);
+    Codec::SetParallelDecoding(false);
+    if (sequentialFile == nullptr) {
+      EXPECT_EQ(parallelFile, nullptr);
+      continue;
+    }
+    ASSERT_NE(parallelFile, nullptr);
+    EXPECT_EQ(parallelFile->tagLevel(), sequentialFile->tagLevel());
+    auto sequentialData = Codec::Encode(sequentialFile);
+    auto parallelData = Codec::Encode(parallelFile);
+    ASSERT_EQ(parallelData->length(), sequentialData->length());
+    EXPECT_EQ(memcmp(parallelData->data(), sequentialData->data(), parallelData->length()), 0);
+  }
+}
 }  // namespace pag
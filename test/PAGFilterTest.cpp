@@ -19,6 +19,8 @@
 #include <fstream>
 #include "framework/pag_test.h"
 #include "framework/utils/PAGTestUtils.h"
+#include "gpu/SurfacePool.h"
+#include "gpu/opengl/GLDevice.h"
 #include "nlohmann/json.hpp"
 
 namespace pag {
@@ -275,4 +277,47 @@ PAG_TEST(PAGFilterTest, MultiFilter) {
   pagPlayer->flush();
   EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGFilterTest/MultiFilter_Motiontile_Blur"));
 }
+
+/**
+ * 用例描述: 滤镜的中间缓存在释放后可以被同尺寸或同一档近似尺寸的请求复用
+ */
+PAG_TEST(PAGFilterTest, SurfacePool) {
+  auto device = GLDevice::Make();
+  ASSERT_TRUE(device != nullptr);
+  auto context = device->lockContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surfacePool = context->getSurfacePool();
+  auto surface = surfacePool->getSurface(100, 80);
+  ASSERT_TRUE(surface != nullptr);
+  auto otherSurface = surfacePool->getSurface(100, 80);
+  ASSERT_TRUE(otherSurface != nullptr);
+  EXPECT_NE(surface, otherSurface);
+  EXPECT_EQ(surfacePool->missCount(), 2u);
+  auto surfacePtr = surface.get();
+  surface = nullptr;
+  surface = surfacePool->getSurface(100, 80);
+  EXPECT_EQ(surface.get(), surfacePtr);
+  EXPECT_EQ(surfacePool->hitCount(), 1u);
+  auto smallSurface = surfacePool->getSurface(50, 40);
+  ASSERT_TRUE(smallSurface != nullptr);
+  EXPECT_EQ(surfacePool->missCount(), 3u);
+  // 近似尺寸的请求向上取整到 64 的倍数，尺寸相近的请求共用同一个缓存。
+  auto approximateSurface = surfacePool->getSurface(100, 80, 1, true);
+  ASSERT_TRUE(approximateSurface != nullptr);
+  EXPECT_EQ(approximateSurface->width(), 128);
+  EXPECT_EQ(approximateSurface->height(), 128);
+  EXPECT_EQ(surfacePool->missCount(), 4u);
+  auto approximatePtr = approximateSurface.get();
+  approximateSurface = nullptr;
+  approximateSurface = surfacePool->getSurface(110, 90, 1, true);
+  EXPECT_EQ(approximateSurface.get(), approximatePtr);
+  EXPECT_EQ(surfacePool->hitCount(), 2u);
+  surface = nullptr;
+  otherSurface = nullptr;
+  smallSurface = nullptr;
+  approximateSurface = nullptr;
+  context->purgeResourcesNotUsedIn(0);
+  EXPECT_TRUE(surfacePool->empty());
+  device->unlock();
+}
 }  // namespace pag
@@ -18,9 +18,13 @@
 
 #include <base/utils/TimeUtil.h>
 #include <iostream>
+#include "base/keyframes/SingleEaseKeyframe.h"
 #include "framework/pag_test.h"
 #include "framework/utils/PAGTestUtils.h"
 #include "nlohmann/json.hpp"
+#include "rendering/caches/FrameCacheBudget.h"
+#include "rendering/caches/LayerCache.h"
+#include "rendering/renderers/TransformRenderer.h"
 
 namespace pag {
 using nlohmann::json;
@@ -278,4 +282,67 @@ PAG_TEST_F(PAGLayerTest, Opacity) {
   pagPlayer->flush();
   EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGLayerTest/Opacity"));
 }
+
+/**
+ * 用例描述: 在线程池里提前生成图层后续帧的内容
+ */
+PAG_TEST_F(PAGLayerTest, prepareFrame) {
+  auto pagFile = PAGFile::Load("../resources/apitest/ShapeType.pag");
+  ASSERT_NE(pagFile, nullptr);
+  int target = 0;
+  auto shapeLayer = GetLayer(pagFile, LayerType::Shape, target);
+  ASSERT_NE(shapeLayer, nullptr);
+  auto layerCache = shapeLayer->layerCache;
+  FrameCacheStats stats = {};
+  ScopedFrameCacheStats scopedStats(&stats);
+  layerCache->prepareFrame(0, true);
+  auto content = layerCache->getContent(0);
+  ASSERT_NE(content, nullptr);
+  // 提前准备的帧被请求时，无论是否已经生成完毕都会计入当前线程的统计。
+  EXPECT_EQ(stats.prefetchHits + stats.prefetchMisses, 1u);
+  // 已经缓存的帧不会被重复生成。
+  layerCache->prepareFrame(0, true);
+  EXPECT_EQ(layerCache->getContent(0), content);
+}
+
+static std::unique_ptr<Layer> MakeRotatingNullLayer(Layer* parent, Frame startTime,
+                                                    Frame duration) {
+  auto layer = new NullLayer();
+  layer->startTime = startTime;
+  layer->duration = duration;
+  layer->parent = parent;
+  layer->transform = Transform2D::MakeDefault();
+  auto keyframe = new SingleEaseKeyframe<float>();
+  keyframe->startValue = 0.0f;
+  keyframe->endValue = 90.0f;
+  keyframe->startTime = startTime;
+  keyframe->endTime = startTime + duration;
+  keyframe->interpolationType = KeyframeInterpolationType::Linear;
+  delete layer->transform->rotation;
+  layer->transform->rotation = new AnimatableProperty<float>({keyframe});
+  return std::unique_ptr<Layer>(layer);
+}
+
+/**
+ * 用例描述: 帧缓存预算用尽时，子图层在生成矩阵的过程中读取父图层的缓存触发淘汰，不会重复锁定子图层
+ */
+PAG_TEST(PAGLayerCacheTest, parentTransformUnderBudget) {
+  auto parent = MakeRotatingNullLayer(nullptr, 0, 20);
+  auto child = MakeRotatingNullLayer(parent.get(), 5, 20);
+  PAG::SetMaxFrameCacheMemory(0);
+  for (Frame frame = 0; frame < child->duration; frame++) {
+    auto layerFrame = frame + child->startTime;
+    Transform expected = {};
+    RenderTransform(&expected, child->transform, layerFrame);
+    Transform parentTransform = {};
+    RenderTransform(&parentTransform, parent->transform, layerFrame);
+    expected.matrix.postConcat(parentTransform.matrix);
+    auto actual = LayerCache::Get(child.get())->getTransform(frame);
+    ASSERT_NE(actual, nullptr);
+    for (int i = 0; i < 9; i++) {
+      EXPECT_NEAR(actual->matrix.get(i), expected.matrix.get(i), 0.001f);
+    }
+  }
+  PAG::SetMaxFrameCacheMemory(67108864);
+}
 }  // namespace pag
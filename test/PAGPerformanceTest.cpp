@@ -20,13 +20,33 @@
 
 #include <filesystem>
 #include <fstream>
+#include <future>
+#include <thread>
 #include <vector>
 #include "TestUtils.h"
+#include "base/keyframes/SingleEaseKeyframe.h"
 #include "base/utils/GetTimer.h"
+#include "base/utils/Task.h"
 #include "base/utils/TimeUtil.h"
+#include "core/Stream.h"
 #include "framework/pag_test.h"
 #include "framework/utils/PAGTestUtils.h"
+#include "gpu/opengl/GLPathTessellator.h"
 #include "nlohmann/json.hpp"
+#include "raster/Font.h"
+#include "rendering/caches/LayerCache.h"
+#include "rendering/filters/utils/BlurPyramid.h"
+#include "rendering/renderers/TextRenderer.h"
+#include "rendering/renderers/TransformRenderer.h"
+#include "video/SoftAVCDecoder.h"
+#include "video/SoftwareDecoderWrapper.h"
+#include "video/VideoSequenceDemuxer.h"
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace pag {
 using nlohmann::json;
@@ -156,5 +176,786 @@ PAG_TEST(PerformanceTest, TestRender) {
   outGraphicsFile << std::setw(4) << graphicsJson << std::endl;
   outGraphicsFile.close();
 }
+
+/**
+ * 用例描述: 测试不同压缩方式下PAG文件的大小和解码耗时
+ */
+PAG_TEST(PerformanceTest, TestCompression) {
+  std::vector<std::string> files;
+  GetAllPAGFiles("../resources/smoke", files);
+  std::vector<std::pair<std::string, Enum>> compressionTypes = {{"None", CompressionType::None},
+                                                                {"Zlib", CompressionType::Zlib},
+                                                                {"Lzma", CompressionType::Lzma}};
+  json compressionJson;
+  for (auto& filePath : files) {
+    auto fileName = filePath.substr(filePath.rfind('/') + 1, filePath.size());
+    auto pagFile = PAGFile::Load(filePath);
+    ASSERT_NE(pagFile, nullptr);
+    for (auto& item : compressionTypes) {
+      auto byteData = Codec::Encode(pagFile->getFile(), nullptr, item.second);
+      ASSERT_NE(byteData, nullptr);
+      int64_t decodingTime = GetTimer();
+      auto file = Codec::Decode(byteData->data(), static_cast<uint32_t>(byteData->length()), "");
+      decodingTime = GetTimer() - decodingTime;
+      ASSERT_NE(file, nullptr);
+      std::cout << "\n" << fileName << " compression: " << item.first
+                << " size: " << byteData->length() << " decodingTime: " << decodingTime;
+      compressionJson[fileName][item.first] = {byteData->length(), decodingTime};
+    }
+  }
+  std::cout << std::endl;
+  std::filesystem::path compressionConfig(
+      "../test/out/PerformanceTest/performance_compression.json");
+  std::filesystem::create_directories(compressionConfig.parent_path());
+  std::ofstream outCompressionFile(compressionConfig);
+  outCompressionFile << std::setw(4) << compressionJson << std::endl;
+  outCompressionFile.close();
+}
+
+static int64_t GetResidentMemory() {
+#ifdef __APPLE__
+  mach_task_basic_info info = {};
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info),
+                &count) != KERN_SUCCESS) {
+    return 0;
+  }
+  return static_cast<int64_t>(info.resident_size);
+#else
+  std::ifstream statm("/proc/self/statm");
+  int64_t totalPages = 0;
+  int64_t residentPages = 0;
+  statm >> totalPages >> residentPages;
+  return residentPages * sysconf(_SC_PAGESIZE);
+#endif
+}
+
+/**
+ * 用例描述: 对比内存映射后零拷贝解码和整个文件读入内存后拷贝解码的加载耗时和常驻内存增量
+ */
+PAG_TEST(PerformanceTest, TestMappedLoading) {
+  std::vector<std::string> files;
+  GetAllPAGFiles("../resources", files);
+  json loadingJson;
+  for (auto& filePath : files) {
+    auto fileName = filePath.substr(filePath.find("resources/") + 10, filePath.size());
+    auto residentMemory = GetResidentMemory();
+    int64_t mappingTime = GetTimer();
+    auto mappedFile = Codec::Decode(ByteData::FromPath(filePath), "");
+    mappingTime = GetTimer() - mappingTime;
+    auto mappedMemory = GetResidentMemory() - residentMemory;
+    mappedFile = nullptr;
+
+    // 文件数据和内嵌数据的拷贝在解码结束时同时存在, 此时为拷贝解码的内存峰值。
+    residentMemory = GetResidentMemory();
+    int64_t copyingTime = GetTimer();
+    auto stream = Stream::MakeFromFile(filePath);
+    ASSERT_NE(stream, nullptr);
+    auto byteData = ByteData::Make(stream->size());
+    stream->read(byteData->data(), stream->size());
+    auto copiedFile =
+        Codec::Decode(byteData->data(), static_cast<uint32_t>(byteData->length()), "");
+    copyingTime = GetTimer() - copyingTime;
+    auto copiedMemory = GetResidentMemory() - residentMemory;
+    copiedFile = nullptr;
+    byteData = nullptr;
+
+    std::cout << "\n" << fileName << " mmap: " << mappingTime << "us " << mappedMemory
+              << "B copy: " << copyingTime << "us " << copiedMemory << "B";
+    loadingJson[fileName]["Mmap"] = {mappingTime, mappedMemory};
+    loadingJson[fileName]["Copy"] = {copyingTime, copiedMemory};
+  }
+  std::cout << std::endl;
+  std::filesystem::path loadingConfig(
+      "../test/out/PerformanceTest/performance_mapped_loading.json");
+  std::filesystem::create_directories(loadingConfig.parent_path());
+  std::ofstream outLoadingFile(loadingConfig);
+  outLoadingFile << std::setw(4) << loadingJson << std::endl;
+  outLoadingFile.close();
+}
+
+/**
+ * 用例描述: 对比并行解码和顺序解码的耗时
+ */
+PAG_TEST(PerformanceTest, TestParallelDecoding) {
+  std::vector<std::string> files;
+  GetAllPAGFiles("../resources", files);
+  std::vector<std::pair<std::string, bool>> strategies = {{"Sequential", false},
+                                                          {"Parallel", true}};
+  json decodingJson;
+  for (auto& filePath : files) {
+    auto fileName = filePath.substr(filePath.find("resources/") + 10, filePath.size());
+    std::shared_ptr<ByteData> byteData = ByteData::FromPath(filePath);
+    if (byteData == nullptr) {
+      continue;
+    }
+    for (auto& item : strategies) {
+      Codec::SetParallelDecoding(item.second);
+      int64_t decodingTime = GetTimer();
+      for (int i = 0; i < 5; i++) {
+        Codec::Decode(byteData, filePath);
+      }
+      decodingTime = (GetTimer() - decodingTime) / 5;
+      std::cout << "\n" << fileName << " strategy: " << item.first << " decoding: " << decodingTime
+                << "us";
+      decodingJson[fileName][item.first] = decodingTime;
+    }
+  }
+  Codec::SetParallelDecoding(false);
+  std::cout << std::endl;
+  std::filesystem::path decodingConfig(
+      "../test/out/PerformanceTest/performance_parallel_decoding.json");
+  std::filesystem::create_directories(decodingConfig.parent_path());
+  std::ofstream outDecodingFile(decodingConfig);
+  outDecodingFile << std::setw(4) << decodingJson << std::endl;
+  outDecodingFile.close();
+}
+
+/**
+ * 用例描述: 对比序列帧延迟解码和直接解码时的加载耗时和首帧渲染耗时
+ */
+PAG_TEST(PerformanceTest, TestLazyDecoding) {
+  std::vector<std::string> files;
+  GetAllPAGFiles("../resources", files);
+  std::vector<std::pair<std::string, bool>> strategies = {{"Eager", false}, {"Lazy", true}};
+  json decodingJson;
+  for (auto& filePath : files) {
+    auto fileName = filePath.substr(filePath.find("resources/") + 10, filePath.size());
+    for (auto& item : strategies) {
+      File::SetLazyDecoding(item.second);
+      // 前一种方式的 File 已释放，不会命中 File::Load() 的缓存。
+      int64_t loadingTime = GetTimer();
+      auto pagFile = PAGFile::Load(filePath);
+      loadingTime = GetTimer() - loadingTime;
+      if (pagFile == nullptr) {
+        continue;
+      }
+      auto pagSurface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+      ASSERT_NE(pagSurface, nullptr);
+      auto pagPlayer = std::make_shared<PAGPlayer>();
+      pagPlayer->setSurface(pagSurface);
+      pagPlayer->setComposition(pagFile);
+      int64_t firstFrameTime = GetTimer();
+      pagPlayer->flush();
+      firstFrameTime = GetTimer() - firstFrameTime;
+      std::cout << "\n" << fileName << " strategy: " << item.first << " loading: " << loadingTime
+                << "us firstFrame: " << firstFrameTime << "us";
+      decodingJson[fileName][item.first] = {loadingTime, firstFrameTime};
+    }
+  }
+  File::SetLazyDecoding(false);
+  std::cout << std::endl;
+  std::filesystem::path decodingConfig(
+      "../test/out/PerformanceTest/performance_lazy_decoding.json");
+  std::filesystem::create_directories(decodingConfig.parent_path());
+  std::ofstream outDecodingFile(decodingConfig);
+  outDecodingFile << std::setw(4) << decodingJson << std::endl;
+  outDecodingFile.close();
+}
+
+/**
+ * 用例描述: 对比路径遮罩使用 CPU 光栅化和 GPU 曲面细分两种方式时的渲染耗时
+ */
+PAG_TEST(PerformanceTest, TestPathTessellation) {
+  std::vector<std::string> files;
+  GetAllPAGFiles("../resources/smoke", files);
+  std::vector<std::pair<std::string, bool>> strategies = {{"CPU", false}, {"GPU", true}};
+  json tessellationJson;
+  for (auto& filePath : files) {
+    auto fileName = filePath.substr(filePath.rfind('/') + 1, filePath.size());
+    for (auto& item : strategies) {
+      GLPathTessellator::SetEnabled(item.second);
+      auto pagFile = PAGFile::Load(filePath);
+      ASSERT_NE(pagFile, nullptr);
+      // 每种方式使用独立的 Surface，避免复用另一种方式缓存下来的遮罩。
+      auto pagSurface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+      ASSERT_NE(pagSurface, nullptr);
+      auto pagPlayer = std::make_shared<PAGPlayer>();
+      pagPlayer->setSurface(pagSurface);
+      pagPlayer->setComposition(pagFile);
+      Frame totalFrames = TimeToFrame(pagFile->duration(), pagFile->frameRate());
+      int64_t totalTime = 0;
+      for (Frame currentFrame = 0; currentFrame < totalFrames; currentFrame++) {
+        pagPlayer->setProgress((currentFrame + 0.1) * 1.0 / totalFrames);
+        int64_t frameTime = GetTimer();
+        pagPlayer->flush();
+        totalTime += GetTimer() - frameTime;
+      }
+      auto averageTime = totalTime / std::max(totalFrames, static_cast<Frame>(1));
+      std::cout << "\n" << fileName << " strategy: " << item.first << " frameTime: " << averageTime;
+      tessellationJson[fileName][item.first] = averageTime;
+    }
+  }
+  GLPathTessellator::SetEnabled(false);
+  std::cout << std::endl;
+  std::filesystem::path tessellationConfig(
+      "../test/out/PerformanceTest/performance_path_tessellation.json");
+  std::filesystem::create_directories(tessellationConfig.parent_path());
+  std::ofstream outTessellationFile(tessellationConfig);
+  outTessellationFile << std::setw(4) << tessellationJson << std::endl;
+  outTessellationFile.close();
+}
+
+static void SetFastBlurriness(std::shared_ptr<File> file, float blurriness) {
+  for (auto composition : file->compositions) {
+    if (composition->type() != CompositionType::Vector) {
+      continue;
+    }
+    for (auto layer : static_cast<VectorComposition*>(composition)->layers) {
+      for (auto effect : layer->effects) {
+        if (effect->type() != EffectType::FastBlur) {
+          continue;
+        }
+        auto blurEffect = static_cast<FastBlurEffect*>(effect);
+        delete blurEffect->blurriness;
+        blurEffect->blurriness = new Property<float>();
+        blurEffect->blurriness->value = blurriness;
+      }
+    }
+  }
+}
+
+/**
+ * 用例描述: 对比不同模糊半径下, 全分辨率模糊和降采样模糊两种方式的渲染耗时
+ */
+PAG_TEST(PerformanceTest, TestBlurPyramid) {
+  std::vector<float> blurrinessList = {5.0f, 10.0f, 20.0f, 40.0f, 80.0f};
+  std::vector<std::pair<std::string, bool>> strategies = {{"FullResolution", false},
+                                                          {"Pyramid", true}};
+  json blurJson;
+  for (auto blurriness : blurrinessList) {
+    for (auto& item : strategies) {
+      BlurPyramid::SetEnabled(item.second);
+      auto pagFile = PAGFile::Load("../resources/filter/fastblur.pag");
+      ASSERT_NE(pagFile, nullptr);
+      SetFastBlurriness(pagFile->getFile(), blurriness);
+      auto pagSurface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+      ASSERT_NE(pagSurface, nullptr);
+      auto pagPlayer = std::make_shared<PAGPlayer>();
+      pagPlayer->setSurface(pagSurface);
+      pagPlayer->setComposition(pagFile);
+      Frame totalFrames = TimeToFrame(pagFile->duration(), pagFile->frameRate());
+      int64_t totalTime = 0;
+      for (Frame currentFrame = 0; currentFrame < totalFrames; currentFrame++) {
+        pagPlayer->setProgress((currentFrame + 0.1) * 1.0 / totalFrames);
+        int64_t frameTime = GetTimer();
+        pagPlayer->flush();
+        totalTime += GetTimer() - frameTime;
+      }
+      auto averageTime = totalTime / std::max(totalFrames, static_cast<Frame>(1));
+      auto radius = std::to_string(static_cast<int>(blurriness));
+      std::cout << "\nblurriness: " << radius << " strategy: " << item.first
+                << " frameTime: " << averageTime;
+      blurJson[radius][item.first] = averageTime;
+    }
+  }
+  BlurPyramid::SetEnabled(false);
+  std::cout << std::endl;
+  std::filesystem::path blurConfig("../test/out/PerformanceTest/performance_blur_pyramid.json");
+  std::filesystem::create_directories(blurConfig.parent_path());
+  std::ofstream outBlurFile(blurConfig);
+  outBlurFile << std::setw(4) << blurJson << std::endl;
+  outBlurFile.close();
+}
+
+/**
+ * 用例描述: 对比逐帧导出视频时同步读取像素和异步双缓冲读取像素的整体吞吐量
+ */
+PAG_TEST(PerformanceTest, TestReadPixelsAsync) {
+  std::vector<std::string> files;
+  GetAllPAGFiles("../resources/smoke", files);
+  json readbackJson;
+  for (auto& filePath : files) {
+    auto fileName = filePath.substr(filePath.rfind('/') + 1, filePath.size());
+    for (auto async : {false, true}) {
+      auto pagFile = PAGFile::Load(filePath);
+      ASSERT_NE(pagFile, nullptr);
+      auto pagSurface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+      ASSERT_NE(pagSurface, nullptr);
+      auto pagPlayer = std::make_shared<PAGPlayer>();
+      pagPlayer->setSurface(pagSurface);
+      pagPlayer->setComposition(pagFile);
+      auto rowBytes = static_cast<size_t>(pagSurface->width()) * 4;
+      // 双缓冲：第 N 帧的像素在第 N+1 帧渲染完成后才取回。
+      std::vector<uint8_t> pixels[2] = {std::vector<uint8_t>(rowBytes * pagSurface->height()),
+                                        std::vector<uint8_t>(rowBytes * pagSurface->height())};
+      std::future<bool> pendingReadback = {};
+      Frame totalFrames = TimeToFrame(pagFile->duration(), pagFile->frameRate());
+      int64_t totalTime = GetTimer();
+      for (Frame currentFrame = 0; currentFrame < totalFrames; currentFrame++) {
+        pagPlayer->setProgress((currentFrame + 0.1) * 1.0 / totalFrames);
+        pagPlayer->flush();
+        auto dstPixels = pixels[currentFrame % 2].data();
+        if (async) {
+          auto readback = pagSurface->readPixelsAsync(
+              ColorType::RGBA_8888, AlphaType::Premultiplied, dstPixels, rowBytes);
+          if (pendingReadback.valid()) {
+            pendingReadback.get();
+          }
+          pendingReadback = std::move(readback);
+        } else {
+          pagSurface->readPixels(ColorType::RGBA_8888, AlphaType::Premultiplied, dstPixels,
+                                 rowBytes);
+        }
+      }
+      if (pendingReadback.valid()) {
+        pendingReadback.get();
+      }
+      totalTime = GetTimer() - totalTime;
+      auto strategy = async ? "Async" : "Sync";
+      auto fps = totalTime > 0 ? totalFrames * 1000000.0 / static_cast<double>(totalTime) : 0;
+      std::cout << "\n" << fileName << " readback: " << strategy << " fps: " << fps;
+      readbackJson[fileName][strategy] = fps;
+    }
+  }
+  std::cout << std::endl;
+  std::filesystem::path readbackConfig("../test/out/PerformanceTest/performance_readback.json");
+  std::filesystem::create_directories(readbackConfig.parent_path());
+  std::ofstream outReadbackFile(readbackConfig);
+  outReadbackFile << std::setw(4) << readbackJson << std::endl;
+  outReadbackFile.close();
+}
+
+/**
+ * 用例描述: 对比逐帧 setProgress + flush + readPixels 和 renderFrames 批量导出缩略图的吞吐量
+ */
+PAG_TEST(PerformanceTest, TestRenderFrames) {
+  std::vector<std::string> files;
+  GetAllPAGFiles("../resources/smoke", files);
+  json thumbnailJson;
+  for (auto& filePath : files) {
+    auto fileName = filePath.substr(filePath.rfind('/') + 1, filePath.size());
+    for (auto batch : {false, true}) {
+      auto pagFile = PAGFile::Load(filePath);
+      ASSERT_NE(pagFile, nullptr);
+      auto width = 160;
+      auto height = std::max(1, pagFile->height() * width / pagFile->width());
+      auto pagSurface = PAGSurface::MakeOffscreen(width, height);
+      ASSERT_NE(pagSurface, nullptr);
+      auto pagPlayer = std::make_shared<PAGPlayer>();
+      pagPlayer->setSurface(pagSurface);
+      pagPlayer->setComposition(pagFile);
+      Frame totalFrames = TimeToFrame(pagFile->duration(), pagFile->frameRate());
+      std::vector<Frame> frames = {};
+      for (Frame frame = 0; frame < totalFrames; frame += 5) {
+        frames.push_back(frame);
+      }
+      auto columns = 8;
+      auto rows = (static_cast<int>(frames.size()) + columns - 1) / columns;
+      auto rowBytes = static_cast<size_t>(width * columns) * 4;
+      std::vector<uint8_t> pixels(rowBytes * height * rows);
+      int64_t totalTime = GetTimer();
+      if (batch) {
+        pagPlayer->renderFrames(frames, columns, ColorType::RGBA_8888, AlphaType::Premultiplied,
+                                pixels.data(), rowBytes);
+      } else {
+        for (size_t i = 0; i < frames.size(); i++) {
+          pagPlayer->setProgress(FrameToProgress(frames[i], totalFrames));
+          pagPlayer->flush();
+          auto dstPixels =
+              pixels.data() + (i / columns) * height * rowBytes + (i % columns) * width * 4;
+          pagSurface->readPixels(ColorType::RGBA_8888, AlphaType::Premultiplied, dstPixels,
+                                 rowBytes);
+        }
+      }
+      totalTime = GetTimer() - totalTime;
+      auto strategy = batch ? "RenderFrames" : "PerFrame";
+      auto fps = totalTime > 0 ? frames.size() * 1000000.0 / static_cast<double>(totalTime) : 0;
+      std::cout << "\n" << fileName << " thumbnails: " << strategy << " fps: " << fps;
+      thumbnailJson[fileName][strategy] = fps;
+    }
+  }
+  std::cout << std::endl;
+  std::filesystem::path thumbnailConfig("../test/out/PerformanceTest/performance_thumbnail.json");
+  std::filesystem::create_directories(thumbnailConfig.parent_path());
+  std::ofstream outThumbnailFile(thumbnailConfig);
+  outThumbnailFile << std::setw(4) << thumbnailJson << std::endl;
+  outThumbnailFile.close();
+}
+
+class SpinExecutor : public Executor {
+ private:
+  void execute() override {
+    volatile int value = 0;
+    for (int i = 0; i < 1000; i++) {
+      value = value + i;
+    }
+  }
+};
+
+/**
+ * 用例描述: 测试多个线程同时提交不同优先级任务时线程池的调度开销
+ */
+PAG_TEST(PerformanceTest, TestTaskGroupContention) {
+  int taskCount = 20000;
+  for (int producerCount : {1, 4, 16, 32}) {
+    std::vector<std::thread> producers;
+    int64_t totalTime = GetTimer();
+    for (int i = 0; i < producerCount; i++) {
+      producers.emplace_back([=]() {
+        std::vector<std::shared_ptr<Task>> tasks;
+        for (int j = 0; j < taskCount / producerCount; j++) {
+          auto task = Task::Make(std::make_unique<SpinExecutor>());
+          task->run(j % 4 == 0 ? TaskPriority::High : TaskPriority::Low);
+          tasks.push_back(task);
+        }
+        // 取消一半任务，等待其余任务完成
+        for (size_t j = 0; j < tasks.size(); j++) {
+          if (j % 2 == 0) {
+            tasks[j]->cancel();
+          } else {
+            tasks[j]->wait();
+          }
+        }
+      });
+    }
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    totalTime = GetTimer() - totalTime;
+    std::cout << "\nproducers: " << producerCount << " tasks: " << taskCount
+              << " totalTime: " << totalTime << "us";
+  }
+  std::cout << std::endl;
+}
+
+static Layer* MakeAnimatedNullLayer(Layer* parent, Frame startTime, Frame duration) {
+  auto layer = new NullLayer();
+  layer->startTime = startTime;
+  layer->duration = duration;
+  layer->parent = parent;
+  layer->transform = Transform2D::MakeDefault();
+  auto keyframe = new SingleEaseKeyframe<float>();
+  keyframe->startValue = 0.0f;
+  keyframe->endValue = 90.0f;
+  keyframe->startTime = startTime;
+  keyframe->endTime = startTime + duration;
+  keyframe->interpolationType = KeyframeInterpolationType::Linear;
+  delete layer->transform->rotation;
+  layer->transform->rotation = new AnimatableProperty<float>({keyframe});
+  return layer;
+}
+
+static void RenderTransformChain(Transform* transform, Layer* layer, Frame layerFrame) {
+  RenderTransform(transform, layer->transform, layerFrame);
+  auto parent = layer->parent;
+  while (parent != nullptr) {
+    Transform parentTransform = {};
+    RenderTransform(&parentTransform, parent->transform, layerFrame);
+    transform->matrix.postConcat(parentTransform.matrix);
+    parent = parent->parent;
+  }
+}
+
+/**
+ * 用例描述: 对比深层级父子图层复用父级缓存矩阵和逐级重新计算矩阵的耗时
+ */
+PAG_TEST(PerformanceTest, TestParentTransform) {
+  Frame duration = 600;
+  json transformJson;
+  for (int depth : {8, 32, 128}) {
+    // 一条深层级的父子链，每个控制器下面再挂 8 个子图层，起始时间各不相同。
+    std::vector<Layer*> layers = {};
+    Layer* parent = nullptr;
+    for (int i = 0; i < depth; i++) {
+      auto controller = MakeAnimatedNullLayer(parent, i % 5, duration - i % 5);
+      layers.push_back(controller);
+      for (int j = 0; j < 8; j++) {
+        layers.push_back(MakeAnimatedNullLayer(controller, j, duration - j));
+      }
+      parent = controller;
+    }
+    int64_t chainTime = GetTimer();
+    for (Frame frame = 0; frame < duration; frame++) {
+      for (auto layer : layers) {
+        Transform transform = {};
+        RenderTransformChain(&transform, layer, frame);
+      }
+    }
+    chainTime = GetTimer() - chainTime;
+    int64_t cachedTime = GetTimer();
+    for (Frame frame = 0; frame < duration; frame++) {
+      for (auto layer : layers) {
+        auto contentFrame = frame - layer->startTime;
+        if (contentFrame >= 0 && contentFrame < layer->duration) {
+          LayerCache::Get(layer)->getTransform(contentFrame);
+        }
+      }
+    }
+    cachedTime = GetTimer() - cachedTime;
+    // 两种方式计算出的矩阵应该一致。
+    auto leaf = layers.back();
+    Transform expected = {};
+    RenderTransformChain(&expected, leaf, duration - 1);
+    auto actual = LayerCache::Get(leaf)->getTransform(duration - 1 - leaf->startTime);
+    for (int i = 0; i < 9; i++) {
+      EXPECT_NEAR(actual->matrix.get(i), expected.matrix.get(i), 0.001f);
+    }
+    std::cout << "\ndepth: " << depth << " layers: " << layers.size() << " chain: " << chainTime
+              << "us cached: " << cachedTime << "us";
+    transformJson[std::to_string(depth)] = {chainTime, cachedTime};
+    for (auto layer : layers) {
+      delete layer;
+    }
+  }
+  std::cout << std::endl;
+  std::filesystem::path transformConfig(
+      "../test/out/PerformanceTest/performance_parent_transform.json");
+  std::filesystem::create_directories(transformConfig.parent_path());
+  std::ofstream outTransformFile(transformConfig);
+  outTransformFile << std::setw(4) << transformJson << std::endl;
+  outTransformFile.close();
+}
+
+/**
+ * 用例描述: 对比文本图层逐帧重新排版和复用排版缓存只计算文本动画两种方式的渲染耗时
+ */
+PAG_TEST(PerformanceTest, TestTextLayout) {
+  std::vector<std::string> files;
+  GetAllPAGFiles("../resources", files);
+  json layoutJson;
+  for (auto& filePath : files) {
+    auto fileName = filePath.substr(filePath.find("resources/") + 10, filePath.size());
+    auto file = File::Load(filePath);
+    if (file == nullptr) {
+      continue;
+    }
+    std::vector<TextLayer*> textLayers = {};
+    for (auto composition : file->compositions) {
+      if (composition->type() != CompositionType::Vector) {
+        continue;
+      }
+      for (auto layer : static_cast<VectorComposition*>(composition)->layers) {
+        if (layer->type() == LayerType::Text) {
+          textLayers.push_back(static_cast<TextLayer*>(layer));
+        }
+      }
+    }
+    if (textLayers.empty()) {
+      continue;
+    }
+    auto renderAllFrames = [](TextLayer* layer, TextLayoutCache* layoutCache) {
+      auto time = GetTimer();
+      for (Frame frame = 0; frame < layer->duration; frame++) {
+        RenderTexts(layer->sourceText, layer->pathOption, layer->moreOption, &layer->animators,
+                    layer->startTime + frame, layoutCache);
+      }
+      return GetTimer() - time;
+    };
+    int64_t shapingTime = 0;
+    int64_t cachedTime = 0;
+    for (size_t i = 0; i < textLayers.size(); i++) {
+      auto layer = textLayers[i];
+      // 先各执行一遍来预热字体和字形缓存，再交替两种方式的先后顺序。
+      TextLayoutCache warmUpCache = {};
+      renderAllFrames(layer, nullptr);
+      renderAllFrames(layer, &warmUpCache);
+      TextLayoutCache layoutCache = {};
+      if (i % 2 == 0) {
+        shapingTime += renderAllFrames(layer, nullptr);
+        cachedTime += renderAllFrames(layer, &layoutCache);
+      } else {
+        cachedTime += renderAllFrames(layer, &layoutCache);
+        shapingTime += renderAllFrames(layer, nullptr);
+      }
+    }
+    std::cout << "\n" << fileName << " textLayers: " << textLayers.size()
+              << " shaping: " << shapingTime << "us cached: " << cachedTime << "us";
+    layoutJson[fileName] = {shapingTime, cachedTime};
+  }
+  std::cout << std::endl;
+  std::filesystem::path layoutConfig("../test/out/PerformanceTest/performance_text_layout.json");
+  std::filesystem::create_directories(layoutConfig.parent_path());
+  std::ofstream outLayoutFile(layoutConfig);
+  outLayoutFile << std::setw(4) << layoutJson << std::endl;
+  outLayoutFile.close();
+}
+
+/**
+ * 用例描述: 测试多个线程同时读取同一个字体和不同字体的字形路径时的吞吐量
+ */
+PAG_TEST(PerformanceTest, TestTypefaceConcurrency) {
+  std::vector<std::shared_ptr<Typeface>> typefaces = {
+      Typeface::MakeFromPath("../resources/font/NotoSansSC-Regular.otf"),
+      Typeface::MakeFromPath("../resources/font/NotoSerifSC-Regular.otf")};
+  for (auto& typeface : typefaces) {
+    ASSERT_TRUE(typeface != nullptr);
+  }
+  int glyphCount = 2000;
+  json concurrencyJson;
+  for (int threadCount : {1, 2, 4, 8}) {
+    for (bool sameTypeface : {true, false}) {
+      std::vector<std::thread> threads = {};
+      int64_t renderingTime = GetTimer();
+      for (int i = 0; i < threadCount; i++) {
+        auto typeface = typefaces[sameTypeface ? 0 : i % typefaces.size()];
+        threads.emplace_back([typeface, glyphCount]() {
+          Font font(typeface, 40);
+          for (int j = 0; j < glyphCount; j++) {
+            Path path = {};
+            font.getGlyphPath(static_cast<GlyphID>(j + 1), &path);
+          }
+        });
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+      renderingTime = GetTimer() - renderingTime;
+      auto throughput = static_cast<int64_t>(threadCount) * glyphCount * 1000000 /
+                        std::max(renderingTime, static_cast<int64_t>(1));
+      auto name = sameTypeface ? "SameTypeface" : "DifferentTypefaces";
+      std::cout << "\nthreads: " << threadCount << " " << name << ": " << renderingTime << "us "
+                << throughput << " glyphs/s";
+      concurrencyJson[name][std::to_string(threadCount)] = {renderingTime, throughput};
+    }
+  }
+  std::cout << std::endl;
+  std::filesystem::path concurrencyConfig(
+      "../test/out/PerformanceTest/performance_typeface_concurrency.json");
+  std::filesystem::create_directories(concurrencyConfig.parent_path());
+  std::ofstream outConcurrencyFile(concurrencyConfig);
+  outConcurrencyFile << std::setw(4) << concurrencyJson << std::endl;
+  outConcurrencyFile.close();
+}
+
+static int64_t MeasureFirstFlush(const std::string& filePath, bool warmUp) {
+  auto pagFile = PAGFile::Load(filePath);
+  // Each offscreen surface has its own GPU context, so the programs compiled by the previous
+  // rounds are never reused, only the binaries on disk are.
+  auto pagSurface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  if (warmUp) {
+    pagPlayer->warmUp();
+  }
+  auto startTime = GetTimer();
+  pagPlayer->flush();
+  return GetTimer() - startTime;
+}
+
+/**
+ * 用例描述: 对比冷启动、warmUp() 预热和加载磁盘上的程序二进制三种情况下首帧 flush 的耗时
+ */
+PAG_TEST(PerformanceTest, TestProgramWarmUp) {
+  std::vector<std::string> files;
+  GetAllPAGFiles("../resources/smoke", files);
+  std::filesystem::path cacheDirectory("../test/out/PerformanceTest/program_cache");
+  std::filesystem::remove_all(cacheDirectory);
+  std::filesystem::create_directories(cacheDirectory);
+  json warmUpJson;
+  for (auto& filePath : files) {
+    auto fileName = filePath.substr(filePath.rfind('/') + 1, filePath.size());
+    PAG::SetProgramCacheDirectory("");
+    auto coldTime = MeasureFirstFlush(filePath, false);
+    auto warmUpTime = MeasureFirstFlush(filePath, true);
+    PAG::SetProgramCacheDirectory(cacheDirectory.string());
+    // Populates the cache directory first.
+    MeasureFirstFlush(filePath, true);
+    auto binaryTime = MeasureFirstFlush(filePath, false);
+    std::cout << "\n" << fileName << " first flush: Cold: " << coldTime
+              << "us WarmUp: " << warmUpTime << "us ProgramBinary: " << binaryTime << "us";
+    warmUpJson[fileName] = {{"Cold", coldTime},
+                            {"WarmUp", warmUpTime},
+                            {"ProgramBinary", binaryTime}};
+  }
+  PAG::SetProgramCacheDirectory("");
+  std::filesystem::remove_all(cacheDirectory);
+  std::cout << std::endl;
+  std::filesystem::path warmUpConfig("../test/out/PerformanceTest/performance_program_warmup.json");
+  std::filesystem::create_directories(warmUpConfig.parent_path());
+  std::ofstream outWarmUpFile(warmUpConfig);
+  outWarmUpFile << std::setw(4) << warmUpJson << std::endl;
+  outWarmUpFile.close();
+}
+#ifdef PAG_USE_LIBAVC
+static int DecodeAllFrames(VideoSequence* sequence) {
+  VideoConfig config = {};
+  config.hasAlpha = sequence->alphaStartX + sequence->alphaStartY > 0;
+  config.width = sequence->alphaStartX + sequence->width;
+  config.height = sequence->alphaStartY + sequence->height;
+  for (auto& header : sequence->headers) {
+    config.headers.push_back(ByteData::MakeWithoutCopy(header->data(), header->length()));
+  }
+  config.frameRate = sequence->frameRate;
+  // 绕过测试环境中注册的外部解码器，直接测试 libavc。
+  auto decoder = SoftwareDecoderWrapper::Wrap(std::make_unique<SoftAVCDecoder>(), config);
+  if (decoder == nullptr) {
+    return 0;
+  }
+  VideoSequenceDemuxer demuxer(sequence);
+  int decodedFrames = 0;
+  bool inputEndOfStream = false;
+  int tryDecodeCount = 0;
+  while (tryDecodeCount < 100) {
+    if (!inputEndOfStream) {
+      auto data = demuxer.readSampleData();
+      if (data.length <= 0) {
+        inputEndOfStream = decoder->onEndOfStream() == DecodingResult::Success;
+      } else if (decoder->onSendBytes(data.data, data.length, demuxer.getSampleTime()) ==
+                 DecodingResult::Success) {
+        demuxer.advance();
+      }
+    }
+    auto result = decoder->onDecodeFrame();
+    if (result == DecodingResult::Success) {
+      decodedFrames++;
+      tryDecodeCount = 0;
+    } else if (result == DecodingResult::TryAgainLater) {
+      tryDecodeCount++;
+    } else {
+      break;
+    }
+  }
+  return decodedFrames;
+}
+
+/**
+ * 用例描述: 测试 libavc 在不同核数下解码 720p/1080p 视频序列的帧率
+ */
+PAG_TEST(PerformanceTest, TestSoftwareDecoderCores) {
+  std::vector<std::string> files;
+  GetAllPAGFiles("../resources/smoke", files);
+  GetAllPAGFiles("../resources/apitest", files);
+  json decoderJson;
+  for (auto& filePath : files) {
+    auto fileName = filePath.substr(filePath.rfind('/') + 1, filePath.size());
+    auto file = File::Load(filePath);
+    if (file == nullptr) {
+      continue;
+    }
+    for (auto composition : file->compositions) {
+      if (composition->type() != CompositionType::Video) {
+        continue;
+      }
+      for (auto sequence : static_cast<VideoComposition*>(composition)->sequences) {
+        if (std::min(sequence->width, sequence->height) < 720) {
+          continue;
+        }
+        auto sequenceName = fileName + "@" + std::to_string(sequence->width) + "x" +
+                            std::to_string(sequence->height);
+        for (int cores : {1, 2, 4, 8}) {
+          PAGVideoDecoder::SetSoftwareDecoderCores(cores);
+          int64_t decodingTime = GetTimer();
+          auto frames = DecodeAllFrames(sequence);
+          decodingTime = GetTimer() - decodingTime;
+          ASSERT_GT(frames, 0);
+          auto fps = frames * 1000000.0 / std::max(decodingTime, static_cast<int64_t>(1));
+          std::cout << "\n" << sequenceName << " cores: " << cores << " frames: " << frames
+                    << " fps: " << fps;
+          decoderJson[sequenceName][std::to_string(cores)] = fps;
+        }
+      }
+    }
+  }
+  PAGVideoDecoder::SetSoftwareDecoderCores(0);
+  std::cout << std::endl;
+  std::filesystem::path decoderConfig("../test/out/PerformanceTest/performance_decoder_cores.json");
+  std::filesystem::create_directories(decoderConfig.parent_path());
+  std::ofstream outDecoderFile(decoderConfig);
+  outDecoderFile << std::setw(4) << decoderJson << std::endl;
+  outDecoderFile.close();
+}
+#endif
 }  // namespace pag
-#endif
\ No newline at end of file
+#endif
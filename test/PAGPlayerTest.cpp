@@ -16,9 +16,16 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "base/utils/TimeUtil.h"
 #include "framework/pag_test.h"
 #include "framework/utils/PAGTestUtils.h"
+#include "gpu/opengl/GLContext.h"
+#include "gpu/opengl/GLDevice.h"
 #include "nlohmann/json.hpp"
+#include "rendering/Drawable.h"
+#include "rendering/caches/FrameCacheBudget.h"
+#include "rendering/caches/GraphicsMemoryBudget.h"
+#include "rendering/caches/RenderCache.h"
 
 namespace pag {
 using nlohmann::json;
@@ -130,4 +137,288 @@ PAG_TEST_F(PAGPlayerTest, autoClear) {
   EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGPlayerTest/autoClear_autoClear_true"));
 }
 
-}  // namespace pag
\ No newline at end of file
+/**
+ * 用例描述: 多个 PAGPlayer 共享显存预算，并且可以按目标值清理缓存
+ */
+PAG_TEST_F(PAGPlayerTest, graphicsMemoryBudget) {
+  auto pagFile1 = PAGFile::Load("../resources/apitest/test.pag");
+  auto pagSurface1 = PAGSurface::MakeOffscreen(pagFile1->width(), pagFile1->height());
+  auto pagPlayer1 = std::make_shared<PAGPlayer>();
+  pagPlayer1->setSurface(pagSurface1);
+  pagPlayer1->setComposition(pagFile1);
+  pagPlayer1->flush();
+  auto pagFile2 = PAGFile::Load("../resources/apitest/test.pag");
+  auto pagSurface2 = PAGSurface::MakeOffscreen(pagFile2->width(), pagFile2->height());
+  auto pagPlayer2 = std::make_shared<PAGPlayer>();
+  pagPlayer2->setSurface(pagSurface2);
+  pagPlayer2->setComposition(pagFile2);
+  pagPlayer2->flush();
+  auto memoryUsage1 = pagPlayer1->renderCache->graphicsMemory;
+  auto memoryUsage2 = pagPlayer2->renderCache->graphicsMemory;
+  ASSERT_GT(memoryUsage1, 0u);
+  ASSERT_GT(memoryUsage2, 0u);
+  EXPECT_GE(GraphicsMemoryBudget::TotalUsage(), memoryUsage1 + memoryUsage2);
+
+  // 空闲的 PAGPlayer 不需要再次 flush 也会立即释放缓存。
+  PAG::TrimGraphicsMemory(0);
+  EXPECT_EQ(pagPlayer1->renderCache->graphicsMemory, 0u);
+  EXPECT_EQ(pagPlayer2->renderCache->graphicsMemory, 0u);
+
+  // 其他用例的 PAGPlayer 也可能占用着部分显存预算。
+  auto otherUsage = GraphicsMemoryBudget::TotalUsage();
+  PAG::SetMaxGraphicsMemory(otherUsage + memoryUsage1);
+  pagPlayer1->flush();
+  EXPECT_EQ(pagPlayer1->renderCache->graphicsMemory, memoryUsage1);
+  // 预算已被第一个 PAGPlayer 用完，第二个 PAGPlayer 无法再创建缓存。
+  pagPlayer2->flush();
+  EXPECT_EQ(pagPlayer2->renderCache->graphicsMemory, 0u);
+  PAG::SetMaxGraphicsMemory(314572800);
+}
+
+/**
+ * 用例描述: 图层的帧缓存超出预算后按最近最少使用的顺序淘汰
+ */
+PAG_TEST_F(PAGPlayerTest, frameCacheBudget) {
+  auto pagFile = PAGFile::Load("../resources/apitest/test.pag");
+  auto pagSurface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  auto file = pagFile->getFile();
+  auto totalFrames = file->duration();
+  auto playAllFrames = [&]() {
+    for (Frame frame = 0; frame < totalFrames; frame++) {
+      pagPlayer->setProgress((frame + 0.1) / totalFrames);
+      pagPlayer->flush();
+    }
+  };
+
+  PAG::SetMaxFrameCacheMemory(0);
+  playAllFrames();
+  // 每个图层只保留静态区间的帧和最近使用的一帧。
+  auto limitedUsage = CalculateFrameCacheMemory(file);
+  EXPECT_GT(limitedUsage, 0);
+
+  PAG::SetMaxFrameCacheMemory(67108864);
+  playAllFrames();
+  auto fullUsage = CalculateFrameCacheMemory(file);
+  EXPECT_GE(fullUsage, limitedUsage);
+  EXPECT_GE(FrameCacheBudget::TotalUsage(), static_cast<size_t>(fullUsage));
+}
+
+/**
+ * 用例描述: PAGPlayer 只重绘发生变化的区域，并且结果和整屏重绘一致
+ */
+PAG_TEST_F(PAGPlayerTest, partialRedraw) {
+  auto makePlayer = [](std::shared_ptr<PAGSolidLayer>* movingLayer) {
+    auto composition = PAGComposition::Make(400, 400);
+    composition->addLayer(PAGSolidLayer::Make(1000000, 400, 400, Red));
+    *movingLayer = PAGSolidLayer::Make(1000000, 100, 100, Blue);
+    composition->addLayer(*movingLayer);
+    auto pagPlayer = std::make_shared<PAGPlayer>();
+    pagPlayer->setSurface(PAGSurface::MakeOffscreen(400, 400));
+    pagPlayer->setComposition(composition);
+    return pagPlayer;
+  };
+  std::shared_ptr<PAGSolidLayer> movingLayer = nullptr;
+  auto pagPlayer = makePlayer(&movingLayer);
+  std::shared_ptr<PAGSolidLayer> fullMovingLayer = nullptr;
+  auto fullPlayer = makePlayer(&fullMovingLayer);
+  ASSERT_TRUE(pagPlayer->flush());
+  auto renderCache = pagPlayer->renderCache;
+  EXPECT_EQ(renderCache->damagedPixels, renderCache->surfacePixels);
+
+  auto matrix = Matrix::MakeTrans(50, 0);
+  movingLayer->setMatrix(matrix);
+  fullMovingLayer->setMatrix(matrix);
+  ASSERT_TRUE(pagPlayer->flush());
+  // 只有移动图层的旧位置和新位置需要重绘。
+  EXPECT_EQ(renderCache->damagedPixels, static_cast<size_t>(150 * 100));
+  EXPECT_EQ(renderCache->surfacePixels, static_cast<size_t>(400 * 400));
+
+  ASSERT_TRUE(fullPlayer->flush());
+  size_t rowBytes = 400 * 4;
+  std::vector<uint8_t> pixels(rowBytes * 400);
+  std::vector<uint8_t> fullPixels(rowBytes * 400);
+  ASSERT_TRUE(pagPlayer->getSurface()->readPixels(ColorType::RGBA_8888, AlphaType::Premultiplied,
+                                                  pixels.data(), rowBytes));
+  ASSERT_TRUE(fullPlayer->getSurface()->readPixels(ColorType::RGBA_8888, AlphaType::Premultiplied,
+                                                   fullPixels.data(), rowBytes));
+  EXPECT_TRUE(pixels == fullPixels);
+}
+
+class DiscardingDrawable : public OffscreenDrawable {
+ public:
+  DiscardingDrawable(int width, int height, std::shared_ptr<Device> device)
+      : OffscreenDrawable(width, height, std::move(device)) {
+  }
+
+  bool preservesContents() const override {
+    return false;
+  }
+};
+
+/**
+ * 用例描述: 不保留内容的 Drawable 通过后台缓冲区只重绘发生变化的区域，并且结果和整屏重绘一致
+ */
+PAG_TEST_F(PAGPlayerTest, partialRedrawWithBackBuffer) {
+  auto makePlayer = [](std::shared_ptr<PAGSolidLayer>* movingLayer) {
+    auto composition = PAGComposition::Make(400, 400);
+    composition->addLayer(PAGSolidLayer::Make(1000000, 400, 400, Red));
+    *movingLayer = PAGSolidLayer::Make(1000000, 100, 100, Blue);
+    composition->addLayer(*movingLayer);
+    auto drawable = std::make_shared<DiscardingDrawable>(400, 400, GLDevice::Make());
+    auto pagPlayer = std::make_shared<PAGPlayer>();
+    pagPlayer->setSurface(PAGSurface::MakeFrom(drawable));
+    pagPlayer->setComposition(composition);
+    return pagPlayer;
+  };
+  std::shared_ptr<PAGSolidLayer> movingLayer = nullptr;
+  auto pagPlayer = makePlayer(&movingLayer);
+  std::shared_ptr<PAGSolidLayer> fullMovingLayer = nullptr;
+  auto fullPlayer = makePlayer(&fullMovingLayer);
+  ASSERT_TRUE(pagPlayer->flush());
+  auto renderCache = pagPlayer->renderCache;
+  EXPECT_EQ(renderCache->damagedPixels, renderCache->surfacePixels);
+
+  // 第一次可以局部重绘时才创建后台缓冲区，这一帧仍然整屏绘制。
+  movingLayer->setMatrix(Matrix::MakeTrans(50, 0));
+  ASSERT_TRUE(pagPlayer->flush());
+  EXPECT_EQ(renderCache->damagedPixels, renderCache->surfacePixels);
+
+  auto matrix = Matrix::MakeTrans(100, 0);
+  movingLayer->setMatrix(matrix);
+  fullMovingLayer->setMatrix(matrix);
+  ASSERT_TRUE(pagPlayer->flush());
+  EXPECT_EQ(renderCache->damagedPixels, static_cast<size_t>(150 * 100));
+
+  ASSERT_TRUE(fullPlayer->flush());
+  size_t rowBytes = 400 * 4;
+  std::vector<uint8_t> pixels(rowBytes * 400);
+  std::vector<uint8_t> fullPixels(rowBytes * 400);
+  ASSERT_TRUE(pagPlayer->getSurface()->readPixels(ColorType::RGBA_8888, AlphaType::Premultiplied,
+                                                  pixels.data(), rowBytes));
+  ASSERT_TRUE(fullPlayer->getSurface()->readPixels(ColorType::RGBA_8888, AlphaType::Premultiplied,
+                                                   fullPixels.data(), rowBytes));
+  EXPECT_TRUE(pixels == fullPixels);
+}
+
+/**
+ * 用例描述: PAGPlayer 批量渲染多帧到同一张图集，结果与逐帧渲染一致
+ */
+PAG_TEST_F(PAGPlayerTest, renderFrames) {
+  auto pagFile = PAGFile::Load(DEFAULT_PAG_PATH);
+  ASSERT_NE(pagFile, nullptr);
+  auto width = 200;
+  auto height = 150;
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(PAGSurface::MakeOffscreen(width, height));
+  pagPlayer->setComposition(pagFile);
+  pagPlayer->setProgress(0.5);
+  auto progress = pagPlayer->getProgress();
+
+  std::vector<Frame> frames = {0, 3, 10, 20, 30};
+  auto columns = 2;
+  size_t atlasRowBytes = width * columns * 4;
+  std::vector<uint8_t> atlasPixels(atlasRowBytes * height * 3);
+  ASSERT_TRUE(pagPlayer->renderFrames(frames, columns, ColorType::RGBA_8888,
+                                      AlphaType::Premultiplied, atlasPixels.data(),
+                                      atlasRowBytes));
+  EXPECT_DOUBLE_EQ(pagPlayer->getProgress(), progress);
+
+  auto totalFrames = TimeToFrame(pagFile->duration(), pagFile->frameRate());
+  size_t rowBytes = width * 4;
+  std::vector<uint8_t> pixels(rowBytes * height);
+  for (size_t i = 0; i < frames.size(); i++) {
+    pagPlayer->setProgress(FrameToProgress(frames[i], totalFrames));
+    pagPlayer->flush();
+    ASSERT_TRUE(pagPlayer->getSurface()->readPixels(
+        ColorType::RGBA_8888, AlphaType::Premultiplied, pixels.data(), rowBytes));
+    auto cell = atlasPixels.data() + (i / columns) * height * atlasRowBytes +
+                (i % columns) * rowBytes;
+    auto matched = true;
+    for (int y = 0; y < height && matched; y++) {
+      matched = memcmp(cell + y * atlasRowBytes, pixels.data() + y * rowBytes, rowBytes) == 0;
+    }
+    EXPECT_TRUE(matched) << "frame " << frames[i];
+  }
+}
+
+/**
+ * 用例描述: PAGPlayer 批量渲染超过最大纹理尺寸的一行帧，结果与按列渲染一致
+ */
+PAG_TEST_F(PAGPlayerTest, renderFramesWiderThanMaxTextureSize) {
+  auto pagFile = PAGFile::Load(DEFAULT_PAG_PATH);
+  ASSERT_NE(pagFile, nullptr);
+  auto width = 200;
+  auto height = 150;
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  auto pagSurface = PAGSurface::MakeOffscreen(width, height);
+  ASSERT_NE(pagSurface, nullptr);
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  auto context = pagSurface->drawable->getDevice()->lockContext();
+  ASSERT_NE(context, nullptr);
+  auto maxTextureSize = GLContext::Unwrap(context)->caps->maxTextureSize;
+  pagSurface->drawable->getDevice()->unlock();
+
+  auto totalFrames = TimeToFrame(pagFile->duration(), pagFile->frameRate());
+  std::vector<Frame> frames = {};
+  for (int i = 0; i < maxTextureSize / width + 2; i++) {
+    frames.push_back(i % totalFrames);
+  }
+  auto frameCount = static_cast<int>(frames.size());
+  size_t stripRowBytes = width * frameCount * 4;
+  std::vector<uint8_t> stripPixels(stripRowBytes * height);
+  ASSERT_TRUE(pagPlayer->renderFrames(frames, frameCount, ColorType::RGBA_8888,
+                                      AlphaType::Premultiplied, stripPixels.data(),
+                                      stripRowBytes));
+  size_t rowBytes = width * 4;
+  std::vector<uint8_t> columnPixels(rowBytes * height * frameCount);
+  ASSERT_TRUE(pagPlayer->renderFrames(frames, 1, ColorType::RGBA_8888, AlphaType::Premultiplied,
+                                      columnPixels.data(), rowBytes));
+  for (int i = 0; i < frameCount; i++) {
+    auto matched = true;
+    for (int y = 0; y < height && matched; y++) {
+      auto stripRow = stripPixels.data() + y * stripRowBytes + i * rowBytes;
+      auto columnRow = columnPixels.data() + (i * height + y) * rowBytes;
+      matched = memcmp(stripRow, columnRow, rowBytes) == 0;
+    }
+    EXPECT_TRUE(matched) << "frame " << frames[i];
+  }
+}
+
+/**
+ * 用例描述: PAGPlayer 预热后不改变播放进度和渲染结果
+ */
+PAG_TEST_F(PAGPlayerTest, warmUp) {
+  auto pagFile = PAGFile::Load(DEFAULT_PAG_PATH);
+  ASSERT_NE(pagFile, nullptr);
+  auto width = 200;
+  auto height = 150;
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  EXPECT_FALSE(pagPlayer->warmUp());
+  pagPlayer->setComposition(pagFile);
+  EXPECT_FALSE(pagPlayer->warmUp());
+  pagPlayer->setSurface(PAGSurface::MakeOffscreen(width, height));
+  pagPlayer->setProgress(0.5);
+  auto progress = pagPlayer->getProgress();
+  ASSERT_TRUE(pagPlayer->warmUp());
+  EXPECT_DOUBLE_EQ(pagPlayer->getProgress(), progress);
+  pagPlayer->flush();
+  size_t rowBytes = width * 4;
+  std::vector<uint8_t> pixels(rowBytes * height);
+  ASSERT_TRUE(pagPlayer->getSurface()->readPixels(ColorType::RGBA_8888, AlphaType::Premultiplied,
+                                                  pixels.data(), rowBytes));
+
+  auto coldPlayer = std::make_shared<PAGPlayer>();
+  coldPlayer->setSurface(PAGSurface::MakeOffscreen(width, height));
+  coldPlayer->setComposition(PAGFile::Load(DEFAULT_PAG_PATH));
+  coldPlayer->setProgress(progress);
+  coldPlayer->flush();
+  std::vector<uint8_t> coldPixels(rowBytes * height);
+  ASSERT_TRUE(coldPlayer->getSurface()->readPixels(
+      ColorType::RGBA_8888, AlphaType::Premultiplied, coldPixels.data(), rowBytes));
+  EXPECT_TRUE(pixels == coldPixels);
+}
+}  // namespace pag
@@ -20,8 +20,11 @@
 #include "base/utils/TimeUtil.h"
 #include "framework/pag_test.h"
 #include "framework/utils/PAGTestUtils.h"
+#include "gpu/GlyphAtlas.h"
+#include "gpu/PathMaskCache.h"
 #include "gpu/Surface.h"
 #include "gpu/opengl/GLDevice.h"
+#include "gpu/opengl/GLPathTessellator.h"
 #include "nlohmann/json.hpp"
 #include "raster/Mask.h"
 #include "raster/freetype/FTMask.h"
@@ -82,4 +85,386 @@ PAG_TEST(PAGRasterizerTest, TestRasterizer) {
   EXPECT_TRUE(Baseline::Compare(std::static_pointer_cast<PixelBuffer>(buffer),
                                 "PAGRasterizerTest/rasterizer_emoji"));
 }
+
+/**
+ * 用例描述: 测试文字绘制时字形图集的缓存命中
+ */
+PAG_TEST(PAGRasterizerTest, TestGlyphAtlas) {
+  auto typeface = Typeface::MakeFromPath("../resources/font/NotoSansSC-Regular.otf");
+  ASSERT_TRUE(typeface != nullptr);
+  Font font = {};
+  font.setSize(24);
+  font.setTypeface(typeface);
+  std::vector<GlyphID> glyphIDs = {};
+  std::vector<Point> positions = {};
+  float x = 10;
+  for (auto& name : {"H", "e", "l", "l", "o"}) {
+    auto glyphID = font.getGlyphID(name);
+    ASSERT_TRUE(glyphID != 0);
+    glyphIDs.push_back(glyphID);
+    positions.push_back(Point::Make(x, 50));
+    x += font.getGlyphAdvance(glyphID);
+  }
+  Paint paint = {};
+  paint.setColor(Red);
+
+  auto device = GLDevice::Make();
+  ASSERT_TRUE(device != nullptr);
+  auto context = device->lockContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 200, 100);
+  ASSERT_TRUE(surface != nullptr);
+  auto canvas = surface->getCanvas();
+  auto glyphAtlas = context->getGlyphAtlas();
+  auto hits = glyphAtlas->hitCount();
+  auto misses = glyphAtlas->missCount();
+  canvas->drawGlyphs(&glyphIDs[0], &positions[0], glyphIDs.size(), font, paint);
+  // 第二个 "l" 与第一个的亚像素位置可能不同，只校验首次绘制有未命中。
+  EXPECT_GT(glyphAtlas->missCount(), misses);
+  hits = glyphAtlas->hitCount();
+  misses = glyphAtlas->missCount();
+  canvas->clear();
+  canvas->drawGlyphs(&glyphIDs[0], &positions[0], glyphIDs.size(), font, paint);
+  EXPECT_EQ(glyphAtlas->hitCount() - hits, glyphIDs.size());
+  EXPECT_EQ(glyphAtlas->missCount(), misses);
+  // 旋转后的文字不经过字形图集绘制。
+  canvas->clear();
+  auto rotation = Matrix::I();
+  rotation.setRotate(30);
+  canvas->setMatrix(rotation);
+  canvas->drawGlyphs(&glyphIDs[0], &positions[0], glyphIDs.size(), font, paint);
+  EXPECT_EQ(glyphAtlas->hitCount() - hits, glyphIDs.size());
+  EXPECT_EQ(glyphAtlas->missCount(), misses);
+  device->unlock();
+}
+
+static std::shared_ptr<PixelBuffer> DrawTextPixels(Context* context,
+                                                   const std::vector<std::string>& names,
+                                                   const Font& font, const Matrix& matrix) {
+  std::vector<GlyphID> glyphIDs = {};
+  std::vector<Point> positions = {};
+  float x = 0;
+  for (auto& name : names) {
+    auto glyphID = font.getGlyphID(name);
+    glyphIDs.push_back(glyphID);
+    positions.push_back(Point::Make(x, font.getSize()));
+    x += font.getGlyphAdvance(glyphID);
+  }
+  auto surface = Surface::Make(context, 300, 200);
+  if (surface == nullptr) {
+    return nullptr;
+  }
+  auto canvas = surface->getCanvas();
+  canvas->setMatrix(matrix);
+  Paint paint = {};
+  paint.setColor(Red);
+  canvas->drawGlyphs(&glyphIDs[0], &positions[0], glyphIDs.size(), font, paint);
+  auto pixelBuffer = PixelBuffer::Make(surface->width(), surface->height());
+  if (pixelBuffer == nullptr) {
+    return nullptr;
+  }
+  Bitmap bitmap(pixelBuffer);
+  bitmap.eraseAll();
+  if (!surface->readPixels(bitmap.info(), bitmap.writablePixels())) {
+    return nullptr;
+  }
+  return pixelBuffer;
+}
+
+static size_t CountDifferentBytes(const std::shared_ptr<PixelBuffer>& a,
+                                  const std::shared_ptr<PixelBuffer>& b) {
+  Bitmap bitmapA(a);
+  Bitmap bitmapB(b);
+  auto pixelsA = static_cast<const uint8_t*>(bitmapA.pixels());
+  auto pixelsB = static_cast<const uint8_t*>(bitmapB.pixels());
+  size_t diffCount = 0;
+  for (size_t i = 0; i < bitmapA.byteSize(); i++) {
+    if (std::abs(static_cast<int>(pixelsA[i]) - static_cast<int>(pixelsB[i])) > 5) {
+      diffCount++;
+    }
+  }
+  return diffCount;
+}
+
+static bool HasDrawnPixels(const std::shared_ptr<PixelBuffer>& pixelBuffer) {
+  Bitmap bitmap(pixelBuffer);
+  auto pixels = static_cast<const uint8_t*>(bitmap.pixels());
+  for (size_t i = 0; i < bitmap.byteSize(); i++) {
+    if (pixels[i] != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * 用例描述: 测试从字形图集绘制的文字与不经过图集的绘制结果一致，包括彩色字形和空白字形
+ */
+PAG_TEST(PAGRasterizerTest, TestGlyphAtlasPixels) {
+  auto device = GLDevice::Make();
+  ASSERT_TRUE(device != nullptr);
+  auto context = device->lockContext();
+  ASSERT_TRUE(context != nullptr);
+  // 不经过图集的文字按 CPU 光栅化路径绘制，作为对比的基准。
+  GLPathTessellator::SetEnabled(false);
+  auto matrix = Matrix::MakeScale(1.5f);
+  matrix.postTranslate(10.3f, 20.7f);
+
+  Font font = {};
+  font.setSize(24);
+  font.setTypeface(Typeface::MakeFromPath("../resources/font/NotoSansSC-Regular.otf"));
+  ASSERT_TRUE(font.getTypeface() != nullptr);
+  std::vector<std::string> names = {"H", "e", "l", "l", "o", " ", "P", "A", "G"};
+  GlyphAtlas::SetEnabled(false);
+  auto pathPixels = DrawTextPixels(context, names, font, matrix);
+  GlyphAtlas::SetEnabled(true);
+  auto atlasPixels = DrawTextPixels(context, names, font, matrix);
+  ASSERT_TRUE(pathPixels != nullptr && atlasPixels != nullptr);
+  EXPECT_TRUE(HasDrawnPixels(atlasPixels));
+  EXPECT_LE(CountDifferentBytes(pathPixels, atlasPixels), 10u);
+
+  Font emojiFont = {};
+  emojiFont.setSize(40);
+  emojiFont.setTypeface(Typeface::MakeFromPath("../resources/font/NotoColorEmoji.ttf"));
+  ASSERT_TRUE(emojiFont.getTypeface() != nullptr);
+  std::vector<std::string> emojis = {"👻", "🎉", "👻"};
+  GlyphAtlas::SetEnabled(false);
+  auto imagePixels = DrawTextPixels(context, emojis, emojiFont, matrix);
+  GlyphAtlas::SetEnabled(true);
+  auto atlasEmojiPixels = DrawTextPixels(context, emojis, emojiFont, matrix);
+  ASSERT_TRUE(imagePixels != nullptr && atlasEmojiPixels != nullptr);
+  EXPECT_TRUE(HasDrawnPixels(atlasEmojiPixels));
+  EXPECT_LE(CountDifferentBytes(imagePixels, atlasEmojiPixels), 10u);
+  device->unlock();
+}
+
+/**
+ * 用例描述: 测试路径遮罩缓存在平移和缩放下的复用
+ */
+PAG_TEST(PAGRasterizerTest, TestPathMaskCache) {
+  Path path = {};
+  path.addOval(Rect::MakeLTRB(0, 0, 100, 60));
+  path.addRoundRect(Rect::MakeLTRB(20, 10, 80, 50), 10, 10, true);
+  auto device = GLDevice::Make();
+  ASSERT_TRUE(device != nullptr);
+  auto context = device->lockContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 300, 300);
+  ASSERT_TRUE(surface != nullptr);
+  auto canvas = surface->getCanvas();
+  auto maskCache = context->getPathMaskCache();
+  maskCache->releaseAll();
+  canvas->setMatrix(Matrix::MakeTrans(10, 10));
+  canvas->drawPath(path, Red);
+  auto memoryUsage = maskCache->memoryUsage();
+  EXPECT_GT(memoryUsage, 0u);
+  // 只有整数平移时复用同一个遮罩。
+  canvas->setMatrix(Matrix::MakeTrans(150, 120));
+  canvas->drawPath(path, Red);
+  EXPECT_EQ(maskCache->memoryUsage(), memoryUsage);
+  // 小数部分不同的平移生成新的遮罩，避免遮罩偏移。
+  canvas->setMatrix(Matrix::MakeTrans(150.3f, 10));
+  canvas->drawPath(path, Red);
+  EXPECT_GT(maskCache->memoryUsage(), memoryUsage);
+  memoryUsage = maskCache->memoryUsage();
+  // 缩放改变时生成新的遮罩。
+  auto matrix = Matrix::MakeScale(2);
+  matrix.postTranslate(10, 150);
+  canvas->setMatrix(matrix);
+  canvas->drawPath(path, Red);
+  EXPECT_GT(maskCache->memoryUsage(), memoryUsage);
+  memoryUsage = maskCache->memoryUsage();
+  // 大部分被裁剪掉的路径不缓存遮罩。
+  canvas->save();
+  canvas->resetMatrix();
+  Path clip = {};
+  clip.addRect(Rect::MakeXYWH(10, 10, 20, 20));
+  canvas->clipPath(clip);
+  canvas->setMatrix(Matrix::MakeScale(3));
+  canvas->drawPath(path, Red);
+  canvas->restore();
+  EXPECT_EQ(maskCache->memoryUsage(), memoryUsage);
+  maskCache->setBudget(0);
+  EXPECT_EQ(maskCache->memoryUsage(), 0u);
+  EXPECT_TRUE(maskCache->empty());
+  maskCache->setBudget(16 * 1024 * 1024);
+  device->unlock();
+}
+
+/**
+ * 用例描述: 测试路径内容哈希在修改路径后更新
+ */
+PAG_TEST(PAGRasterizerTest, TestPathContentHash) {
+  Path path = {};
+  path.addRect(Rect::MakeXYWH(0, 0, 100, 100));
+  auto hash = path.getContentHash();
+  EXPECT_NE(hash, 0u);
+  auto copy = path;
+  EXPECT_EQ(copy.getContentHash(), hash);
+  copy.lineTo(50, 150);
+  EXPECT_NE(copy.getContentHash(), hash);
+  EXPECT_EQ(path.getContentHash(), hash);
+  path.lineTo(50, 150);
+  EXPECT_EQ(path.getContentHash(), copy.getContentHash());
+  path.setFillType(PathFillType::EvenOdd);
+  EXPECT_NE(path.getContentHash(), copy.getContentHash());
+}
+
+static std::vector<uint8_t> DrawPathPixels(Context* context, const std::vector<Path>& paths,
+                                           int width, int height) {
+  std::vector<uint8_t> pixels = {};
+  auto surface = Surface::Make(context, width, height);
+  if (surface == nullptr) {
+    return pixels;
+  }
+  context->getPathMaskCache()->releaseAll();
+  auto canvas = surface->getCanvas();
+  for (auto& path : paths) {
+    canvas->drawPath(path, Red);
+  }
+  auto info = ImageInfo::Make(width, height, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  pixels.resize(info.byteSize());
+  if (!surface->readPixels(info, pixels.data())) {
+    pixels.clear();
+  }
+  return pixels;
+}
+
+/**
+ * 用例描述: 测试 GPU 曲面细分生成的路径遮罩与 CPU 光栅化的结果一致
+ */
+PAG_TEST(PAGRasterizerTest, TestPathTessellation) {
+  Path path = {};
+  path.addOval(Rect::MakeLTRB(0, 0, 400, 300));
+  path.addRoundRect(Rect::MakeLTRB(100, 50, 300, 250), 30, 30, true);
+  Path star = {};
+  star.setFillType(PathFillType::EvenOdd);
+  star.moveTo(200, 20);
+  star.cubicTo(230, 120, 260, 200, 380, 280);
+  star.lineTo(20, 100);
+  star.lineTo(380, 100);
+  star.quadTo(200, 200, 20, 280);
+  star.close();
+  auto device = GLDevice::Make();
+  ASSERT_TRUE(device != nullptr);
+  auto context = device->lockContext();
+  ASSERT_TRUE(context != nullptr);
+  GLPathTessellator::SetEnabled(false);
+  auto cpuPixels = DrawPathPixels(context, {path, star}, 400, 300);
+  GLPathTessellator::SetEnabled(true);
+  auto gpuPixels = DrawPathPixels(context, {path, star}, 400, 300);
+  GLPathTessellator::SetEnabled(false);
+  ASSERT_FALSE(cpuPixels.empty());
+  ASSERT_EQ(cpuPixels.size(), gpuPixels.size());
+  // 只允许边缘上的抗锯齿有少量差异。
+  size_t diffCount = 0;
+  for (size_t i = 3; i < cpuPixels.size(); i += 4) {
+    if (std::abs(static_cast<int>(cpuPixels[i]) - static_cast<int>(gpuPixels[i])) > 64) {
+      diffCount++;
+    }
+  }
+  EXPECT_LT(diffCount, cpuPixels.size() / 4 / 100);
+  device->unlock();
+}
+
+/**
+ * 用例描述: 测试相同颜色的矩形绘制会被合并为一次 draw call，且绘制结果正确
+ */
+PAG_TEST(PAGRasterizerTest, TestDrawOpBatching) {
+  auto device = GLDevice::Make();
+  ASSERT_TRUE(device != nullptr);
+  auto context = device->lockContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 200, 200);
+  ASSERT_TRUE(surface != nullptr);
+  auto canvas = surface->getCanvas();
+  auto drawCalls = context->drawCallCount();
+  auto batches = context->batchCount();
+  for (int i = 0; i < 10; i++) {
+    Path path = {};
+    path.addRect(Rect::MakeXYWH(static_cast<float>(i * 20), 0, 10, 10));
+    canvas->save();
+    canvas->concat(Matrix::MakeTrans(0, static_cast<float>(i * 10)));
+    canvas->drawPath(path, Red);
+    canvas->restore();
+  }
+  // 还没有 flush 之前不应该产生 draw call。
+  EXPECT_EQ(context->drawCallCount(), drawCalls);
+  Path path = {};
+  path.addRect(Rect::MakeXYWH(0, 150, 10, 10));
+  canvas->drawPath(path, Blue);
+  auto info = ImageInfo::Make(200, 200, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  std::vector<uint8_t> pixels(info.byteSize());
+  ASSERT_TRUE(surface->readPixels(info, pixels.data()));
+  EXPECT_EQ(context->drawCallCount() - drawCalls, 2u);
+  EXPECT_EQ(context->batchCount() - batches, 1u);
+  for (int i = 0; i < 10; i++) {
+    auto pixel = pixels.data() + (i * 10 + 5) * info.rowBytes() + (i * 20 + 5) * 4;
+    EXPECT_EQ(pixel[0], 255);
+    EXPECT_EQ(pixel[3], 255);
+  }
+  auto pixel = pixels.data() + 155 * info.rowBytes() + 5 * 4;
+  EXPECT_EQ(pixel[2], 255);
+  EXPECT_EQ(pixel[3], 255);
+  device->unlock();
+}
+
+/**
+ * 用例描述: 测试非矩形裁剪下的多次绘制复用同一份裁剪遮罩，save/restore 之后裁剪结果仍然正确
+ */
+PAG_TEST(PAGRasterizerTest, TestClipMaskReuse) {
+  auto device = GLDevice::Make();
+  ASSERT_TRUE(device != nullptr);
+  auto context = device->lockContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 200, 200);
+  ASSERT_TRUE(surface != nullptr);
+  auto canvas = surface->getCanvas();
+  Path clip = {};
+  clip.addOval(Rect::MakeWH(200, 200));
+  canvas->clipPath(clip);
+  Path path = {};
+  path.addRect(Rect::MakeXYWH(0, 0, 200, 100));
+  canvas->drawPath(path, Red);
+  path.reset();
+  path.addRect(Rect::MakeXYWH(0, 100, 200, 100));
+  canvas->drawPath(path, Green);
+  canvas->save();
+  Path innerClip = {};
+  innerClip.addOval(Rect::MakeXYWH(60, 60, 80, 80));
+  canvas->clipPath(innerClip);
+  path.reset();
+  path.addRect(Rect::MakeWH(200, 200));
+  canvas->drawPath(path, Blue);
+  canvas->restore();
+  // restore 之后恢复为外层的圆形裁剪，裁剪遮罩需要重新绘制。
+  path.reset();
+  path.addRect(Rect::MakeXYWH(150, 0, 50, 200));
+  canvas->drawPath(path, White);
+
+  auto pixelBuffer = PixelBuffer::Make(surface->width(), surface->height());
+  ASSERT_TRUE(pixelBuffer != nullptr);
+  Bitmap bitmap(pixelBuffer);
+  bitmap.eraseAll();
+  ASSERT_TRUE(surface->readPixels(bitmap.info(), bitmap.writablePixels()));
+  auto pixels = static_cast<const uint8_t*>(bitmap.pixels());
+  auto pixelAt = [&](int x, int y) { return pixels + y * bitmap.rowBytes() + x * 4; };
+  // 圆形裁剪之外的区域没有被绘制。
+  EXPECT_EQ(pixelAt(5, 5)[3], 0);
+  EXPECT_EQ(pixelAt(195, 10)[3], 0);
+  EXPECT_EQ(pixelAt(100, 30)[0], 255);
+  EXPECT_EQ(pixelAt(100, 170)[1], 255);
+  // 内层裁剪之外的区域没有被蓝色覆盖。
+  auto green = pixelAt(30, 110);
+  EXPECT_EQ(green[1], 255);
+  EXPECT_EQ(green[2], 0);
+  auto blue = pixelAt(100, 100);
+  EXPECT_EQ(blue[0], 0);
+  EXPECT_EQ(blue[2], 255);
+  auto white = pixelAt(170, 100);
+  EXPECT_EQ(white[0], 255);
+  EXPECT_EQ(white[1], 255);
+  EXPECT_EQ(white[2], 255);
+  device->unlock();
+}
 }  // namespace pag
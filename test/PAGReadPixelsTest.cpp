@@ -338,4 +338,92 @@ PAG_TEST(PAGReadPixelsTest, JpegCodec) {
   ASSERT_TRUE(res);
 }
 
+/**
+ * 用例描述: 测试 JPEG/WEBP/PNG 按照目标尺寸解码
+ */
+PAG_TEST(PAGReadPixelsTest, ScaledDecoding) {
+  std::vector<std::string> paths = {"../resources/apitest/rotation.jpg",
+                                    "../resources/apitest/imageReplacement.webp",
+                                    "../resources/apitest/test_timestretch.png"};
+  for (auto& path : paths) {
+    auto image = Image::MakeFrom(path);
+    ASSERT_TRUE(image != nullptr);
+    auto buffer = image->makeBuffer(0.3f);
+    ASSERT_TRUE(buffer != nullptr);
+    EXPECT_EQ(buffer->width(), static_cast<int>(ceilf(image->width() * 0.3f)));
+    EXPECT_EQ(buffer->height(), static_cast<int>(ceilf(image->height() * 0.3f)));
+    buffer = image->makeBuffer(1.5f);
+    ASSERT_TRUE(buffer != nullptr);
+    EXPECT_EQ(buffer->width(), image->width());
+    EXPECT_EQ(buffer->height(), image->height());
+  }
+
+  auto image = Image::MakeFrom("../resources/apitest/test_timestretch.png");
+  ASSERT_TRUE(image != nullptr);
+  auto info = ImageInfo::Make(image->width(), image->height(), ColorType::RGBA_8888,
+                              AlphaType::Premultiplied);
+  auto pixels = new (std::nothrow) uint8_t[info.byteSize()];
+  ASSERT_TRUE(pixels);
+  ASSERT_TRUE(image->readPixels(info, pixels));
+  auto scaledInfo = ImageInfo::Make(image->width() / 4, image->height() / 4, ColorType::RGBA_8888,
+                                    AlphaType::Premultiplied);
+  auto scaledPixels = new (std::nothrow) uint8_t[scaledInfo.byteSize()];
+  ASSERT_TRUE(scaledPixels);
+  ASSERT_TRUE(Bitmap(info, pixels).scalePixels(scaledInfo, scaledPixels));
+  // 整数倍缩小时每个像素等于对应 4x4 区域的平均值。
+  for (int y = 0; y < scaledInfo.height(); y += 7) {
+    for (int x = 0; x < scaledInfo.width(); x += 7) {
+      for (int i = 0; i < 4; i++) {
+        int sum = 0;
+        for (int row = 0; row < 4; row++) {
+          for (int column = 0; column < 4; column++) {
+            sum += pixels[(y * 4 + row) * info.rowBytes() + (x * 4 + column) * 4 + i];
+          }
+        }
+        auto result = scaledPixels[y * scaledInfo.rowBytes() + x * 4 + i];
+        EXPECT_LE(abs(result - (sum + 8) / 16), 1);
+      }
+    }
+  }
+  delete[] pixels;
+  delete[] scaledPixels;
+}
+
+/**
+ * 用例描述: 测试 PAGSurface 异步读取的像素与同步读取的结果一致
+ */
+PAG_TEST(PAGReadPixelsTest, TestReadPixelsAsync) {
+  auto pagFile = PAGFile::Load("../resources/apitest/test_repeat.pag");
+  ASSERT_TRUE(pagFile != nullptr);
+  auto pagSurface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+  ASSERT_TRUE(pagSurface != nullptr);
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  auto rowBytes = static_cast<size_t>(pagSurface->width()) * 4;
+  auto byteSize = rowBytes * pagSurface->height();
+  std::vector<uint8_t> syncPixels(byteSize);
+  std::vector<uint8_t> asyncPixels(byteSize);
+  std::vector<uint8_t> nextPixels(byteSize);
+  pagPlayer->setProgress(0.3);
+  pagPlayer->flush();
+  auto result = pagSurface->readPixels(ColorType::RGBA_8888, AlphaType::Premultiplied,
+                                       syncPixels.data(), rowBytes);
+  ASSERT_TRUE(result);
+  auto future = pagSurface->readPixelsAsync(ColorType::RGBA_8888, AlphaType::Premultiplied,
+                                            asyncPixels.data(), rowBytes);
+  // 在等待上一帧的像素之前先渲染下一帧，上一帧的读取结果不应受影响。
+  pagPlayer->setProgress(0.7);
+  pagPlayer->flush();
+  auto nextFuture = pagSurface->readPixelsAsync(ColorType::RGBA_8888, AlphaType::Premultiplied,
+                                                nextPixels.data(), rowBytes);
+  ASSERT_TRUE(future.get());
+  EXPECT_EQ(memcmp(syncPixels.data(), asyncPixels.data(), byteSize), 0);
+  ASSERT_TRUE(nextFuture.get());
+  result = pagSurface->readPixels(ColorType::RGBA_8888, AlphaType::Premultiplied,
+                                  syncPixels.data(), rowBytes);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(memcmp(syncPixels.data(), nextPixels.data(), byteSize), 0);
+}
+
 }  // namespace pag
@@ -394,4 +394,57 @@ PAG_TEST_F(PAGTextLayerTest, TrackMatteTextBounds) {
   }
 }
 
+/**
+ * 用例描述: TextLayoutCache 对排版相关属性相同的 TextDocument 复用排版结果
+ */
+PAG_TEST_F(PAGTextLayerTest, TextLayoutCache) {
+  auto textDocument = std::make_shared<TextDocument>();
+  textDocument->text = "libpag";
+  textDocument->fontSize = 48;
+  TextLayoutCache layoutCache = {};
+  auto layout = layoutCache.getLayout(textDocument.get());
+  ASSERT_NE(layout, nullptr);
+  // 内容相同的另一个 TextDocument 命中同一份排版。
+  auto sameDocument = std::make_shared<TextDocument>(*textDocument);
+  EXPECT_EQ(layoutCache.getLayout(sameDocument.get()), layout);
+  sameDocument->text = "libpag!";
+  EXPECT_NE(layoutCache.getLayout(sameDocument.get()), layout);
+  auto otherDocument = std::make_shared<TextDocument>(*textDocument);
+  otherDocument->boxText = true;
+  otherDocument->boxTextSize = {100, 100};
+  EXPECT_NE(layoutCache.getLayout(otherDocument.get()), layout);
+
+  // 使用排版缓存的渲染结果与逐帧重新排版一致。
+  Property<TextDocumentHandle> sourceText = {};
+  sourceText.value = textDocument;
+  std::vector<TextAnimator*> animators = {};
+  auto content = RenderTexts(&sourceText, nullptr, nullptr, &animators, 0, &layoutCache);
+  ASSERT_NE(content, nullptr);
+  EXPECT_EQ(layoutCache.getLayout(textDocument.get()), layout);
+  auto expected = RenderTexts(&sourceText, nullptr, nullptr, &animators, 0);
+  Rect bounds = Rect::MakeEmpty();
+  Rect expectedBounds = Rect::MakeEmpty();
+  content->graphic->measureBounds(&bounds);
+  expected->graphic->measureBounds(&expectedBounds);
+  EXPECT_TRUE(bounds == expectedBounds);
+
+  // 注册字体后重新排版。
+  auto font = PAGFont::RegisterFont("../resources/font/NotoSerifSC-Regular.otf", 0,
+                                    "TextLayoutCacheFont", "Regular");
+  auto newLayout = layoutCache.getLayout(textDocument.get());
+  EXPECT_NE(newLayout, layout);
+  PAGFont::UnregisterFont(font);
+  EXPECT_NE(layoutCache.getLayout(textDocument.get()), newLayout);
+
+  // 只保留最近使用的几份排版。
+  layout = layoutCache.getLayout(textDocument.get());
+  for (int i = 0; i < 8; i++) {
+    auto document = std::make_shared<TextDocument>(*textDocument);
+    document->text = "libpag" + std::to_string(i);
+    layoutCache.getLayout(document.get());
+  }
+  EXPECT_LE(layoutCache.layouts.size(), 4u);
+  EXPECT_NE(layoutCache.getLayout(textDocument.get()), layout);
+}
+
 }  // namespace pag
@@ -17,8 +17,8 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "LzmaUtil.h"
-#include "test/framework/lzma/Lzma2DecMt.h"
-#include "test/framework/lzma/Lzma2Enc.h"
+#include "vendor/lzma/Lzma2DecMt.h"
+#include "vendor/lzma/Lzma2Enc.h"
 
 namespace pag {
 static void* LzmaAlloc(ISzAllocPtr, size_t size) {
@@ -18,6 +18,7 @@
 
 #include "Canvas.h"
 #include "base/utils/MatrixUtil.h"
+#include "base/utils/UniqueID.h"
 #include "gpu/Surface.h"
 
 namespace pag {
@@ -26,6 +27,7 @@ namespace pag {
 Canvas::Canvas(Surface* surface) : surface(surface) {
   globalPaint.clip.addRect(0, 0, static_cast<float>(surface->width()),
                            static_cast<float>(surface->height()));
+  globalPaint.clipID = UniqueID::Next();
 }
 
 void Canvas::save() {
@@ -81,6 +83,7 @@ void Canvas::clipPath(const Path& path) {
   auto clipPath = path;
   clipPath.transform(globalPaint.matrix);
   globalPaint.clip.addPath(clipPath, PathOp::Intersect);
+  globalPaint.clipID = UniqueID::Next();
 }
 
 void Canvas::drawTexture(const Texture* texture) {
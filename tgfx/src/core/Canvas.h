@@ -42,6 +42,11 @@ struct CanvasPaint {
   Blend blendMode = Blend::SrcOver;
   Matrix matrix = Matrix::I();
   Path clip = {};
+  /**
+   * The generation ID of the clip, which changes every time the clip is modified. Restoring a saved
+   * state also restores the ID of the saved clip.
+   */
+  uint32_t clipID = 0;
 };
 
 /**
@@ -119,6 +124,12 @@ class Canvas {
    */
   virtual void clear() = 0;
 
+  /**
+   * Replacing all pixels inside the rect with transparent color. The rect is in device coordinates
+   * and is rounded out to pixel boundaries, the current clip and matrix are ignored.
+   */
+  virtual void clearRect(const Rect& rect) = 0;
+
   /**
    * Draws a Texture, with its top-left corner at (0, 0), using a mask texture and current alpha,
    * blend mode, clip and matrix. The mask texture has the same position and size with the texture.
@@ -29,6 +29,10 @@ void AlphaFragmentProcessor::onComputeProcessorKey(BytesKey* bytesKey) const {
   bytesKey->write(Type);
 }
 
+bool AlphaFragmentProcessor::onIsEqual(const FragmentProcessor& processor) const {
+  return alpha == static_cast<const AlphaFragmentProcessor&>(processor).alpha;
+}
+
 std::unique_ptr<GLFragmentProcessor> AlphaFragmentProcessor::onCreateGLInstance() const {
   return std::make_unique<GLAlphaFragmentProcessor>();
 }
@@ -37,6 +37,8 @@ class AlphaFragmentProcessor : public FragmentProcessor {
 
   std::unique_ptr<GLFragmentProcessor> onCreateGLInstance() const override;
 
+  bool onIsEqual(const FragmentProcessor& processor) const override;
+
   float alpha = 1;
 
   friend class GLAlphaFragmentProcessor;
@@ -31,6 +31,10 @@ void ConstColorProcessor::onComputeProcessorKey(BytesKey* bytesKey) const {
   bytesKey->write(flag);
 }
 
+bool ConstColorProcessor::onIsEqual(const FragmentProcessor& processor) const {
+  return color == static_cast<const ConstColorProcessor&>(processor).color;
+}
+
 std::unique_ptr<GLFragmentProcessor> ConstColorProcessor::onCreateGLInstance() const {
   return std::make_unique<GLConstColorProcessor>();
 }
@@ -38,6 +38,8 @@ class ConstColorProcessor : public FragmentProcessor {
   explicit ConstColorProcessor(Color4f color) : color(color) {
   }
 
+  bool onIsEqual(const FragmentProcessor& processor) const override;
+
   Color4f color;
 
   friend class GLConstColorProcessor;
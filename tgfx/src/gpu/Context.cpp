@@ -17,9 +17,12 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "Context.h"
+#include "GlyphAtlas.h"
 #include "GradientCache.h"
+#include "PathMaskCache.h"
 #include "Program.h"
 #include "Resource.h"
+#include "SurfacePool.h"
 #include "base/utils/GetTimer.h"
 
 namespace pag {
@@ -42,6 +45,9 @@ class PurgeGuard {
 
 Context::Context(Device* device) : device(device) {
   gradientCache = new GradientCache(this);
+  glyphAtlas = new GlyphAtlas(this);
+  pathMaskCache = new PathMaskCache(this);
+  surfacePool = new SurfacePool(this);
 }
 
 Context::~Context() {
@@ -52,7 +58,13 @@ Context::~Context() {
   DEBUG_ASSERT(recycledResources.empty());
   DEBUG_ASSERT(programMap.empty());
   DEBUG_ASSERT(gradientCache->empty())
+  DEBUG_ASSERT(glyphAtlas->empty())
+  DEBUG_ASSERT(pathMaskCache->empty())
+  DEBUG_ASSERT(surfacePool->empty())
   delete gradientCache;
+  delete glyphAtlas;
+  delete pathMaskCache;
+  delete surfacePool;
 }
 
 Device* Context::getDevice() const {
@@ -86,6 +98,8 @@ void Context::onUnlocked() {
 }
 
 void Context::purgeResourcesNotUsedIn(int64_t usNotUsed) {
+  // Dropping a surface returns its resources to this context, which is not allowed while purging.
+  surfacePool->purgeNotUsedIn(usNotUsed);
   PurgeGuard guard(this);
   auto currentTime = GetTimer();
   std::unordered_map<BytesKey, std::vector<Resource*>, BytesHasher> recycledMap = {};
@@ -110,6 +124,15 @@ void Context::releaseAll(bool releaseGPU) {
   if (gradientCache) {
     gradientCache->releaseAll();
   }
+  if (glyphAtlas) {
+    glyphAtlas->releaseAll();
+  }
+  if (pathMaskCache) {
+    pathMaskCache->releaseAll();
+  }
+  if (surfacePool) {
+    surfacePool->releaseAll();
+  }
   PurgeGuard guard(this);
   for (auto& resource : nonpurgeableResources) {
     if (releaseGPU) {
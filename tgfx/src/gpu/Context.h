@@ -39,6 +39,12 @@ class ProgramCreator;
 
 class GradientCache;
 
+class GlyphAtlas;
+
+class PathMaskCache;
+
+class SurfacePool;
+
 class Context {
  public:
   virtual ~Context();
@@ -57,6 +63,51 @@ class Context {
 
   const Texture* getGradient(const Color4f* colors, const float* positions, int count);
 
+  /**
+   * Returns the glyph atlas that caches rasterized glyphs for text drawing of this context.
+   */
+  GlyphAtlas* getGlyphAtlas() const {
+    return glyphAtlas;
+  }
+
+  /**
+   * Returns the cache of rasterized path masks of this context.
+   */
+  PathMaskCache* getPathMaskCache() const {
+    return pathMaskCache;
+  }
+
+  /**
+   * Returns the pool of temporary offscreen surfaces of this context.
+   */
+  SurfacePool* getSurfacePool() const {
+    return surfacePool;
+  }
+
+  /**
+   * Returns the total number of draw calls submitted to the GPU by this context.
+   */
+  size_t drawCallCount() const {
+    return drawCalls;
+  }
+
+  /**
+   * Returns the total number of draw calls that merged two or more draw ops.
+   */
+  size_t batchCount() const {
+    return batches;
+  }
+
+  /**
+   * Records a draw call that draws the specified number of merged draw ops.
+   */
+  void recordDrawCall(size_t opCount) {
+    drawCalls++;
+    if (opCount > 1) {
+      batches++;
+    }
+  }
+
   /**
    * Returns a reusable resource in the cache.
    */
@@ -86,6 +137,11 @@ class Context {
   std::list<Program*> programLRU = {};
   std::unordered_map<BytesKey, Program*, BytesHasher> programMap = {};
   GradientCache* gradientCache = nullptr;
+  GlyphAtlas* glyphAtlas = nullptr;
+  PathMaskCache* pathMaskCache = nullptr;
+  SurfacePool* surfacePool = nullptr;
+  size_t drawCalls = 0;
+  size_t batches = 0;
   std::vector<Resource*> nonpurgeableResources = {};
   std::vector<std::shared_ptr<Resource>> strongReferences = {};
   std::unordered_map<BytesKey, std::vector<Resource*>, BytesHasher> recycledResources = {};
@@ -51,6 +51,14 @@ class Device {
    */
   void unlock();
 
+  /**
+   * Returns a weak reference to this device, which can be used to lock the device later without
+   * keeping it alive.
+   */
+  std::weak_ptr<Device> weakReference() const {
+    return weakThis;
+  }
+
  protected:
   std::mutex locker = {};
   Context* context = nullptr;
@@ -31,6 +31,36 @@ void FragmentProcessor::computeProcessorKey(Context* context, BytesKey* bytesKey
   }
 }
 
+bool FragmentProcessor::isEqual(const FragmentProcessor& that) const {
+  if (this == &that) {
+    return true;
+  }
+  if (name() != that.name() || textureSamplerCount != that.textureSamplerCount ||
+      coordTransforms.size() != that.coordTransforms.size() ||
+      childProcessors.size() != that.childProcessors.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < coordTransforms.size(); ++i) {
+    if (coordTransforms[i]->matrix != that.coordTransforms[i]->matrix) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < textureSamplerCount; ++i) {
+    if (textureSampler(i) != that.textureSampler(i)) {
+      return false;
+    }
+  }
+  if (!onIsEqual(that)) {
+    return false;
+  }
+  for (size_t i = 0; i < childProcessors.size(); ++i) {
+    if (!childProcessors[i]->isEqual(*that.childProcessors[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
 std::unique_ptr<GLFragmentProcessor> FragmentProcessor::createGLInstance() const {
   auto glFragProc = onCreateGLInstance();
   for (const auto& fChildProcessor : childProcessors) {
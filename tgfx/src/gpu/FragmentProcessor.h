@@ -40,6 +40,13 @@ class FragmentProcessor : public Processor {
 
   void computeProcessorKey(Context* context, BytesKey* bytesKey) const override;
 
+  /**
+   * Returns true if this processor and the specified one generate the same shader code and upload
+   * the same uniforms and textures, so the draws using them can be merged into one draw call.
+   * Processors that don't override onIsEqual() are never considered equal.
+   */
+  bool isEqual(const FragmentProcessor& that) const;
+
   size_t numChildProcessors() const {
     return childProcessors.size();
   }
@@ -137,6 +144,14 @@ class FragmentProcessor : public Processor {
     return nullptr;
   }
 
+  /**
+   * Subclasses compare their own uniform values here. The names, coord transforms, texture samplers
+   * and child processors have already been compared when this is called.
+   */
+  virtual bool onIsEqual(const FragmentProcessor&) const {
+    return false;
+  }
+
   size_t textureSamplerCount = 0;
 
   std::vector<const CoordTransform*> coordTransforms;
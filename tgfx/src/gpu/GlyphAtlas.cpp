@@ -0,0 +1,264 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GlyphAtlas.h"
+#include <atomic>
+#include "Context.h"
+#include "raster/Mask.h"
+
+namespace pag {
+static constexpr int ATLAS_PAGE_SIZE = 1024;
+static constexpr size_t MAX_MASK_PAGES = 4;
+static constexpr size_t MAX_COLOR_PAGES = 2;
+// Mask glyphs are rasterized at 1/64 pixel precision, which keeps them within one level of
+// coverage from the same glyph rasterized as part of a whole text path.
+static constexpr float SUBPIXEL_STEPS = 64.0f;
+// Leaves an empty border around each glyph, so that sampling never picks up its neighbours.
+static constexpr int GLYPH_PADDING = 1;
+
+struct AtlasShelf {
+  int x = 0;
+  int y = 0;
+  int height = 0;
+};
+
+struct AtlasPage {
+  std::shared_ptr<Surface> surface = nullptr;
+  std::vector<AtlasShelf> shelves = {};
+  int nextShelfY = 0;
+  uint64_t lastUsedBatch = 0;
+  std::vector<BytesKey> keys = {};
+};
+
+static std::atomic_bool atlasEnabled = {true};
+
+void GlyphAtlas::SetEnabled(bool enabled) {
+  atlasEnabled = enabled;
+}
+
+bool GlyphAtlas::IsEnabled() {
+  return atlasEnabled;
+}
+
+GlyphAtlas::~GlyphAtlas() {
+  releaseAll();
+}
+
+void GlyphAtlas::beginBatch() {
+  currentBatch++;
+}
+
+bool GlyphAtlas::getGlyph(const Font& font, GlyphID glyphID, const Point& devicePosition,
+                          AtlasGlyph* glyph) {
+  auto typeface = font.getTypeface();
+  auto color = typeface->hasColor();
+  auto origin = Point::Make(floorf(devicePosition.x), floorf(devicePosition.y));
+  auto subpixel = Point::Zero();
+  if (!color) {
+    subpixel.x = floorf((devicePosition.x - origin.x) * SUBPIXEL_STEPS) / SUBPIXEL_STEPS;
+    subpixel.y = floorf((devicePosition.y - origin.y) * SUBPIXEL_STEPS) / SUBPIXEL_STEPS;
+  }
+  BytesKey key = {};
+  key.write(typeface->uniqueID());
+  key.write(font.getSize());
+  uint32_t flags = glyphID;
+  flags |= static_cast<uint32_t>(subpixel.x * SUBPIXEL_STEPS) << 16;
+  flags |= static_cast<uint32_t>(subpixel.y * SUBPIXEL_STEPS) << 22;
+  flags |= font.isFauxBold() ? 1u << 28 : 0u;
+  flags |= font.isFauxItalic() ? 1u << 29 : 0u;
+  key.write(flags);
+  GlyphEntry entry = {};
+  auto result = glyphs.find(key);
+  if (result != glyphs.end()) {
+    hits++;
+    entry = result->second;
+  } else {
+    misses++;
+    if (!addGlyph(key, font, glyphID, subpixel, &entry)) {
+      return false;
+    }
+  }
+  if (entry.page == nullptr) {
+    // The glyph has nothing to draw, e.g. a space.
+    glyph->texture = nullptr;
+    glyph->atlasRect.setEmpty();
+    glyph->deviceRect.setEmpty();
+    return true;
+  }
+  entry.page->lastUsedBatch = currentBatch;
+  glyph->texture = entry.page->surface->getTexture().get();
+  glyph->atlasRect = entry.atlasRect;
+  glyph->deviceRect = entry.bounds;
+  // Color glyphs are not rasterized at subpixel offsets, they are positioned precisely instead.
+  glyph->deviceRect.offset(color ? devicePosition : origin);
+  return true;
+}
+
+bool GlyphAtlas::addGlyph(const BytesKey& key, const Font& font, GlyphID glyphID,
+                          const Point& subpixel, GlyphEntry* entry) {
+  auto color = font.getTypeface()->hasColor();
+  std::shared_ptr<Texture> texture = nullptr;
+  auto bounds = Rect::MakeEmpty();
+  if (color) {
+    auto matrix = Matrix::I();
+    auto buffer = font.getGlyphImage(glyphID, &matrix);
+    if (buffer == nullptr || matrix.getSkewX() != 0 || matrix.getSkewY() != 0) {
+      return false;
+    }
+    bounds = matrix.mapRect(Rect::MakeWH(static_cast<float>(buffer->width()),
+                                         static_cast<float>(buffer->height())));
+    if (buffer->width() > MAX_GLYPH_SIZE || buffer->height() > MAX_GLYPH_SIZE) {
+      return false;
+    }
+    texture = buffer->makeTexture(context);
+  } else {
+    bounds = font.getGlyphBounds(glyphID);
+    bounds.offset(subpixel.x, subpixel.y);
+    bounds.roundOut();
+    if (bounds.isEmpty()) {
+      // Glyphs with nothing to draw are not cached, since they would never belong to any page and
+      // could not be evicted along with it.
+      entry->page = nullptr;
+      return true;
+    }
+    if (bounds.width() > MAX_GLYPH_SIZE || bounds.height() > MAX_GLYPH_SIZE) {
+      return false;
+    }
+    auto mask = Mask::Make(static_cast<int>(bounds.width()), static_cast<int>(bounds.height()));
+    if (mask == nullptr) {
+      return false;
+    }
+    // Rasterizes the outline the same way as the text paths drawn by the canvas, so that glyphs
+    // look the same whether they come from the atlas or not.
+    Path path = {};
+    if (!font.getGlyphPath(glyphID, &path)) {
+      return false;
+    }
+    mask->setMatrix(Matrix::MakeTrans(subpixel.x - bounds.left, subpixel.y - bounds.top));
+    mask->fillPath(path);
+    texture = mask->makeTexture(context);
+  }
+  if (texture == nullptr) {
+    return false;
+  }
+  auto location = Point::Zero();
+  auto page = allocate(color, texture->width() + GLYPH_PADDING * 2,
+                       texture->height() + GLYPH_PADDING * 2, &location);
+  if (page == nullptr) {
+    return false;
+  }
+  auto atlasRect =
+      Rect::MakeXYWH(location.x + GLYPH_PADDING, location.y + GLYPH_PADDING,
+                     static_cast<float>(texture->width()), static_cast<float>(texture->height()));
+  page->surface->getCanvas()->drawTexture(texture.get(),
+                                          Matrix::MakeTrans(atlasRect.x(), atlasRect.y()));
+  entry->page = page;
+  entry->atlasRect = atlasRect;
+  entry->bounds = bounds;
+  page->keys.push_back(key);
+  glyphs[key] = *entry;
+  return true;
+}
+
+static bool AllocateInPage(AtlasPage* page, int width, int height, Point* location) {
+  for (auto& shelf : page->shelves) {
+    // Skips the shelves that are much taller than the glyph to avoid wasting space.
+    if (shelf.height >= height && shelf.height <= height * 2 &&
+        shelf.x + width <= ATLAS_PAGE_SIZE) {
+      location->set(static_cast<float>(shelf.x), static_cast<float>(shelf.y));
+      shelf.x += width;
+      return true;
+    }
+  }
+  // Rounds the height of new shelves up, so that glyphs of similar sizes can share them.
+  auto shelfHeight = (height + 7) & ~7;
+  if (width > ATLAS_PAGE_SIZE || page->nextShelfY + shelfHeight > ATLAS_PAGE_SIZE) {
+    return false;
+  }
+  AtlasShelf shelf = {};
+  shelf.x = width;
+  shelf.y = page->nextShelfY;
+  shelf.height = shelfHeight;
+  page->shelves.push_back(shelf);
+  page->nextShelfY += shelfHeight;
+  location->set(0, static_cast<float>(shelf.y));
+  return true;
+}
+
+AtlasPage* GlyphAtlas::allocate(bool color, int width, int height, Point* location) {
+  auto& pages = color ? colorPages : maskPages;
+  for (auto& page : pages) {
+    if (AllocateInPage(page, width, height, location)) {
+      return page;
+    }
+  }
+  AtlasPage* page = nullptr;
+  auto maxPages = color ? MAX_COLOR_PAGES : MAX_MASK_PAGES;
+  if (pages.size() < maxPages) {
+    auto surface = Surface::Make(context, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, !color);
+    if (surface == nullptr && !color) {
+      surface = Surface::Make(context, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE);
+    }
+    if (surface == nullptr) {
+      return nullptr;
+    }
+    page = new AtlasPage();
+    page->surface = surface;
+    pages.push_back(page);
+  } else {
+    // Evicts the least recently used page, but never the ones used by the current batch.
+    for (auto& candidate : pages) {
+      if (candidate->lastUsedBatch != currentBatch &&
+          (page == nullptr || candidate->lastUsedBatch < page->lastUsedBatch)) {
+        page = candidate;
+      }
+    }
+    if (page == nullptr) {
+      return nullptr;
+    }
+    resetPage(page);
+  }
+  return AllocateInPage(page, width, height, location) ? page : nullptr;
+}
+
+void GlyphAtlas::resetPage(AtlasPage* page) {
+  for (auto& key : page->keys) {
+    glyphs.erase(key);
+  }
+  page->keys.clear();
+  page->shelves.clear();
+  page->nextShelfY = 0;
+  page->surface->getCanvas()->clear();
+}
+
+void GlyphAtlas::releaseAll() {
+  for (auto& page : maskPages) {
+    delete page;
+  }
+  maskPages.clear();
+  for (auto& page : colorPages) {
+    delete page;
+  }
+  colorPages.clear();
+  glyphs.clear();
+}
+
+bool GlyphAtlas::empty() const {
+  return maskPages.empty() && colorPages.empty() && glyphs.empty();
+}
+}  // namespace pag
@@ -0,0 +1,131 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "base/utils/BytesKey.h"
+#include "gpu/Surface.h"
+#include "raster/Font.h"
+
+namespace pag {
+class Context;
+
+/**
+ * Describes where a cached glyph lives in the GlyphAtlas and where it should be drawn.
+ */
+struct AtlasGlyph {
+  /**
+   * The atlas page texture that contains the glyph.
+   */
+  const Texture* texture = nullptr;
+  /**
+   * The glyph area inside the page texture, in pixels.
+   */
+  Rect atlasRect = Rect::MakeEmpty();
+  /**
+   * The area to draw the glyph to, in device coordinates.
+   */
+  Rect deviceRect = Rect::MakeEmpty();
+};
+
+struct AtlasPage;
+
+/**
+ * GlyphAtlas caches rasterized glyphs of a Context in a few large textures, so that text can be
+ * drawn as textured quads without rasterizing and uploading glyphs every frame. Glyphs are keyed
+ * by typeface, glyph ID, size and subpixel position. When all pages are full, the least recently
+ * used page is cleared and reused.
+ */
+class GlyphAtlas {
+ public:
+  /**
+   * Glyphs larger than this size in device pixels are never cached.
+   */
+  static constexpr float MAX_GLYPH_SIZE = 256.0f;
+
+  /**
+   * Sets whether the canvas draws text from the glyph atlas. It is enabled by default.
+   */
+  static void SetEnabled(bool enabled);
+
+  /**
+   * Returns true if the canvas draws text from the glyph atlas.
+   */
+  static bool IsEnabled();
+
+  explicit GlyphAtlas(Context* context) : context(context) {
+  }
+
+  ~GlyphAtlas();
+
+  /**
+   * Starts a new batch of glyph lookups. Pages used by the current batch are never evicted until
+   * the next batch begins, so all glyphs found within one batch can be drawn together.
+   */
+  void beginBatch();
+
+  /**
+   * Finds the glyph in the atlas, and rasterizes it into the atlas if it is not cached yet. The
+   * font size must already be scaled to device pixels. Returns false if the glyph can not be
+   * cached, the caller should draw it in other ways.
+   */
+  bool getGlyph(const Font& font, GlyphID glyphID, const Point& devicePosition, AtlasGlyph* glyph);
+
+  /**
+   * Returns the total number of lookups that found the glyph in the atlas.
+   */
+  size_t hitCount() const {
+    return hits;
+  }
+
+  /**
+   * Returns the total number of lookups that had to rasterize the glyph.
+   */
+  size_t missCount() const {
+    return misses;
+  }
+
+  void releaseAll();
+
+  bool empty() const;
+
+ private:
+  struct GlyphEntry {
+    AtlasPage* page = nullptr;
+    Rect atlasRect = Rect::MakeEmpty();
+    Rect bounds = Rect::MakeEmpty();
+  };
+
+  Context* context = nullptr;
+  uint64_t currentBatch = 0;
+  size_t hits = 0;
+  size_t misses = 0;
+  std::vector<AtlasPage*> maskPages = {};
+  std::vector<AtlasPage*> colorPages = {};
+  std::unordered_map<BytesKey, GlyphEntry, BytesHasher> glyphs = {};
+
+  bool addGlyph(const BytesKey& key, const Font& font, GlyphID glyphID, const Point& subpixel,
+                GlyphEntry* entry);
+
+  AtlasPage* allocate(bool color, int width, int height, Point* location);
+
+  void resetPage(AtlasPage* page);
+};
+}  // namespace pag
@@ -0,0 +1,139 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PathMaskCache.h"
+#include "Context.h"
+#include "gpu/opengl/GLPathTessellator.h"
+
+namespace pag {
+static constexpr size_t DEFAULT_MASK_CACHE_BUDGET = 16 * 1024 * 1024;
+// Masks larger than this size are not cached, they are rasterized with the visible area only.
+static constexpr float MAX_CACHED_MASK_SIZE = 2048.0f;
+// Masks with less than this ratio of their area visible are not cached.
+static constexpr float MIN_VISIBLE_AREA_RATIO = 0.25f;
+
+static void ComputeMaskKey(const Path& path, const Matrix& matrix, BytesKey* key) {
+  auto hash = path.getContentHash();
+  key->write(static_cast<uint32_t>(hash));
+  key->write(static_cast<uint32_t>(hash >> 32));
+  auto bounds = path.getBounds();
+  key->write(bounds.left);
+  key->write(bounds.top);
+  key->write(bounds.right);
+  key->write(bounds.bottom);
+  key->write(matrix.getScaleX());
+  key->write(matrix.getSkewX());
+  key->write(matrix.getSkewY());
+  key->write(matrix.getScaleY());
+  key->write(matrix.getTranslateX());
+  key->write(matrix.getTranslateY());
+}
+
+PathMaskCache::PathMaskCache(Context* context)
+    : context(context), budget(DEFAULT_MASK_CACHE_BUDGET) {
+}
+
+const Texture* PathMaskCache::getMask(const Path& path, const Matrix& matrix,
+                                      const Rect& clipBounds, Rect* deviceRect) {
+  // Factors the integral translation out of the matrix, only the exact subpixel offset affects
+  // the content of the mask, so a cached mask is always drawn where the path would be.
+  auto origin = Point::Make(floorf(matrix.getTranslateX()), floorf(matrix.getTranslateY()));
+  auto maskMatrix = matrix;
+  maskMatrix.setTranslateX(matrix.getTranslateX() - origin.x);
+  maskMatrix.setTranslateY(matrix.getTranslateY() - origin.y);
+  BytesKey key = {};
+  ComputeMaskKey(path, maskMatrix, &key);
+  auto result = entryMap.find(key);
+  if (result != entryMap.end() && result->second->path != path) {
+    // Two different paths share the same hash, the new one replaces the old one.
+    removeEntry(result->second);
+    result = entryMap.end();
+  }
+  if (result != entryMap.end()) {
+    entries.splice(entries.begin(), entries, result->second);
+  } else {
+    auto bounds = maskMatrix.mapRect(path.getBounds());
+    bounds.roundOut();
+    if (bounds.isEmpty() || bounds.width() > MAX_CACHED_MASK_SIZE ||
+        bounds.height() > MAX_CACHED_MASK_SIZE) {
+      return nullptr;
+    }
+    // Rasterizing the whole path is wasted work if only a small part of it is visible, the caller
+    // rasterizes the visible area instead.
+    auto visibleBounds = bounds;
+    visibleBounds.offset(origin.x, origin.y);
+    if (!visibleBounds.intersect(clipBounds) ||
+        visibleBounds.width() * visibleBounds.height() <
+            bounds.width() * bounds.height() * MIN_VISIBLE_AREA_RATIO) {
+      return nullptr;
+    }
+    auto totalMatrix = maskMatrix;
+    totalMatrix.postTranslate(-bounds.left, -bounds.top);
+    auto texture =
+        GLPathTessellator::MakeMask(context, path, totalMatrix, static_cast<int>(bounds.width()),
+                                    static_cast<int>(bounds.height()));
+    if (texture == nullptr) {
+      return nullptr;
+    }
+    auto memory = texture->memoryUsage();
+    if (memory > budget) {
+      return nullptr;
+    }
+    purgeToBudget(budget - memory);
+    MaskEntry entry = {};
+    entry.key = key;
+    entry.path = path;
+    entry.texture = texture;
+    entry.bounds = bounds;
+    entries.push_front(entry);
+    entryMap[key] = entries.begin();
+    totalMemory += memory;
+  }
+  auto& entry = entries.front();
+  *deviceRect = entry.bounds;
+  deviceRect->offset(origin.x, origin.y);
+  return entry.texture.get();
+}
+
+void PathMaskCache::setBudget(size_t bytes) {
+  budget = bytes;
+  purgeToBudget(budget);
+}
+
+void PathMaskCache::purgeToBudget(size_t bytes) {
+  while (totalMemory > bytes && !entries.empty()) {
+    removeEntry(std::prev(entries.end()));
+  }
+}
+
+void PathMaskCache::removeEntry(std::list<MaskEntry>::iterator position) {
+  totalMemory -= position->texture->memoryUsage();
+  entryMap.erase(position->key);
+  entries.erase(position);
+}
+
+void PathMaskCache::releaseAll() {
+  entryMap.clear();
+  entries.clear();
+  totalMemory = 0;
+}
+
+bool PathMaskCache::empty() const {
+  return entries.empty() && entryMap.empty();
+}
+}  // namespace pag
@@ -0,0 +1,86 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <list>
+#include <unordered_map>
+#include "base/utils/BytesKey.h"
+#include "gpu/Texture.h"
+#include "raster/Path.h"
+
+namespace pag {
+class Context;
+
+/**
+ * PathMaskCache keeps the coverage masks of the paths rasterized by a Context, so that the same
+ * shape drawn again, by the same layer in the next frame or by another layer sharing its geometry,
+ * reuses the uploaded texture. Masks are keyed by the cached content hash of the path, the scale
+ * and skew of the matrix and the fractional part of its translation, so a shape that moves by whole
+ * pixels still hits the cache. The path itself is kept in the entry and compared on a hit to rule
+ * out hash collisions. The least recently used masks are evicted when the total memory exceeds the
+ * budget.
+ */
+class PathMaskCache {
+ public:
+  explicit PathMaskCache(Context* context);
+
+  /**
+   * Returns the mask texture of the path transformed by the matrix, and sets the area to draw it
+   * to in device coordinates. The clipBounds is the visible area in device coordinates. Returns
+   * nullptr if the mask is too big to be cached or mostly clipped out, the caller should rasterize
+   * the path itself.
+   */
+  const Texture* getMask(const Path& path, const Matrix& matrix, const Rect& clipBounds,
+                         Rect* deviceRect);
+
+  /**
+   * Returns the total GPU memory held by the cached masks in bytes.
+   */
+  size_t memoryUsage() const {
+    return totalMemory;
+  }
+
+  /**
+   * Sets the maximum GPU memory the cached masks can hold. The default value is 16M.
+   */
+  void setBudget(size_t bytes);
+
+  void releaseAll();
+
+  bool empty() const;
+
+ private:
+  struct MaskEntry {
+    BytesKey key = {};
+    Path path = {};
+    std::shared_ptr<Texture> texture = nullptr;
+    Rect bounds = Rect::MakeEmpty();
+  };
+
+  Context* context = nullptr;
+  size_t budget = 0;
+  size_t totalMemory = 0;
+  std::list<MaskEntry> entries = {};
+  std::unordered_map<BytesKey, std::list<MaskEntry>::iterator, BytesHasher> entryMap = {};
+
+  void purgeToBudget(size_t bytes);
+
+  void removeEntry(std::list<MaskEntry>::iterator position);
+};
+}  // namespace pag
@@ -0,0 +1,60 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "gpu/Resource.h"
+#include "image/ImageInfo.h"
+
+namespace pag {
+/**
+ * ReadbackBuffer holds the pixels of a Surface that are being transferred from the GPU to the CPU
+ * asynchronously. Use Surface::readPixelsAsync() to create one.
+ */
+class ReadbackBuffer : public Resource {
+ public:
+  /**
+   * Returns the width of the pixels in this buffer.
+   */
+  int width() const {
+    return _width;
+  }
+
+  /**
+   * Returns the height of the pixels in this buffer.
+   */
+  int height() const {
+    return _height;
+  }
+
+  /**
+   * Copies the pixels to dstPixels with specified ImageInfo. Blocks until the GPU finishes the
+   * transfer if it is still in flight. The device associated with this buffer must be locked on the
+   * calling thread. Returns true if pixels are copied to dstPixels.
+   */
+  virtual bool readPixels(const ImageInfo& dstInfo, void* dstPixels) = 0;
+
+ protected:
+  ReadbackBuffer(int width, int height) : _width(width), _height(height) {
+  }
+
+ private:
+  int _width = 0;
+  int _height = 0;
+};
+}  // namespace pag
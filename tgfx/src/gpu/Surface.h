@@ -40,6 +40,8 @@ class Context;
 
 class Texture;
 
+class ReadbackBuffer;
+
 /**
  * Surface is responsible for managing the pixels that a canvas draws into. Surface takes care of
  * allocating a Canvas that will draw into the surface. Call surface->getCanvas() to use that
@@ -158,6 +160,16 @@ class Surface {
    */
   bool readPixels(const ImageInfo& dstInfo, void* dstPixels, int srcX = 0, int srcY = 0) const;
 
+  /**
+   * Starts copying all pixels of this Surface to a ReadbackBuffer without waiting for the GPU to
+   * finish the transfer. Call ReadbackBuffer::readPixels() later to get the pixels, the GPU can
+   * keep working on other commands in the meantime. Returns nullptr if the backend doesn't support
+   * asynchronous readback, use readPixels() instead in that case.
+   */
+  virtual std::shared_ptr<ReadbackBuffer> readPixelsAsync() {
+    return nullptr;
+  }
+
   /**
    * Evaluates the Surface to see if it overlaps or intersects with the specified point. The point
    * is in the coordinate space of the Surface. This method always checks against the actual pixels
@@ -0,0 +1,87 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SurfacePool.h"
+#include "base/utils/GetTimer.h"
+
+namespace pag {
+// The granularity of the sizes of the surfaces requested with an approximate fit.
+static constexpr int SURFACE_SIZE_BUCKET = 64;
+
+static int RoundUpToBucket(int size) {
+  return (size + SURFACE_SIZE_BUCKET - 1) / SURFACE_SIZE_BUCKET * SURFACE_SIZE_BUCKET;
+}
+
+static void ComputeSurfaceKey(BytesKey* key, int width, int height, int sampleCount) {
+  key->write(static_cast<uint32_t>(width));
+  key->write(static_cast<uint32_t>(height));
+  key->write(static_cast<uint32_t>(sampleCount));
+}
+
+std::shared_ptr<Surface> SurfacePool::getSurface(int width, int height, int sampleCount,
+                                                 bool approximateFit) {
+  if (approximateFit) {
+    width = RoundUpToBucket(width);
+    height = RoundUpToBucket(height);
+  }
+  BytesKey surfaceKey = {};
+  ComputeSurfaceKey(&surfaceKey, width, height, sampleCount);
+  auto& entries = surfaceMap[surfaceKey];
+  for (auto& entry : entries) {
+    // The pool holds the only reference of a free surface.
+    if (entry.surface.use_count() == 1) {
+      entry.lastUsedTime = GetTimer();
+      hits++;
+      return entry.surface;
+    }
+  }
+  misses++;
+  auto surface = Surface::Make(context, width, height, false, sampleCount);
+  if (surface == nullptr) {
+    if (entries.empty()) {
+      surfaceMap.erase(surfaceKey);
+    }
+    return nullptr;
+  }
+  entries.push_back({surface, GetTimer()});
+  return surface;
+}
+
+void SurfacePool::purgeNotUsedIn(int64_t usNotUsed) {
+  auto currentTime = GetTimer();
+  for (auto item = surfaceMap.begin(); item != surfaceMap.end();) {
+    auto& entries = item->second;
+    for (auto entry = entries.begin(); entry != entries.end();) {
+      if (entry->surface.use_count() == 1 && currentTime - entry->lastUsedTime >= usNotUsed) {
+        entry = entries.erase(entry);
+      } else {
+        entry++;
+      }
+    }
+    if (entries.empty()) {
+      item = surfaceMap.erase(item);
+    } else {
+      item++;
+    }
+  }
+}
+
+void SurfacePool::releaseAll() {
+  surfaceMap.clear();
+}
+}  // namespace pag
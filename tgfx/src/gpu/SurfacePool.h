@@ -0,0 +1,88 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "base/utils/BytesKey.h"
+#include "gpu/Surface.h"
+
+namespace pag {
+class Context;
+
+/**
+ * SurfacePool keeps the offscreen surfaces of a Context that are used as temporary render targets,
+ * such as the intermediate buffers of filters, so that the next draw can reuse their textures and
+ * frame buffers instead of allocating new ones. Surfaces are matched by size and sample count, and
+ * a surface becomes free again once the caller drops all references to it. Callers that can draw
+ * into a sub-rect of a larger surface may request an approximate fit, so that requests of slightly
+ * different sizes, such as the buffers of an animated blur, share the same surfaces.
+ */
+class SurfacePool {
+ public:
+  explicit SurfacePool(Context* context) : context(context) {
+  }
+
+  /**
+   * Returns a free surface with the specified size and sample count, or creates a new one if there
+   * is none. If approximateFit is true, the size is rounded up to a multiple of 64 pixels, and the
+   * caller should draw into the sub-rect of the requested size at the origin of the framebuffer.
+   * The content of a reused surface is undefined, callers should clear it before drawing. Returns
+   * nullptr if the surface can not be created.
+   */
+  std::shared_ptr<Surface> getSurface(int width, int height, int sampleCount = 1,
+                                      bool approximateFit = false);
+
+  /**
+   * Returns the number of requests that were served by a free surface in the pool.
+   */
+  size_t hitCount() const {
+    return hits;
+  }
+
+  /**
+   * Returns the number of requests that had to create a new surface.
+   */
+  size_t missCount() const {
+    return misses;
+  }
+
+  /**
+   * Drops the free surfaces that haven't been used in the past 'usNotUsed' microseconds.
+   */
+  void purgeNotUsedIn(int64_t usNotUsed);
+
+  void releaseAll();
+
+  bool empty() const {
+    return surfaceMap.empty();
+  }
+
+ private:
+  struct PoolEntry {
+    std::shared_ptr<Surface> surface = nullptr;
+    int64_t lastUsedTime = 0;
+  };
+
+  Context* context = nullptr;
+  size_t hits = 0;
+  size_t misses = 0;
+  std::unordered_map<BytesKey, std::vector<PoolEntry>, BytesHasher> surfaceMap = {};
+};
+}  // namespace pag
@@ -96,6 +96,31 @@ static void InitVertexArray(const GLProcGetter* getter, GLInterface* interface,
   }
 }
 
+static void InitMapBuffer(const GLProcGetter* getter, GLInterface* interface,
+                          const GLInfo& info) {
+  if (info.version >= GL_VER(3, 0)) {
+    interface->mapBufferRange =
+        reinterpret_cast<GLMapBufferRange*>(getter->getProcAddress("glMapBufferRange"));
+    interface->unmapBuffer =
+        reinterpret_cast<GLUnmapBuffer*>(getter->getProcAddress("glUnmapBuffer"));
+  }
+}
+
+static void InitProgramBinary(const GLProcGetter* getter, GLInterface* interface,
+                              const GLInfo& info) {
+  if (info.version >= GL_VER(3, 0)) {
+    interface->getProgramBinary =
+        reinterpret_cast<GLGetProgramBinary*>(getter->getProcAddress("glGetProgramBinary"));
+    interface->programBinary =
+        reinterpret_cast<GLProgramBinary*>(getter->getProcAddress("glProgramBinary"));
+  } else if (info.hasExtension("GL_OES_get_program_binary")) {
+    interface->getProgramBinary =
+        reinterpret_cast<GLGetProgramBinary*>(getter->getProcAddress("glGetProgramBinaryOES"));
+    interface->programBinary =
+        reinterpret_cast<GLProgramBinary*>(getter->getProcAddress("glProgramBinaryOES"));
+  }
+}
+
 void GLAssembleGLESInterface(const GLProcGetter* getter, GLInterface* interface,
                              const GLInfo& info) {
   interface->checkFramebufferStatus = reinterpret_cast<GLCheckFramebufferStatus*>(
@@ -109,5 +134,7 @@ void GLAssembleGLESInterface(const GLProcGetter* getter, GLInterface* interface,
   InitRenderbufferStorageMultisample(getter, interface, info);
   InitFramebufferTexture2DMultisample(getter, interface, info);
   InitVertexArray(getter, interface, info);
+  InitMapBuffer(getter, interface, info);
+  InitProgramBinary(getter, interface, info);
 }
 }  // namespace pag
@@ -73,6 +73,26 @@ static void InitRenderbufferStorageMultisample(const GLProcGetter* getter, GLInt
   }
 }
 
+static void InitMapBuffer(const GLProcGetter* getter, GLInterface* interface,
+                          const GLInfo& info) {
+  if (info.version >= GL_VER(3, 0)) {
+    interface->mapBufferRange =
+        reinterpret_cast<GLMapBufferRange*>(getter->getProcAddress("glMapBufferRange"));
+    interface->unmapBuffer =
+        reinterpret_cast<GLUnmapBuffer*>(getter->getProcAddress("glUnmapBuffer"));
+  }
+}
+
+static void InitProgramBinary(const GLProcGetter* getter, GLInterface* interface,
+                              const GLInfo& info) {
+  if (info.version >= GL_VER(4, 1) || info.hasExtension("GL_ARB_get_program_binary")) {
+    interface->getProgramBinary =
+        reinterpret_cast<GLGetProgramBinary*>(getter->getProcAddress("glGetProgramBinary"));
+    interface->programBinary =
+        reinterpret_cast<GLProgramBinary*>(getter->getProcAddress("glProgramBinary"));
+  }
+}
+
 void GLAssembleGLInterface(const GLProcGetter* getter, GLInterface* interface, const GLInfo& info) {
   interface->checkFramebufferStatus = reinterpret_cast<GLCheckFramebufferStatus*>(
       getter->getProcAddress("glCheckFramebufferStatus"));
@@ -81,5 +101,7 @@ void GLAssembleGLInterface(const GLProcGetter* getter, GLInterface* interface, c
   InitBlitFrameBuffer(getter, interface, info);
   InitRenderbufferStorageMultisample(getter, interface, info);
   InitVertexArray(getter, interface, info);
+  InitMapBuffer(getter, interface, info);
+  InitProgramBinary(getter, interface, info);
 }
 }  // namespace pag
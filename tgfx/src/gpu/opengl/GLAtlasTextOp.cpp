@@ -0,0 +1,77 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GLAtlasTextOp.h"
+#include "gpu/QuadPerEdgeAAGeometryProcessor.h"
+
+namespace pag {
+std::unique_ptr<GLAtlasTextOp> GLAtlasTextOp::Make(std::vector<Rect> deviceRects,
+                                                   std::vector<Rect> atlasRects) {
+  if (deviceRects.empty() || deviceRects.size() != atlasRects.size() ||
+      deviceRects.size() > MAX_NUM_GLYPHS) {
+    return nullptr;
+  }
+  return std::unique_ptr<GLAtlasTextOp>(
+      new GLAtlasTextOp(std::move(deviceRects), std::move(atlasRects)));
+}
+
+std::unique_ptr<GeometryProcessor> GLAtlasTextOp::getGeometryProcessor(const DrawArgs& args) {
+  // The quads are always aligned with pixel boundaries, they never need coverage AA.
+  auto aa = args.aa == AAType::MSAA ? AAType::MSAA : AAType::None;
+  return QuadPerEdgeAAGeometryProcessor::Make(args.renderTarget->width(),
+                                              args.renderTarget->height(), args.viewMatrix, aa);
+}
+
+std::vector<float> GLAtlasTextOp::vertices(const DrawArgs&) {
+  std::vector<float> vertices = {};
+  vertices.reserve(deviceRects.size() * 16);
+  for (size_t i = 0; i < deviceRects.size(); i++) {
+    auto& bounds = deviceRects[i];
+    auto& atlasBounds = atlasRects[i];
+    std::initializer_list<float> quad = {
+        bounds.right, bounds.bottom, atlasBounds.right, atlasBounds.bottom,
+        bounds.right, bounds.top,    atlasBounds.right, atlasBounds.top,
+        bounds.left,  bounds.bottom, atlasBounds.left,  atlasBounds.bottom,
+        bounds.left,  bounds.top,    atlasBounds.left,  atlasBounds.top,
+    };
+    vertices.insert(vertices.end(), quad);
+  }
+  return vertices;
+}
+
+static const uint16_t* GetQuadIndices() {
+  static const auto& indices = *[] {
+    auto buffer = new std::vector<uint16_t>();
+    buffer->reserve(GLAtlasTextOp::MAX_NUM_GLYPHS * 6);
+    for (uint16_t i = 0; i < GLAtlasTextOp::MAX_NUM_GLYPHS; i++) {
+      auto index = static_cast<uint16_t>(i * 4);
+      buffer->insert(buffer->end(), {index, static_cast<uint16_t>(index + 1),
+                                     static_cast<uint16_t>(index + 2),
+                                     static_cast<uint16_t>(index + 2),
+                                     static_cast<uint16_t>(index + 1),
+                                     static_cast<uint16_t>(index + 3)});
+    }
+    return buffer;
+  }();
+  return indices.data();
+}
+
+std::shared_ptr<GLBuffer> GLAtlasTextOp::getIndexBuffer(const DrawArgs& args) {
+  return GLBuffer::Make(args.context, GetQuadIndices(), deviceRects.size() * 6);
+}
+}  // namespace pag
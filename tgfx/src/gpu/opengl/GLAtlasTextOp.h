@@ -0,0 +1,56 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "GLDrawer.h"
+
+namespace pag {
+/**
+ * GLAtlasTextOp draws a batch of glyphs sampled from one page of the GlyphAtlas with a single draw
+ * call. The local coordinates of each quad are the pixel coordinates of the glyph in the page.
+ */
+class GLAtlasTextOp : public GLDrawOp {
+ public:
+  /**
+   * The maximum number of glyphs that one op can draw, limited by the 16-bit index buffer.
+   */
+  static constexpr size_t MAX_NUM_GLYPHS = 2048;
+
+  static std::unique_ptr<GLAtlasTextOp> Make(std::vector<Rect> deviceRects,
+                                             std::vector<Rect> atlasRects);
+
+  std::string name() const override {
+    return "GLAtlasTextOp";
+  }
+
+  std::unique_ptr<GeometryProcessor> getGeometryProcessor(const DrawArgs& args) override;
+
+  std::vector<float> vertices(const DrawArgs& args) override;
+
+  std::shared_ptr<GLBuffer> getIndexBuffer(const DrawArgs& args) override;
+
+ private:
+  std::vector<Rect> deviceRects = {};
+  std::vector<Rect> atlasRects = {};
+
+  GLAtlasTextOp(std::vector<Rect> deviceRects, std::vector<Rect> atlasRects)
+      : deviceRects(std::move(deviceRects)), atlasRects(std::move(atlasRects)) {
+  }
+};
+}  // namespace pag
@@ -17,11 +17,16 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GLCanvas.h"
+#include "GLAtlasTextOp.h"
+#include "GLBlend.h"
 #include "GLFillRectOp.h"
+#include "GLPathTessellator.h"
 #include "GLRRectOp.h"
 #include "GLSurface.h"
 #include "base/utils/MathExtra.h"
 #include "gpu/AlphaFragmentProcessor.h"
+#include "gpu/GlyphAtlas.h"
+#include "gpu/PathMaskCache.h"
 #include "gpu/TextureFragmentProcessor.h"
 #include "gpu/TextureMaskFragmentProcessor.h"
 #include "gpu/YUVTextureFragmentProcessor.h"
@@ -33,10 +38,28 @@ namespace pag {
 GLCanvas::GLCanvas(Surface* surface) : Canvas(surface) {
 }
 
+GLCanvas::~GLCanvas() {
+  // The drawer may be reused by other canvases once it is released, no GL calls are allowed here.
+  if (_drawer) {
+    _drawer->discard();
+  }
+}
+
 void GLCanvas::clear() {
+  if (_drawer) {
+    _drawer->flush();
+  }
   static_cast<GLSurface*>(surface)->getRenderTarget()->clear(GLContext::Unwrap(getContext()));
 }
 
+void GLCanvas::clearRect(const Rect& rect) {
+  if (_drawer) {
+    _drawer->flush();
+  }
+  static_cast<GLSurface*>(surface)->getRenderTarget()->clear(GLContext::Unwrap(getContext()),
+                                                             rect);
+}
+
 void GLCanvas::drawTexture(const Texture* texture, const Texture* mask, bool inverted) {
   drawTexture(texture, nullptr, mask, inverted);
 }
@@ -79,9 +102,13 @@ std::unique_ptr<FragmentProcessor> GLCanvas::getClipMask(const Rect& deviceQuad,
       }
     } else {
       auto clipSurface = getClipSurface();
-      auto clipCanvas = clipSurface->getCanvas();
-      clipCanvas->clear();
-      clipCanvas->drawPath(globalPaint.clip, Black);
+      // The coverage of the clip is drawn once and shared by all draws until the clip changes.
+      if (clipSurfaceID != globalPaint.clipID) {
+        auto clipCanvas = clipSurface->getCanvas();
+        clipCanvas->clear();
+        clipCanvas->drawPath(globalPaint.clip, Black);
+        clipSurfaceID = globalPaint.clipID;
+      }
       return TextureMaskFragmentProcessor::MakeUseDeviceCoord(clipSurface->getTexture().get(),
                                                               surface->origin());
     }
@@ -190,7 +217,8 @@ void GLCanvas::drawPath(const Path& path, const Shader* shader) {
     return;
   }
   auto bounds = path.getBounds();
-  auto clippedLocalQuad = clipLocalQuad(bounds, nullptr);
+  auto clippedDeviceQuad = Rect::MakeEmpty();
+  auto clippedLocalQuad = clipLocalQuad(bounds, &clippedDeviceQuad);
   if (clippedLocalQuad.isEmpty()) {
     return;
   }
@@ -202,20 +230,26 @@ void GLCanvas::drawPath(const Path& path, const Shader* shader) {
     draw(bounds, bounds, std::move(op), shader->asFragmentProcessor(args));
     return;
   }
+  auto visibleBounds = clippedDeviceQuad;
+  if (!visibleBounds.intersect(globalPaint.clip.getBounds())) {
+    return;
+  }
+  auto deviceRect = Rect::MakeEmpty();
+  auto maskCache = getContext()->getPathMaskCache();
+  auto cachedMask = maskCache->getMask(path, globalPaint.matrix, visibleBounds, &deviceRect);
+  if (cachedMask != nullptr) {
+    drawMask(deviceRect, cachedMask, shader);
+    return;
+  }
   auto quad = globalPaint.matrix.mapRect(clippedLocalQuad);
   auto width = ceilf(quad.width());
   auto height = ceilf(quad.height());
-  auto mask = Mask::Make(static_cast<int>(width), static_cast<int>(height));
-  if (!mask) {
-    return;
-  }
   auto totalMatrix = globalPaint.matrix;
   auto matrix = Matrix::MakeTrans(-quad.x(), -quad.y());
   matrix.postScale(width / quad.width(), height / quad.height());
   totalMatrix.postConcat(matrix);
-  mask->setMatrix(totalMatrix);
-  mask->fillPath(path);
-  auto maskTexture = mask->makeTexture(getContext());
+  auto maskTexture = GLPathTessellator::MakeMask(getContext(), path, totalMatrix,
+                                                 static_cast<int>(width), static_cast<int>(height));
   drawMask(quad, maskTexture.get(), shader);
 }
 
@@ -241,6 +275,18 @@ void GLCanvas::drawMask(Rect quad, const Texture* mask, const Shader* shader) {
 
 void GLCanvas::drawGlyphs(const GlyphID glyphIDs[], const Point positions[], size_t glyphCount,
                           const Font& font, const Paint& paint) {
+  std::vector<GlyphID> missedGlyphIDs = {};
+  std::vector<Point> missedPositions = {};
+  if (drawAtlasGlyphs(glyphIDs, positions, glyphCount, font, paint, &missedGlyphIDs,
+                      &missedPositions)) {
+    if (missedGlyphIDs.empty()) {
+      return;
+    }
+    // Falls back to the slow path for the glyphs that the atlas can not hold.
+    glyphIDs = missedGlyphIDs.data();
+    positions = missedPositions.data();
+    glyphCount = missedGlyphIDs.size();
+  }
   auto textBlob = TextBlob::MakeFrom(glyphIDs, positions, glyphCount, font);
   if (textBlob == nullptr) {
     return;
@@ -259,6 +305,94 @@ void GLCanvas::drawGlyphs(const GlyphID glyphIDs[], const Point positions[], siz
   drawMaskGlyphs(textBlob.get(), paint);
 }
 
+struct AtlasTextBatch {
+  const Texture* texture = nullptr;
+  std::vector<Rect> deviceRects = {};
+  std::vector<Rect> atlasRects = {};
+};
+
+bool GLCanvas::drawAtlasGlyphs(const GlyphID glyphIDs[], const Point positions[],
+                               size_t glyphCount, const Font& font, const Paint& paint,
+                               std::vector<GlyphID>* missedGlyphIDs,
+                               std::vector<Point>* missedPositions) {
+  // Glyphs in the atlas are rasterized upright at device scale, so only uniform scales and
+  // translations can be drawn from it.
+  auto& matrix = globalPaint.matrix;
+  if (paint.getStyle() != PaintStyle::Fill || matrix.getSkewX() != 0 || matrix.getSkewY() != 0 ||
+      matrix.getScaleX() != matrix.getScaleY() || matrix.getScaleX() <= 0) {
+    return false;
+  }
+  if (!GlyphAtlas::IsEnabled()) {
+    return false;
+  }
+  auto scaleFont = font.makeWithSize(font.getSize() * matrix.getScaleX());
+  if (scaleFont.getSize() > GlyphAtlas::MAX_GLYPH_SIZE) {
+    return false;
+  }
+  auto colorGlyph = font.getTypeface()->hasColor();
+  auto atlas = getContext()->getGlyphAtlas();
+  atlas->beginBatch();
+  std::vector<AtlasTextBatch> batches = {};
+  for (size_t i = 0; i < glyphCount; i++) {
+    auto devicePosition = Point::Zero();
+    matrix.mapXY(positions[i].x, positions[i].y, &devicePosition);
+    AtlasGlyph glyph = {};
+    if (!atlas->getGlyph(scaleFont, glyphIDs[i], devicePosition, &glyph)) {
+      missedGlyphIDs->push_back(glyphIDs[i]);
+      missedPositions->push_back(positions[i]);
+      continue;
+    }
+    if (glyph.texture == nullptr) {
+      continue;
+    }
+    auto batch = std::find_if(batches.begin(), batches.end(), [&](const AtlasTextBatch& item) {
+      return item.texture == glyph.texture;
+    });
+    if (batch == batches.end()) {
+      batch = batches.insert(batches.end(), AtlasTextBatch());
+      batch->texture = glyph.texture;
+    }
+    batch->deviceRects.push_back(glyph.deviceRect);
+    batch->atlasRects.push_back(glyph.atlasRect);
+  }
+  auto shader = Shader::MakeColorShader(paint.getColor(), paint.getAlpha());
+  save();
+  resetMatrix();
+  if (colorGlyph) {
+    concatAlpha(paint.getAlpha());
+  }
+  for (auto& batch : batches) {
+    auto scale = batch.texture->getTextureCoord(1, 1) - batch.texture->getTextureCoord(0, 0);
+    auto texCoordMatrix = Matrix::MakeScale(scale.x, scale.y);
+    for (size_t start = 0; start < batch.deviceRects.size();
+         start += GLAtlasTextOp::MAX_NUM_GLYPHS) {
+      auto end = std::min(start + GLAtlasTextOp::MAX_NUM_GLYPHS, batch.deviceRects.size());
+      std::vector<Rect> deviceRects(batch.deviceRects.begin() + start,
+                                    batch.deviceRects.begin() + end);
+      std::vector<Rect> atlasRects(batch.atlasRects.begin() + start,
+                                   batch.atlasRects.begin() + end);
+      auto bounds = Rect::MakeEmpty();
+      for (auto& rect : deviceRects) {
+        bounds.join(rect);
+      }
+      if (clipLocalQuad(bounds, nullptr).isEmpty()) {
+        continue;
+      }
+      auto op = GLAtlasTextOp::Make(std::move(deviceRects), std::move(atlasRects));
+      if (colorGlyph) {
+        draw(bounds, bounds, std::move(op),
+             TextureFragmentProcessor::Make(batch.texture, nullptr, texCoordMatrix));
+      } else {
+        auto args = FPArgs(getContext(), Matrix::I());
+        draw(bounds, bounds, std::move(op), shader->asFragmentProcessor(args),
+             TextureMaskFragmentProcessor::MakeUseLocalCoord(batch.texture, texCoordMatrix));
+      }
+    }
+  }
+  restore();
+  return true;
+}
+
 void GLCanvas::drawColorGlyphs(const GlyphID glyphIDs[], const Point positions[], size_t glyphCount,
                                const Font& font, const Paint& paint) {
   auto scaleX = globalPaint.matrix.getScaleX();
@@ -339,6 +473,12 @@ Enum GLCanvas::hasComplexPaint(const Rect& drawingBounds) const {
   return result;
 }
 
+void GLCanvas::flush() {
+  if (_drawer) {
+    _drawer->flush();
+  }
+}
+
 GLDrawer* GLCanvas::getDrawer() {
   if (_drawer == nullptr) {
     _drawer = GLDrawer::Make(getContext());
@@ -395,7 +535,13 @@ void GLCanvas::draw(const Rect& localQuad, const Rect& deviceQuad, std::unique_p
   args.blendMode = globalPaint.blendMode;
   args.viewMatrix = getViewMatrix();
   args.renderTarget = renderTarget.get();
-  args.renderTargetTexture = surface->getTexture();
+  if (BlendAsCoeff(args.blendMode)) {
+    // GLSurface::getTexture() flushes the deferred draws of this canvas, which is only required
+    // when the destination color is read.
+    args.renderTargetTexture = static_cast<GLSurface*>(surface)->texture;
+  } else {
+    args.renderTargetTexture = surface->getTexture();
+  }
   args.aa = aaType;
   args.rectToDraw = localQuad;
   drawer->draw(std::move(args), std::move(op));
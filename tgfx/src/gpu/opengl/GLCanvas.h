@@ -29,7 +29,10 @@ class GLCanvas : public Canvas {
  public:
   explicit GLCanvas(Surface* surface);
 
+  ~GLCanvas() override;
+
   void clear() override;
+  void clearRect(const Rect& rect) override;
   void drawTexture(const Texture* texture, const Texture* mask, bool inverted) override;
   void drawTexture(const Texture* texture, const RGBAAALayout* layout) override;
   void drawPath(const Path& path, Color color) override;
@@ -38,6 +41,7 @@ class GLCanvas : public Canvas {
                   const Font& font, const Paint& paint) override;
   Enum hasComplexPaint(const Rect& drawingBounds) const override;
   void drawPath(const Path& path, const Shader* shader);
+  void flush() override;
 
  protected:
   void onSave() override {
@@ -51,6 +55,8 @@ class GLCanvas : public Canvas {
 
  private:
   std::shared_ptr<Surface> _clipSurface = nullptr;
+  // The ID of the clip whose coverage is currently drawn on the clip surface.
+  uint32_t clipSurfaceID = 0;
   std::shared_ptr<GLDrawer> _drawer = nullptr;
 
   GLDrawer* getDrawer();
@@ -73,6 +79,10 @@ class GLCanvas : public Canvas {
 
   void drawMaskGlyphs(TextBlob* textBlob, const Paint& paint);
 
+  bool drawAtlasGlyphs(const GlyphID glyphIDs[], const Point positions[], size_t glyphCount,
+                       const Font& font, const Paint& paint, std::vector<GlyphID>* missedGlyphIDs,
+                       std::vector<Point>* missedPositions);
+
   void draw(const Rect& localQuad, const Rect& deviceQuad, std::unique_ptr<GLDrawOp> op,
             std::unique_ptr<FragmentProcessor> color,
             std::unique_ptr<FragmentProcessor> mask = nullptr, bool aa = false);
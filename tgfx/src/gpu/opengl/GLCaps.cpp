@@ -179,6 +179,12 @@ GLCaps::GLCaps(const GLInfo& info) {
   }
   info.getIntegerv(GL::MAX_TEXTURE_SIZE, &maxTextureSize);
   info.getIntegerv(GL::MAX_TEXTURE_IMAGE_UNITS, &maxFragmentSamplers);
+  if (programBinarySupport) {
+    // Some drivers expose the entry points but do not support any binary format.
+    int binaryFormats = 0;
+    info.getIntegerv(GL::NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+    programBinarySupport = binaryFormats > 0;
+  }
   initFSAASupport(info);
   initConfigMap(info);
 }
@@ -227,6 +233,8 @@ void GLCaps::initGLSupport(const GLInfo& info) {
                           info.hasExtension("GL_NV_texture_barrier");
   textureSwizzleSupport = version >= GL_VER(3, 3) || info.hasExtension("GL_ARB_texture_swizzle");
   semaphoreSupport = version >= GL_VER(3, 2) || info.hasExtension("GL_ARB_sync");
+  pixelBufferObjectSupport = version >= GL_VER(3, 0);
+  programBinarySupport = version >= GL_VER(4, 1) || info.hasExtension("GL_ARB_get_program_binary");
 }
 
 void GLCaps::initGLESSupport(const GLInfo& info) {
@@ -258,6 +266,8 @@ void GLCaps::initGLESSupport(const GLInfo& info) {
     frameBufferFetchRequiresEnablePerSample = true;
   }
   semaphoreSupport = version >= GL_VER(3, 0) || info.hasExtension("GL_APPLE_sync");
+  pixelBufferObjectSupport = version >= GL_VER(3, 0);
+  programBinarySupport = version >= GL_VER(3, 0) || info.hasExtension("GL_OES_get_program_binary");
 }
 
 void GLCaps::initWebGLSupport(const GLInfo& info) {
@@ -270,6 +280,10 @@ void GLCaps::initWebGLSupport(const GLInfo& info) {
   multisampleDisableSupport = false;  // no WebGL support
   textureBarrierSupport = false;
   semaphoreSupport = version >= GL_VER(2, 0);
+  // WebGL can not map buffers to the CPU.
+  pixelBufferObjectSupport = false;
+  // WebGL does not expose program binaries.
+  programBinarySupport = false;
 }
 
 void GLCaps::initConfigMap(const GLInfo& info) {
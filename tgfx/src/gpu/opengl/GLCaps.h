@@ -128,6 +128,14 @@ class GLCaps : public Caps {
   int maxFragmentSamplers = kMaxSaneSamplers;
   bool textureSwizzleSupport = false;
   bool semaphoreSupport = false;
+  /**
+   * Whether pixels can be read into a pixel pack buffer and mapped to the CPU later.
+   */
+  bool pixelBufferObjectSupport = false;
+  /**
+   * Whether linked programs can be saved as driver binaries and loaded back without recompiling.
+   */
+  bool programBinarySupport = false;
 
   explicit GLCaps(const GLInfo& info);
 
@@ -112,6 +112,7 @@ static constexpr unsigned DRAW_INDIRECT_BUFFER_BINDING = 0x8F43;
 static constexpr unsigned VERTEX_ARRAY_BINDING = 0x85B5;
 static constexpr unsigned PIXEL_PACK_BUFFER = 0x88EB;
 static constexpr unsigned PIXEL_UNPACK_BUFFER = 0x88EC;
+static constexpr unsigned PIXEL_PACK_BUFFER_BINDING = 0x88ED;
 
 static constexpr unsigned PIXEL_UNPACK_TRANSFER_BUFFER_CHROMIUM = 0x78EC;
 static constexpr unsigned PIXEL_PACK_TRANSFER_BUFFER_CHROMIUM = 0x78ED;
@@ -807,7 +808,9 @@ static constexpr unsigned SHADER_COMPILER = 0x8DFA;
 static constexpr unsigned NUM_SHADER_BINARY_FORMATS = 0x8DF9;
 
 // Program Binary
+static constexpr unsigned PROGRAM_BINARY_LENGTH = 0x8741;
 static constexpr unsigned NUM_PROGRAM_BINARY_FORMATS = 0x87FE;
+static constexpr unsigned PROGRAM_BINARY_FORMATS = 0x87FF;
 
 // Shader Precision-Specified Types
 static constexpr unsigned LOW_FLOAT = 0x8DF0;
@@ -85,6 +85,7 @@ bool GLDrawer::init(Context* context) {
 }
 
 void GLDrawer::onRelease(Context* context) {
+  discard();
   auto gl = GLContext::Unwrap(context);
   if (vertexArray > 0) {
     gl->deleteVertexArrays(1, &vertexArray);
@@ -163,10 +164,79 @@ static void UpdateBlend(const GLInterface* gl, bool blendAsCoeff, unsigned first
   }
 }
 
-void GLDrawer::draw(DrawArgs args, std::unique_ptr<GLDrawOp> op) const {
+static bool CanDefer(const DrawArgs& args) {
+  if (!BlendAsCoeff(args.blendMode) || !args.masks.empty()) {
+    return false;
+  }
+  // Fragment processors only keep raw pointers to their textures, which may be released or
+  // overwritten before a deferred op is flushed.
+  for (const auto& color : args.colors) {
+    FragmentProcessor::Iter iter(color.get());
+    while (const auto* processor = iter.next()) {
+      if (processor->numTextureSamplers() > 0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static bool CanCombine(const DrawArgs& first, const DrawArgs& second) {
+  if (first.context != second.context || first.blendMode != second.blendMode ||
+      first.renderTarget != second.renderTarget ||
+      first.renderTargetTexture != second.renderTargetTexture ||
+      first.scissorRect != second.scissorRect || first.aa != second.aa ||
+      !first.masks.empty() || !second.masks.empty() ||
+      first.colors.size() != second.colors.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < first.colors.size(); i++) {
+    if (!first.colors[i]->isEqual(*second.colors[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void GLDrawer::draw(DrawArgs args, std::unique_ptr<GLDrawOp> op) {
   if (!isDrawArgsValid(args) || op == nullptr) {
     return;
   }
+  if (pendingOp != nullptr) {
+    if (pendingOp->name() == op->name() && CanCombine(pendingArgs, args) &&
+        pendingOp->combineIfPossible(pendingArgs, op.get(), args)) {
+      pendingOpCount++;
+      return;
+    }
+    flush();
+  }
+  if (CanDefer(args)) {
+    pendingArgs = std::move(args);
+    pendingOp = std::move(op);
+    pendingOpCount = 1;
+    return;
+  }
+  execute(std::move(args), op.get(), 1);
+}
+
+void GLDrawer::flush() {
+  if (pendingOp == nullptr) {
+    return;
+  }
+  auto args = std::move(pendingArgs);
+  auto op = std::move(pendingOp);
+  auto opCount = pendingOpCount;
+  discard();
+  execute(std::move(args), op.get(), opCount);
+}
+
+void GLDrawer::discard() {
+  pendingArgs = {};
+  pendingOp = nullptr;
+  pendingOpCount = 0;
+}
+
+void GLDrawer::execute(DrawArgs args, GLDrawOp* op, size_t opCount) {
   auto numColorProcessors = args.colors.size();
   std::vector<std::unique_ptr<FragmentProcessor>> fragmentProcessors = {};
   fragmentProcessors.resize(numColorProcessors + args.masks.size());
@@ -233,6 +303,7 @@ void GLDrawer::draw(DrawArgs args, std::unique_ptr<GLDrawOp> op) const {
   if (vertexArray > 0) {
     gl->bindVertexArray(0);
   }
+  args.context->recordDrawCall(opCount);
   CheckGLError(gl);
 }
 }  // namespace pag
@@ -43,18 +43,43 @@ class GLDrawOp {
  public:
   virtual ~GLDrawOp() = default;
 
+  virtual std::string name() const = 0;
+
   virtual std::unique_ptr<GeometryProcessor> getGeometryProcessor(const DrawArgs& args) = 0;
 
   virtual std::vector<float> vertices(const DrawArgs& args) = 0;
 
   virtual std::shared_ptr<GLBuffer> getIndexBuffer(const DrawArgs& args) = 0;
+
+  /**
+   * Tries to append the geometry of the specified op to this one, so they can be drawn with a
+   * single draw call. Both ops have the same name and their draw args have been verified to share
+   * the same pipeline. Returns false if the op can not be merged.
+   */
+  virtual bool combineIfPossible(const DrawArgs&, GLDrawOp*, const DrawArgs&) {
+    return false;
+  }
 };
 
 class GLDrawer : public Resource {
  public:
   static std::shared_ptr<GLDrawer> Make(Context* context);
 
-  void draw(DrawArgs args, std::unique_ptr<GLDrawOp> op) const;
+  /**
+   * Draws the op with the specified args. Ops that don't sample any texture are deferred and merged
+   * with the following compatible ones, call flush() to submit them to the GPU.
+   */
+  void draw(DrawArgs args, std::unique_ptr<GLDrawOp> op);
+
+  /**
+   * Submits the deferred op to the GPU, if there is one.
+   */
+  void flush();
+
+  /**
+   * Drops the deferred op without drawing it.
+   */
+  void discard();
 
  protected:
   void computeRecycleKey(BytesKey*) const override;
@@ -64,7 +89,12 @@ class GLDrawer : public Resource {
 
   void onRelease(Context* context) override;
 
+  void execute(DrawArgs args, GLDrawOp* op, size_t opCount);
+
   unsigned vertexArray = 0;
   unsigned vertexBuffer = 0;
+  DrawArgs pendingArgs = {};
+  std::unique_ptr<GLDrawOp> pendingOp = nullptr;
+  size_t pendingOpCount = 0;
 };
 }  // namespace pag
@@ -22,16 +22,17 @@
 
 namespace pag {
 std::unique_ptr<GeometryProcessor> GLFillRectOp::getGeometryProcessor(const DrawArgs& args) {
-  return QuadPerEdgeAAGeometryProcessor::Make(
-      args.renderTarget->width(), args.renderTarget->height(), args.viewMatrix, args.aa);
+  // The vertices of merged rects are already mapped to the device space.
+  auto viewMatrix = rects.empty() ? args.viewMatrix : Matrix::I();
+  return QuadPerEdgeAAGeometryProcessor::Make(args.renderTarget->width(),
+                                              args.renderTarget->height(), viewMatrix, args.aa);
 }
 
-std::vector<float> GLFillRectOp::vertices(const DrawArgs& args) {
-  auto bounds = args.rectToDraw;
+static std::vector<float> RectVertices(const Rect& bounds, const Matrix& viewMatrix, AAType aa) {
   auto normalBounds = Rect::MakeLTRB(0, 0, 1, 1);
   // Vertex coordinates are arranged in a 2D pixel coordinate system, and textures are arranged
   // according to a texture coordinate system (0 - 1).
-  if (args.aa != AAType::Coverage) {
+  if (aa != AAType::Coverage) {
     return {
         bounds.right, bounds.bottom, normalBounds.right, normalBounds.bottom,
         bounds.right, bounds.top,    normalBounds.right, normalBounds.top,
@@ -39,8 +40,8 @@ std::vector<float> GLFillRectOp::vertices(const DrawArgs& args) {
         bounds.left,  bounds.top,    normalBounds.left,  normalBounds.top,
     };
   }
-  auto scale = sqrtf(args.viewMatrix.getScaleX() * args.viewMatrix.getScaleX() +
-                     args.viewMatrix.getSkewY() * args.viewMatrix.getSkewY());
+  auto scale = sqrtf(viewMatrix.getScaleX() * viewMatrix.getScaleX() +
+                     viewMatrix.getSkewY() * viewMatrix.getSkewY());
   // we want the new edge to be .5px away from the old line.
   auto padding = 0.5f / scale;
   auto insetBounds = bounds.makeInset(padding, padding);
@@ -61,6 +62,46 @@ std::vector<float> GLFillRectOp::vertices(const DrawArgs& args) {
   };
 }
 
+std::vector<float> GLFillRectOp::vertices(const DrawArgs& args) {
+  if (rects.empty()) {
+    return RectVertices(args.rectToDraw, args.viewMatrix, args.aa);
+  }
+  size_t stride = args.aa == AAType::Coverage ? 5 : 4;
+  std::vector<float> vertices = {};
+  vertices.reserve(rects.size() * stride * (args.aa == AAType::Coverage ? 8 : 4));
+  for (size_t i = 0; i < rects.size(); i++) {
+    auto quad = RectVertices(rects[i], viewMatrices[i], args.aa);
+    for (size_t j = 0; j < quad.size(); j += stride) {
+      auto point = viewMatrices[i].mapXY(quad[j], quad[j + 1]);
+      quad[j] = point.x;
+      quad[j + 1] = point.y;
+    }
+    vertices.insert(vertices.end(), quad.begin(), quad.end());
+  }
+  return vertices;
+}
+
+bool GLFillRectOp::combineIfPossible(const DrawArgs& args, GLDrawOp* op, const DrawArgs& opArgs) {
+  auto that = static_cast<GLFillRectOp*>(op);
+  auto count = rects.empty() ? 1 : rects.size();
+  auto thatCount = that->rects.empty() ? 1 : that->rects.size();
+  if (count + thatCount > MAX_NUM_RECTS) {
+    return false;
+  }
+  if (rects.empty()) {
+    rects.push_back(args.rectToDraw);
+    viewMatrices.push_back(args.viewMatrix);
+  }
+  if (that->rects.empty()) {
+    rects.push_back(opArgs.rectToDraw);
+    viewMatrices.push_back(opArgs.viewMatrix);
+  } else {
+    rects.insert(rects.end(), that->rects.begin(), that->rects.end());
+    viewMatrices.insert(viewMatrices.end(), that->viewMatrices.begin(), that->viewMatrices.end());
+  }
+  return true;
+}
+
 std::unique_ptr<GLFillRectOp> GLFillRectOp::Make() {
   return std::make_unique<GLFillRectOp>();
 }
@@ -77,7 +118,40 @@ static constexpr uint16_t gFillAARectIdx[] = {
 };
 // clang-format on
 
+static constexpr size_t kVerticesPerAAFillRect = 8;
+static constexpr size_t kIndicesPerFillRect = 6;
+
+// clang-format off
+static constexpr uint16_t gFillRectIdx[] = {
+  0, 1, 2, 2, 1, 3,
+};
+// clang-format on
+
+/**
+ * Returns the index pattern repeated for MAX_NUM_RECTS rects. The data is never released, so its
+ * address can be used to look up the recycled index buffers.
+ */
+static const uint16_t* GetRepeatedIndices(const uint16_t pattern[], size_t patternSize,
+                                          size_t vertexCount) {
+  auto buffer = new uint16_t[GLFillRectOp::MAX_NUM_RECTS * patternSize];
+  for (size_t i = 0; i < GLFillRectOp::MAX_NUM_RECTS; i++) {
+    for (size_t j = 0; j < patternSize; j++) {
+      buffer[i * patternSize + j] = static_cast<uint16_t>(pattern[j] + i * vertexCount);
+    }
+  }
+  return buffer;
+}
+
 std::shared_ptr<GLBuffer> GLFillRectOp::getIndexBuffer(const DrawArgs& args) {
+  if (!rects.empty()) {
+    if (args.aa == AAType::Coverage) {
+      static const auto aaIndices =
+          GetRepeatedIndices(gFillAARectIdx, kIndicesPerAAFillRect, kVerticesPerAAFillRect);
+      return GLBuffer::Make(args.context, aaIndices, rects.size() * kIndicesPerAAFillRect);
+    }
+    static const auto indices = GetRepeatedIndices(gFillRectIdx, kIndicesPerFillRect, 4);
+    return GLBuffer::Make(args.context, indices, rects.size() * kIndicesPerFillRect);
+  }
   if (args.aa == AAType::Coverage) {
     return GLBuffer::Make(args.context, gFillAARectIdx, kIndicesPerAAFillRect);
   }
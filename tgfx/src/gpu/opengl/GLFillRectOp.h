@@ -25,12 +25,29 @@
 namespace pag {
 class GLFillRectOp : public GLDrawOp {
  public:
+  /**
+   * The maximum number of rects that one op can draw after merging.
+   */
+  static constexpr size_t MAX_NUM_RECTS = 1024;
+
   static std::unique_ptr<GLFillRectOp> Make();
 
+  std::string name() const override {
+    return "GLFillRectOp";
+  }
+
   std::unique_ptr<GeometryProcessor> getGeometryProcessor(const DrawArgs& args) override;
 
   std::vector<float> vertices(const DrawArgs& args) override;
 
   std::shared_ptr<GLBuffer> getIndexBuffer(const DrawArgs& args) override;
+
+  bool combineIfPossible(const DrawArgs& args, GLDrawOp* op, const DrawArgs& opArgs) override;
+
+ private:
+  // Both are empty unless other ops have been merged into this one, then they hold the local
+  // rect and the view matrix of every merged op, including this one.
+  std::vector<Rect> rects = {};
+  std::vector<Matrix> viewMatrices = {};
 };
 }  // namespace pag
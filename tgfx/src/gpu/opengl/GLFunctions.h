@@ -50,6 +50,9 @@ using GLBufferData = void GL_FUNCTION_TYPE(unsigned target, GLsizeiptr size, con
 using GLCheckFramebufferStatus = unsigned GL_FUNCTION_TYPE(unsigned target);
 using GLClear = void GL_FUNCTION_TYPE(unsigned mask);
 using GLClearColor = void GL_FUNCTION_TYPE(float red, float green, float blue, float alpha);
+using GLClearStencil = void GL_FUNCTION_TYPE(int s);
+using GLColorMask = void GL_FUNCTION_TYPE(unsigned char red, unsigned char green,
+                                          unsigned char blue, unsigned char alpha);
 using GLCompileShader = void GL_FUNCTION_TYPE(unsigned shader);
 using GLCopyTexSubImage2D = void GL_FUNCTION_TYPE(unsigned target, int level, int xoffset,
                                                   int yoffset, int x, int y, int width, int height);
@@ -92,6 +95,8 @@ using GLGenTextures = void GL_FUNCTION_TYPE(int n, unsigned* textures);
 using GLGetError = unsigned GL_FUNCTION_TYPE();
 using GLGetIntegerv = void GL_FUNCTION_TYPE(unsigned pname, int* params);
 using GLGetBooleanv = void GL_FUNCTION_TYPE(unsigned pname, unsigned char* data);
+using GLGetProgramBinary = void GL_FUNCTION_TYPE(unsigned program, int bufSize, int* length,
+                                                 unsigned* binaryFormat, void* binary);
 using GLGetProgramInfoLog = void GL_FUNCTION_TYPE(unsigned program, int bufsize, int* length,
                                                   char* infolog);
 using GLGetProgramiv = void GL_FUNCTION_TYPE(unsigned program, unsigned pname, int* params);
@@ -108,7 +113,11 @@ using GLGetVertexAttribPointerv = void GL_FUNCTION_TYPE(unsigned index, unsigned
 using GLGetAttribLocation = int GL_FUNCTION_TYPE(unsigned program, const char* name);
 using GLGetUniformLocation = int GL_FUNCTION_TYPE(unsigned program, const char* name);
 using GLLinkProgram = void GL_FUNCTION_TYPE(unsigned program);
+using GLMapBufferRange = void* GL_FUNCTION_TYPE(unsigned target, GLintptr offset,
+                                                GLsizeiptr length, unsigned access);
 using GLPixelStorei = void GL_FUNCTION_TYPE(unsigned pname, int param);
+using GLProgramBinary = void GL_FUNCTION_TYPE(unsigned program, unsigned binaryFormat,
+                                              const void* binary, int length);
 using GLReadPixels = void GL_FUNCTION_TYPE(int x, int y, int width, int height, unsigned format,
                                            unsigned type, void* pixels);
 using GLRenderbufferStorage = void GL_FUNCTION_TYPE(unsigned target, unsigned internalformat,
@@ -129,6 +138,14 @@ using GLBlitFramebuffer = void GL_FUNCTION_TYPE(int srcX0, int srcY0, int srcX1,
 using GLScissor = void GL_FUNCTION_TYPE(int x, int y, int width, int height);
 using GLShaderSource = void GL_FUNCTION_TYPE(unsigned shader, int count, const char* const* str,
                                              const int* length);
+using GLStencilFunc = void GL_FUNCTION_TYPE(unsigned func, int ref, unsigned mask);
+using GLStencilFuncSeparate = void GL_FUNCTION_TYPE(unsigned face, unsigned func, int ref,
+                                                    unsigned mask);
+using GLStencilMask = void GL_FUNCTION_TYPE(unsigned mask);
+using GLStencilMaskSeparate = void GL_FUNCTION_TYPE(unsigned face, unsigned mask);
+using GLStencilOp = void GL_FUNCTION_TYPE(unsigned fail, unsigned zfail, unsigned zpass);
+using GLStencilOpSeparate = void GL_FUNCTION_TYPE(unsigned face, unsigned fail, unsigned zfail,
+                                                  unsigned zpass);
 using GLTexImage2D = void GL_FUNCTION_TYPE(unsigned target, int level, int internalformat,
                                            int width, int height, int border, unsigned format,
                                            unsigned type, const void* pixels);
@@ -144,6 +161,7 @@ using GLUniform3f = void GL_FUNCTION_TYPE(int location, float v0, float v1, floa
 using GLUniform4fv = void GL_FUNCTION_TYPE(int location, int count, const float* v);
 using GLUniformMatrix3fv = void GL_FUNCTION_TYPE(int location, int count, unsigned char transpose,
                                                  const float* value);
+using GLUnmapBuffer = unsigned char GL_FUNCTION_TYPE(unsigned target);
 using GLUseProgram = void GL_FUNCTION_TYPE(unsigned program);
 using GLVertexAttribPointer = void GL_FUNCTION_TYPE(unsigned indx, int size, unsigned type,
                                                     unsigned char normalized, int stride,
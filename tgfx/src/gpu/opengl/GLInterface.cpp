@@ -95,6 +95,12 @@ std::unique_ptr<const GLInterface> GLInterface::HookWithState(const GLInterface*
   Hook(useProgram);
   Hook(vertexAttribPointer);
   Hook(depthMask);
+  Hook(clearStencil);
+  Hook(colorMask);
+  Hook(stencilFunc);
+  Hook(stencilMask);
+  Hook(stencilOp);
+  Hook(stencilOpSeparate);
   if (gl->caps->vertexArrayObjectSupport) {
     Hook(bindVertexArray);
   }
@@ -141,6 +147,9 @@ std::unique_ptr<const GLInterface> GLInterface::MakeNativeInterface(const GLProc
   interface->bufferData = reinterpret_cast<GLBufferData*>(getter->getProcAddress("glBufferData"));
   interface->clear = reinterpret_cast<GLClear*>(getter->getProcAddress("glClear"));
   interface->clearColor = reinterpret_cast<GLClearColor*>(getter->getProcAddress("glClearColor"));
+  interface->clearStencil =
+      reinterpret_cast<GLClearStencil*>(getter->getProcAddress("glClearStencil"));
+  interface->colorMask = reinterpret_cast<GLColorMask*>(getter->getProcAddress("glColorMask"));
   interface->compileShader =
       reinterpret_cast<GLCompileShader*>(getter->getProcAddress("glCompileShader"));
   interface->copyTexSubImage2D =
@@ -220,6 +229,17 @@ std::unique_ptr<const GLInterface> GLInterface::MakeNativeInterface(const GLProc
   interface->scissor = reinterpret_cast<GLScissor*>(getter->getProcAddress("glScissor"));
   interface->shaderSource =
       reinterpret_cast<GLShaderSource*>(getter->getProcAddress("glShaderSource"));
+  interface->stencilFunc =
+      reinterpret_cast<GLStencilFunc*>(getter->getProcAddress("glStencilFunc"));
+  interface->stencilFuncSeparate =
+      reinterpret_cast<GLStencilFuncSeparate*>(getter->getProcAddress("glStencilFuncSeparate"));
+  interface->stencilMask =
+      reinterpret_cast<GLStencilMask*>(getter->getProcAddress("glStencilMask"));
+  interface->stencilMaskSeparate =
+      reinterpret_cast<GLStencilMaskSeparate*>(getter->getProcAddress("glStencilMaskSeparate"));
+  interface->stencilOp = reinterpret_cast<GLStencilOp*>(getter->getProcAddress("glStencilOp"));
+  interface->stencilOpSeparate =
+      reinterpret_cast<GLStencilOpSeparate*>(getter->getProcAddress("glStencilOpSeparate"));
   interface->texImage2D = reinterpret_cast<GLTexImage2D*>(getter->getProcAddress("glTexImage2D"));
   interface->texParameteri =
       reinterpret_cast<GLTexParameteri*>(getter->getProcAddress("glTexParameteri"));
@@ -51,6 +51,8 @@ class GLInterface {
   GLFunction<GLCheckFramebufferStatus> checkFramebufferStatus;
   GLFunction<GLClear> clear;
   GLFunction<GLClearColor> clearColor;
+  GLFunction<GLClearStencil> clearStencil;
+  GLFunction<GLColorMask> colorMask;
   GLFunction<GLCompileShader> compileShader;
   GLFunction<GLCopyTexSubImage2D> copyTexSubImage2D;
   GLFunction<GLCreateProgram> createProgram;
@@ -83,6 +85,7 @@ class GLInterface {
   GLFunction<GLGetError> getError;
   GLFunction<GLGetIntegerv> getIntegerv;
   GLFunction<GLGetBooleanv> getBooleanv;
+  GLFunction<GLGetProgramBinary> getProgramBinary;
   GLFunction<GLGetProgramInfoLog> getProgramInfoLog;
   GLFunction<GLGetProgramiv> getProgramiv;
   GLFunction<GLGetRenderbufferParameteriv> getRenderbufferParameteriv;
@@ -94,7 +97,9 @@ class GLInterface {
   GLFunction<GLGetAttribLocation> getAttribLocation;
   GLFunction<GLGetUniformLocation> getUniformLocation;
   GLFunction<GLLinkProgram> linkProgram;
+  GLFunction<GLMapBufferRange> mapBufferRange;
   GLFunction<GLPixelStorei> pixelStorei;
+  GLFunction<GLProgramBinary> programBinary;
   GLFunction<GLReadPixels> readPixels;
   GLFunction<GLRenderbufferStorage> renderbufferStorage;
   GLFunction<GLRenderbufferStorageMultisample> renderbufferStorageMultisample;
@@ -104,6 +109,12 @@ class GLInterface {
   GLFunction<GLBlitFramebuffer> blitFramebuffer;
   GLFunction<GLScissor> scissor;
   GLFunction<GLShaderSource> shaderSource;
+  GLFunction<GLStencilFunc> stencilFunc;
+  GLFunction<GLStencilFuncSeparate> stencilFuncSeparate;
+  GLFunction<GLStencilMask> stencilMask;
+  GLFunction<GLStencilMaskSeparate> stencilMaskSeparate;
+  GLFunction<GLStencilOp> stencilOp;
+  GLFunction<GLStencilOpSeparate> stencilOpSeparate;
   GLFunction<GLTexImage2D> texImage2D;
   GLFunction<GLTexParameteri> texParameteri;
   GLFunction<GLTexParameteriv> texParameteriv;
@@ -114,6 +125,7 @@ class GLInterface {
   GLFunction<GLUniform3f> uniform3f;
   GLFunction<GLUniform4fv> uniform4fv;
   GLFunction<GLUniformMatrix3fv> uniformMatrix3fv;
+  GLFunction<GLUnmapBuffer> unmapBuffer;
   GLFunction<GLUseProgram> useProgram;
   GLFunction<GLVertexAttribPointer> vertexAttribPointer;
   GLFunction<GLViewport> viewport;
@@ -0,0 +1,429 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GLPathTessellator.h"
+#include <atomic>
+#include "GLContext.h"
+#include "GLRenderTarget.h"
+#include "GLUtil.h"
+#include "base/utils/UniqueID.h"
+#include "gpu/Program.h"
+#include "raster/Mask.h"
+
+namespace pag {
+// Paths smaller than this area are rasterized on the CPU, which is cheaper than the fixed cost of
+// the GPU passes.
+static constexpr int MIN_TESSELLATION_AREA = 64 * 64;
+// Paths larger than this area are always tessellated on the GPU.
+static constexpr int MAX_RASTERIZATION_AREA = 256 * 256;
+// Paths in between are tessellated on the GPU if they have at least this many verbs.
+static constexpr int MIN_TESSELLATION_VERBS = 32;
+static constexpr int TESSELLATION_SAMPLE_COUNT = 4;
+// The maximum distance in pixels between a flattened curve and the curve itself.
+static constexpr float FLATTEN_TOLERANCE = 0.25f;
+static constexpr int MAX_CURVE_SEGMENTS = 256;
+
+static std::atomic_bool tessellationEnabled = {false};
+
+/**
+ * The program of the stencil passes. It also owns the vertex buffer, the vertex array and the
+ * stencil buffer shared by all masks of the context, so they are not created again for each mask.
+ */
+class PathStencilProgram : public Program {
+ public:
+  explicit PathStencilProgram(unsigned programID) : programID(programID) {
+  }
+
+  void onRelease(Context* context) override {
+    auto gl = GLContext::Unwrap(context);
+    if (programID > 0) {
+      gl->deleteProgram(programID);
+      programID = 0;
+    }
+    if (vertexArray > 0) {
+      gl->deleteVertexArrays(1, &vertexArray);
+      vertexArray = 0;
+    }
+    if (vertexBuffer > 0) {
+      gl->deleteBuffers(1, &vertexBuffer);
+      vertexBuffer = 0;
+    }
+    if (stencilBuffer > 0) {
+      gl->deleteRenderbuffers(1, &stencilBuffer);
+      stencilBuffer = 0;
+    }
+  }
+
+  unsigned stencilBufferID() const {
+    return stencilBuffer;
+  }
+
+  /**
+   * Binds the stencil buffer and makes sure it can be attached to a render target of the specified
+   * size and sample count. The storage is only allocated again if it doesn't fit. Returns false if
+   * the storage can not be allocated.
+   */
+  bool bindStencilBuffer(const GLInterface* gl, int width, int height, int sampleCount) {
+    if (stencilBuffer == 0) {
+      gl->genRenderbuffers(1, &stencilBuffer);
+      if (stencilBuffer == 0) {
+        return false;
+      }
+    }
+    gl->bindRenderbuffer(GL::RENDERBUFFER, stencilBuffer);
+    // OpenGL ES 2.0 and WebGL require all attachments of a framebuffer to have the same size, the
+    // others allow a larger stencil buffer, which is then reused by the smaller masks.
+    auto caps = gl->caps;
+    auto allowsLarger = caps->standard == GLStandard::GL ||
+                        (caps->standard == GLStandard::GLES && caps->version >= GL_VER(3, 0));
+    auto fits = allowsLarger ? stencilWidth >= width && stencilHeight >= height
+                             : stencilWidth == width && stencilHeight == height;
+    if (fits && stencilSampleCount == sampleCount) {
+      return true;
+    }
+    if (allowsLarger) {
+      width = std::max(width, stencilWidth);
+      height = std::max(height, stencilHeight);
+    }
+    if (!RenderbufferStorageMSAA(gl, sampleCount, GL::STENCIL_INDEX8, width, height)) {
+      stencilWidth = stencilHeight = stencilSampleCount = 0;
+      return false;
+    }
+    stencilWidth = width;
+    stencilHeight = height;
+    stencilSampleCount = sampleCount;
+    return true;
+  }
+
+  unsigned programID = 0;
+  int positionLocation = -1;
+  int transformLocation = -1;
+  unsigned vertexArray = 0;
+  unsigned vertexBuffer = 0;
+
+ private:
+  unsigned stencilBuffer = 0;
+  int stencilWidth = 0;
+  int stencilHeight = 0;
+  int stencilSampleCount = 0;
+};
+
+class PathStencilProgramCreator : public ProgramCreator {
+ public:
+  void computeUniqueKey(Context*, BytesKey* uniqueKey) const override {
+    static const uint32_t Type = UniqueID::Next();
+    uniqueKey->write(Type);
+  }
+
+  std::unique_ptr<Program> createProgram(Context* context) const override {
+    auto gl = GLContext::Unwrap(context);
+    auto isDesktopGL = gl->caps->standard == GLStandard::GL;
+    std::string vertex = isDesktopGL ? "#version 150\nin vec2 aPosition;\n"
+                                     : "#version 100\nattribute vec2 aPosition;\n";
+    vertex +=
+        "uniform vec4 uTransform;\n"
+        "void main() {\n"
+        "  gl_Position = vec4(aPosition * uTransform.xy + uTransform.zw, 0.0, 1.0);\n"
+        "}\n";
+    // Only the stencil and the coverage are written, the color output is a constant.
+    std::string fragment = isDesktopGL ? "#version 150\n"
+                                         "out vec4 fragColor;\n"
+                                         "void main() {\n"
+                                         "  fragColor = vec4(1.0);\n"
+                                         "}\n"
+                                       : "#version 100\n"
+                                         "precision mediump float;\n"
+                                         "void main() {\n"
+                                         "  gl_FragColor = vec4(1.0);\n"
+                                         "}\n";
+    auto programID = CreateProgram(gl, vertex, fragment);
+    if (programID == 0) {
+      return nullptr;
+    }
+    auto program = std::make_unique<PathStencilProgram>(programID);
+    program->positionLocation = gl->getAttribLocation(programID, "aPosition");
+    program->transformLocation = gl->getUniformLocation(programID, "uTransform");
+    gl->genBuffers(1, &program->vertexBuffer);
+    if (program->vertexBuffer == 0) {
+      program->onRelease(context);
+      return nullptr;
+    }
+    if (gl->caps->vertexArrayObjectSupport) {
+      // The vertex layout never changes, so it is recorded in the vertex array once.
+      gl->genVertexArrays(1, &program->vertexArray);
+      gl->bindVertexArray(program->vertexArray);
+      gl->bindBuffer(GL::ARRAY_BUFFER, program->vertexBuffer);
+      auto location = static_cast<unsigned>(program->positionLocation);
+      gl->vertexAttribPointer(location, 2, GL::FLOAT, false, 2 * sizeof(float), nullptr);
+      gl->enableVertexAttribArray(location);
+      gl->bindVertexArray(0);
+      gl->bindBuffer(GL::ARRAY_BUFFER, 0);
+    }
+    return program;
+  }
+};
+
+/**
+ * Flattens the contours of a path into triangle fans around their first points. Overlapping
+ * triangles cancel each other out in the stencil buffer according to the fill type.
+ */
+class FanTessellator {
+ public:
+  explicit FanTessellator(const Matrix& matrix) : matrix(matrix) {
+  }
+
+  std::vector<float> vertices = {};
+
+  static void Iterator(PathVerb verb, const Point points[4], void* info) {
+    auto tessellator = reinterpret_cast<FanTessellator*>(info);
+    switch (verb) {
+      case PathVerb::Move:
+        tessellator->moveTo(points[0]);
+        break;
+      case PathVerb::Line:
+        tessellator->lineTo(points[1]);
+        break;
+      case PathVerb::Quad:
+        tessellator->quadTo(points);
+        break;
+      case PathVerb::Cubic:
+        tessellator->cubicTo(points);
+        break;
+      case PathVerb::Close:
+        break;
+    }
+  }
+
+ private:
+  Matrix matrix = Matrix::I();
+  Point pivot = Point::Zero();
+  Point last = Point::Zero();
+  int contourPoints = 0;
+
+  void moveTo(const Point& point) {
+    pivot = matrix.mapXY(point.x, point.y);
+    last = pivot;
+    contourPoints = 1;
+  }
+
+  void lineTo(const Point& point) {
+    addPoint(matrix.mapXY(point.x, point.y));
+  }
+
+  void quadTo(const Point points[3]) {
+    Point pts[3] = {};
+    matrix.mapPoints(pts, points, 3);
+    // Wang's formula, the number of segments keeps the flattening error below the tolerance.
+    auto dx = pts[0].x - 2 * pts[1].x + pts[2].x;
+    auto dy = pts[0].y - 2 * pts[1].y + pts[2].y;
+    auto segments = SegmentCount(sqrtf(dx * dx + dy * dy) / (4 * FLATTEN_TOLERANCE));
+    for (int i = 1; i <= segments; i++) {
+      auto t = static_cast<float>(i) / static_cast<float>(segments);
+      auto mt = 1 - t;
+      auto a = mt * mt;
+      auto b = 2 * mt * t;
+      auto c = t * t;
+      addPoint({a * pts[0].x + b * pts[1].x + c * pts[2].x,
+                a * pts[0].y + b * pts[1].y + c * pts[2].y});
+    }
+  }
+
+  void cubicTo(const Point points[4]) {
+    Point pts[4] = {};
+    matrix.mapPoints(pts, points, 4);
+    auto dx1 = pts[0].x - 2 * pts[1].x + pts[2].x;
+    auto dy1 = pts[0].y - 2 * pts[1].y + pts[2].y;
+    auto dx2 = pts[1].x - 2 * pts[2].x + pts[3].x;
+    auto dy2 = pts[1].y - 2 * pts[2].y + pts[3].y;
+    auto maxLength = std::max(sqrtf(dx1 * dx1 + dy1 * dy1), sqrtf(dx2 * dx2 + dy2 * dy2));
+    auto segments = SegmentCount(3 * maxLength / (4 * FLATTEN_TOLERANCE));
+    for (int i = 1; i <= segments; i++) {
+      auto t = static_cast<float>(i) / static_cast<float>(segments);
+      auto mt = 1 - t;
+      auto a = mt * mt * mt;
+      auto b = 3 * mt * mt * t;
+      auto c = 3 * mt * t * t;
+      auto d = t * t * t;
+      addPoint({a * pts[0].x + b * pts[1].x + c * pts[2].x + d * pts[3].x,
+                a * pts[0].y + b * pts[1].y + c * pts[2].y + d * pts[3].y});
+    }
+  }
+
+  static int SegmentCount(float squaredSegments) {
+    auto segments = static_cast<int>(ceilf(sqrtf(squaredSegments)));
+    return std::min(std::max(segments, 1), MAX_CURVE_SEGMENTS);
+  }
+
+  void addPoint(const Point& point) {
+    if (contourPoints >= 2) {
+      vertices.insert(vertices.end(), {pivot.x, pivot.y, last.x, last.y, point.x, point.y});
+    }
+    last = point;
+    contourPoints++;
+  }
+};
+
+static bool ShouldTessellate(const Path& path, int width, int height) {
+  if (!tessellationEnabled) {
+    return false;
+  }
+  auto area = width * height;
+  if (area < MIN_TESSELLATION_AREA) {
+    return false;
+  }
+  return area >= MAX_RASTERIZATION_AREA || path.countVerbs() >= MIN_TESSELLATION_VERBS;
+}
+
+std::shared_ptr<Texture> GLPathTessellator::MakeMask(Context* context, const Path& path,
+                                                     const Matrix& matrix, int width,
+                                                     int height) {
+  if (ShouldTessellate(path, width, height)) {
+    auto texture = Tessellate(context, path, matrix, width, height);
+    if (texture != nullptr) {
+      return texture;
+    }
+  }
+  auto mask = Mask::Make(width, height);
+  if (mask == nullptr) {
+    return nullptr;
+  }
+  mask->setMatrix(matrix);
+  mask->fillPath(path);
+  return mask->makeTexture(context);
+}
+
+static void DrawStencilAndCover(const GLInterface* gl, const PathStencilProgram* program,
+                                const std::vector<float>& vertices, PathFillType fillType) {
+  if (program->vertexArray > 0) {
+    gl->bindVertexArray(program->vertexArray);
+  }
+  gl->bindBuffer(GL::ARRAY_BUFFER, program->vertexBuffer);
+  gl->bufferData(GL::ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size()) * sizeof(float),
+                 &vertices[0], GL::STREAM_DRAW);
+  if (program->vertexArray == 0) {
+    auto location = static_cast<unsigned>(program->positionLocation);
+    gl->vertexAttribPointer(location, 2, GL::FLOAT, false, 2 * sizeof(float), nullptr);
+    gl->enableVertexAttribArray(location);
+  }
+  // The last 6 vertices are the cover rect, the others are the triangle fans.
+  auto fanCount = static_cast<int>(vertices.size() / 2) - 6;
+  gl->enable(GL::STENCIL_TEST);
+  gl->colorMask(false, false, false, false);
+  gl->stencilFunc(GL::ALWAYS, 0, 0xFF);
+  auto inverse = fillType == PathFillType::InverseWinding ||
+                 fillType == PathFillType::InverseEvenOdd;
+  if (fillType == PathFillType::EvenOdd || fillType == PathFillType::InverseEvenOdd) {
+    gl->stencilOp(GL::KEEP, GL::KEEP, GL::INVERT);
+  } else {
+    gl->stencilOpSeparate(GL::FRONT, GL::KEEP, GL::KEEP, GL::INCR_WRAP);
+    gl->stencilOpSeparate(GL::BACK, GL::KEEP, GL::KEEP, GL::DECR_WRAP);
+  }
+  if (fanCount > 0) {
+    gl->drawArrays(GL::TRIANGLES, 0, fanCount);
+  }
+  gl->colorMask(true, true, true, true);
+  gl->stencilFunc(inverse ? GL::EQUAL : GL::NOTEQUAL, 0, 0xFF);
+  gl->stencilOp(GL::KEEP, GL::KEEP, GL::KEEP);
+  gl->drawArrays(GL::TRIANGLES, fanCount, 6);
+  gl->disable(GL::STENCIL_TEST);
+  gl->bindBuffer(GL::ARRAY_BUFFER, 0);
+  if (program->vertexArray > 0) {
+    gl->bindVertexArray(0);
+  }
+}
+
+std::shared_ptr<Texture> GLPathTessellator::Tessellate(Context* context, const Path& path,
+                                                       const Matrix& matrix, int width,
+                                                       int height) {
+  if (context == nullptr || width <= 0 || height <= 0) {
+    return nullptr;
+  }
+  auto gl = GLContext::Unwrap(context);
+  if (!gl->stencilOpSeparate) {
+    return nullptr;
+  }
+  auto alphaOnly = gl->caps->textureRedSupport;
+  auto config = alphaOnly ? PixelConfig::ALPHA_8 : PixelConfig::RGBA_8888;
+  auto sampleCount = gl->caps->getSampleCount(TESSELLATION_SAMPLE_COUNT, config);
+  // The edges would be aliased without multisampling, leave the path to the CPU rasterizer.
+  if (sampleCount <= 1) {
+    return nullptr;
+  }
+  PathStencilProgramCreator creator = {};
+  auto program = static_cast<PathStencilProgram*>(context->getProgram(&creator));
+  if (program == nullptr) {
+    return nullptr;
+  }
+  auto texture = alphaOnly ? GLTexture::MakeAlpha(context, width, height)
+                           : GLTexture::MakeRGBA(context, width, height);
+  if (texture == nullptr) {
+    return nullptr;
+  }
+  auto renderTarget = GLRenderTarget::MakeFrom(context, texture.get(), sampleCount);
+  if (renderTarget == nullptr) {
+    return nullptr;
+  }
+  FanTessellator tessellator(matrix);
+  path.decompose(FanTessellator::Iterator, &tessellator);
+  auto& vertices = tessellator.vertices;
+  auto w = static_cast<float>(width);
+  auto h = static_cast<float>(height);
+  vertices.insert(vertices.end(), {0, 0, w, 0, 0, h, 0, h, w, 0, w, h});
+  GLStateGuard stateGuard(context);
+  CheckGLError(gl);
+  auto success = program->bindStencilBuffer(gl, width, height, renderTarget->sampleCount());
+  if (success) {
+    gl->bindFramebuffer(GL::FRAMEBUFFER, renderTarget->getGLInfo().id);
+    gl->framebufferRenderbuffer(GL::FRAMEBUFFER, GL::STENCIL_ATTACHMENT, GL::RENDERBUFFER,
+                                program->stencilBufferID());
+    success = gl->checkFramebufferStatus(GL::FRAMEBUFFER) == GL::FRAMEBUFFER_COMPLETE;
+  }
+  if (success) {
+    gl->viewport(0, 0, width, height);
+    gl->disable(GL::SCISSOR_TEST);
+    gl->disable(GL::BLEND);
+    gl->disable(GL::CULL_FACE);
+    gl->disable(GL::DEPTH_TEST);
+    gl->clearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    gl->clearStencil(0);
+    gl->stencilMask(0xFF);
+    gl->clear(GL::COLOR_BUFFER_BIT | GL::STENCIL_BUFFER_BIT);
+    // Maps the mask coordinates to the normalized device coordinates, the texture origin is the
+    // top-left corner.
+    float transform[4] = {2.0f / w, 2.0f / h, -1.0f, -1.0f};
+    gl->useProgram(program->programID);
+    gl->uniform4fv(program->transformLocation, 1, transform);
+    DrawStencilAndCover(gl, program, vertices, path.getFillType());
+    gl->framebufferRenderbuffer(GL::FRAMEBUFFER, GL::STENCIL_ATTACHMENT, GL::RENDERBUFFER, 0);
+  }
+  gl->bindRenderbuffer(GL::RENDERBUFFER, 0);
+  if (!CheckGLError(gl) || !success) {
+    return nullptr;
+  }
+  renderTarget->resolve(context);
+  return texture;
+}
+
+void GLPathTessellator::SetEnabled(bool enabled) {
+  tessellationEnabled = enabled;
+}
+
+bool GLPathTessellator::IsEnabled() {
+  return tessellationEnabled;
+}
+}  // namespace pag
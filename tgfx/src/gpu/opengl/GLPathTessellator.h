@@ -0,0 +1,62 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "gpu/Texture.h"
+#include "raster/Path.h"
+
+namespace pag {
+class Context;
+
+/**
+ * GLPathTessellator rasterizes the coverage masks of paths on the GPU. The path is flattened into
+ * triangle fans that are accumulated in a multisampled stencil buffer, and then the stencil is
+ * covered to produce the mask (stencil-then-cover). This skips the CPU scan conversion and the
+ * texture uploading, which dominate the frame time of large vector shapes.
+ */
+class GLPathTessellator {
+ public:
+  /**
+   * Returns a mask texture of the path transformed by the matrix, the size of the mask is
+   * (width, height). The path is tessellated on the GPU if it is large or complex enough to benefit
+   * from it, otherwise it is rasterized on the CPU.
+   */
+  static std::shared_ptr<Texture> MakeMask(Context* context, const Path& path,
+                                           const Matrix& matrix, int width, int height);
+
+  /**
+   * Tessellates the path on the GPU regardless of its size and complexity. Returns nullptr if the
+   * GPU doesn't support multisampled stencil buffers.
+   */
+  static std::shared_ptr<Texture> Tessellate(Context* context, const Path& path,
+                                             const Matrix& matrix, int width, int height);
+
+  /**
+   * Sets whether MakeMask() can tessellate paths on the GPU. If false, all masks are rasterized on
+   * the CPU. The multisampled edges differ slightly from the CPU rasterized ones, so it is disabled
+   * by default and can be enabled by PAG::SetPathTessellationEnabled(). The default value is false.
+   */
+  static void SetEnabled(bool enabled);
+
+  /**
+   * Returns true if MakeMask() can tessellate paths on the GPU.
+   */
+  static bool IsEnabled();
+};
+}  // namespace pag
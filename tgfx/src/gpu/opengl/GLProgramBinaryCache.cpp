@@ -0,0 +1,181 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GLProgramBinaryCache.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <vector>
+#include "core/Data.h"
+
+namespace pag {
+static constexpr uint32_t BinaryFileMagic = 0x50474C32;  // "PGL2"
+static constexpr uint64_t FNVOffsetBasis = 0xCBF29CE484222325ULL;
+
+struct BinaryFileHeader {
+  uint32_t magic = BinaryFileMagic;
+  uint32_t binaryFormat = 0;
+  uint32_t binaryLength = 0;
+  uint32_t reserved = 0;
+  uint64_t checksum = 0;
+};
+
+static std::mutex directoryLocker = {};
+static std::string cacheDirectory = {};
+static std::atomic_int tempFileCount = {0};
+
+static uint64_t HashBytes(uint64_t hash, const void* bytes, size_t length) {
+  // 64-bit FNV-1a.
+  auto data = static_cast<const uint8_t*>(bytes);
+  for (size_t i = 0; i < length; i++) {
+    hash ^= data[i];
+    hash *= 0x100000001B3ULL;
+  }
+  return hash;
+}
+
+static uint64_t HashString(uint64_t hash, const char* text) {
+  if (text == nullptr) {
+    return hash;
+  }
+  // Hash the terminator too, so "ab" + "c" and "a" + "bc" never collide.
+  return HashBytes(hash, text, strlen(text) + 1);
+}
+
+static std::string GetCachePath(const GLInterface* gl, const std::string& vertex,
+                                const std::string& fragment) {
+  auto directory = GLProgramBinaryCache::GetDirectory();
+  if (directory.empty()) {
+    return "";
+  }
+  uint64_t hash = FNVOffsetBasis;
+  hash = HashString(hash, vertex.c_str());
+  hash = HashString(hash, fragment.c_str());
+  hash = HashString(hash, reinterpret_cast<const char*>(gl->getString(GL::VENDOR)));
+  hash = HashString(hash, reinterpret_cast<const char*>(gl->getString(GL::RENDERER)));
+  hash = HashString(hash, reinterpret_cast<const char*>(gl->getString(GL::VERSION)));
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.glprog", static_cast<unsigned long long>(hash));
+  if (directory.back() != '/') {
+    directory += "/";
+  }
+  return directory + name;
+}
+
+// Returns a random token that stays the same during the lifetime of the process, so that the
+// temporary files written by different processes sharing the cache directory never collide.
+static uint64_t ProcessToken() {
+  static const uint64_t token = [] {
+    std::random_device device = {};
+    auto time = std::chrono::steady_clock::now().time_since_epoch().count();
+    return (static_cast<uint64_t>(device()) << 32 | device()) ^ static_cast<uint64_t>(time);
+  }();
+  return token;
+}
+
+void GLProgramBinaryCache::SetDirectory(const std::string& directory) {
+  std::lock_guard<std::mutex> autoLock(directoryLocker);
+  cacheDirectory = directory;
+}
+
+std::string GLProgramBinaryCache::GetDirectory() {
+  std::lock_guard<std::mutex> autoLock(directoryLocker);
+  return cacheDirectory;
+}
+
+unsigned GLProgramBinaryCache::LoadProgram(const GLInterface* gl, const std::string& vertex,
+                                           const std::string& fragment) {
+  if (!gl->caps->programBinarySupport) {
+    return 0;
+  }
+  auto filePath = GetCachePath(gl, vertex, fragment);
+  if (filePath.empty()) {
+    return 0;
+  }
+  auto data = Data::MakeFromFile(filePath);
+  if (data == nullptr || data->size() <= sizeof(BinaryFileHeader)) {
+    return 0;
+  }
+  BinaryFileHeader header = {};
+  memcpy(&header, data->data(), sizeof(BinaryFileHeader));
+  auto binary = static_cast<const uint8_t*>(data->data()) + sizeof(BinaryFileHeader);
+  auto length = data->size() - sizeof(BinaryFileHeader);
+  // A truncated or corrupted file may crash some drivers, so it is never passed to them.
+  if (header.magic != BinaryFileMagic || header.binaryLength != length ||
+      header.checksum != HashBytes(FNVOffsetBasis, binary, length)) {
+    return 0;
+  }
+  auto programHandle = gl->createProgram();
+  gl->programBinary(programHandle, header.binaryFormat, binary, static_cast<int>(length));
+  int success = 0;
+  gl->getProgramiv(programHandle, GL::LINK_STATUS, &success);
+  if (!success) {
+    // The driver rejected the binary, it is compiled again from the sources and saved over the
+    // stale file.
+    gl->deleteProgram(programHandle);
+    return 0;
+  }
+  return programHandle;
+}
+
+void GLProgramBinaryCache::SaveProgram(const GLInterface* gl, unsigned programID,
+                                       const std::string& vertex, const std::string& fragment) {
+  if (!gl->caps->programBinarySupport) {
+    return;
+  }
+  auto filePath = GetCachePath(gl, vertex, fragment);
+  if (filePath.empty()) {
+    return;
+  }
+  int length = 0;
+  gl->getProgramiv(programID, GL::PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+  std::vector<uint8_t> binary(static_cast<size_t>(length));
+  unsigned binaryFormat = 0;
+  gl->getProgramBinary(programID, length, &length, &binaryFormat, binary.data());
+  if (length <= 0) {
+    return;
+  }
+  // Write to a temporary file first and rename it, so a reader in another thread or process never
+  // sees a half-written binary.
+  char suffix[48];
+  snprintf(suffix, sizeof(suffix), ".%016llx.%d.tmp",
+           static_cast<unsigned long long>(ProcessToken()), tempFileCount++);
+  auto tempPath = filePath + suffix;
+  auto file = fopen(tempPath.c_str(), "wb");
+  if (file == nullptr) {
+    return;
+  }
+  BinaryFileHeader header = {};
+  header.binaryFormat = binaryFormat;
+  header.binaryLength = static_cast<uint32_t>(length);
+  header.checksum = HashBytes(FNVOffsetBasis, binary.data(), static_cast<size_t>(length));
+  auto written = fwrite(&header, sizeof(BinaryFileHeader), 1, file) == 1 &&
+                 fwrite(binary.data(), 1, static_cast<size_t>(length), file) ==
+                     static_cast<size_t>(length);
+  fclose(file);
+  if (!written || rename(tempPath.c_str(), filePath.c_str()) != 0) {
+    remove(tempPath.c_str());
+  }
+}
+}  // namespace pag
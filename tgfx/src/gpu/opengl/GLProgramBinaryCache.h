@@ -0,0 +1,56 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+#include "GLInterface.h"
+
+namespace pag {
+/**
+ * GLProgramBinaryCache stores linked programs as driver binaries on disk, so a later launch of the
+ * app can skip compiling and linking the same shaders. Entries are keyed by the shader sources and
+ * the GL vendor, renderer and version strings, a driver update simply misses the cache.
+ */
+class GLProgramBinaryCache {
+ public:
+  /**
+   * Sets the directory where program binaries are stored. Pass an empty string to disable the
+   * cache, which is the default. The directory must exist and be writable.
+   */
+  static void SetDirectory(const std::string& directory);
+
+  /**
+   * Returns the current cache directory, or an empty string if the cache is disabled.
+   */
+  static std::string GetDirectory();
+
+  /**
+   * Creates a program from the binary stored for the specified shaders. Returns 0 if the cache is
+   * disabled, there is no matching binary or the driver rejects it.
+   */
+  static unsigned LoadProgram(const GLInterface* gl, const std::string& vertex,
+                              const std::string& fragment);
+
+  /**
+   * Saves the binary of the linked program created from the specified shaders.
+   */
+  static void SaveProgram(const GLInterface* gl, unsigned programID, const std::string& vertex,
+                          const std::string& fragment);
+};
+}  // namespace pag
@@ -28,6 +28,10 @@ class GLRRectOp : public GLDrawOp {
  public:
   static std::unique_ptr<GLRRectOp> Make(RRect rRect);
 
+  std::string name() const override {
+    return "GLRRectOp";
+  }
+
   std::unique_ptr<GeometryProcessor> getGeometryProcessor(const DrawArgs& args) override;
 
   std::vector<float> vertices(const DrawArgs& args) override;
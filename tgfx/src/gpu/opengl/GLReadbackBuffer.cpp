@@ -0,0 +1,106 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GLReadbackBuffer.h"
+#include "GLContext.h"
+#include "GLUtil.h"
+
+namespace pag {
+static void ComputeRecycleKey(BytesKey* recycleKey, const ImageInfo& info) {
+  static const uint32_t Type = UniqueID::Next();
+  recycleKey->write(Type);
+  recycleKey->write(static_cast<uint32_t>(info.width()));
+  recycleKey->write(static_cast<uint32_t>(info.height()));
+  recycleKey->write(static_cast<uint32_t>(info.colorType()));
+}
+
+std::shared_ptr<GLReadbackBuffer> GLReadbackBuffer::Make(Context* context,
+                                                         const GLRenderTarget* renderTarget) {
+  if (context == nullptr || renderTarget == nullptr) {
+    return nullptr;
+  }
+  auto gl = GLContext::Unwrap(context);
+  if (!gl->caps->pixelBufferObjectSupport) {
+    return nullptr;
+  }
+  auto frameBuffer = renderTarget->getGLInfo();
+  auto alphaOnly = frameBuffer.format == GL::R8;
+  auto colorType = alphaOnly ? ColorType::ALPHA_8 : ColorType::RGBA_8888;
+  auto srcInfo = ImageInfo::Make(renderTarget->width(), renderTarget->height(), colorType,
+                                 AlphaType::Premultiplied);
+  BytesKey recycleKey = {};
+  ComputeRecycleKey(&recycleKey, srcInfo);
+  auto buffer =
+      std::static_pointer_cast<GLReadbackBuffer>(context->getRecycledResource(recycleKey));
+  if (buffer == nullptr) {
+    buffer = Resource::Wrap(context, new GLReadbackBuffer(srcInfo));
+    gl->genBuffers(1, &buffer->bufferID);
+    if (buffer->bufferID == 0) {
+      return nullptr;
+    }
+    gl->bindBuffer(GL::PIXEL_PACK_BUFFER, buffer->bufferID);
+    gl->bufferData(GL::PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(srcInfo.byteSize()), nullptr,
+                   GL::STREAM_READ);
+    gl->bindBuffer(GL::PIXEL_PACK_BUFFER, 0);
+  }
+  buffer->flipY = renderTarget->origin() == ImageOrigin::BottomLeft;
+  GLStateGuard stateGuard(context);
+  const auto& format =
+      gl->caps->getTextureFormat(alphaOnly ? PixelConfig::ALPHA_8 : PixelConfig::RGBA_8888);
+  gl->bindFramebuffer(GL::FRAMEBUFFER, frameBuffer.id);
+  gl->pixelStorei(GL::PACK_ALIGNMENT, alphaOnly ? 1 : 4);
+  gl->bindBuffer(GL::PIXEL_PACK_BUFFER, buffer->bufferID);
+  // The pixels are written into the buffer object, starting at offset zero.
+  gl->readPixels(0, 0, srcInfo.width(), srcInfo.height(), format.externalFormat,
+                 GL::UNSIGNED_BYTE, nullptr);
+  gl->bindBuffer(GL::PIXEL_PACK_BUFFER, 0);
+  if (!CheckGLError(gl)) {
+    return nullptr;
+  }
+  return buffer;
+}
+
+bool GLReadbackBuffer::readPixels(const ImageInfo& dstInfo, void* dstPixels) {
+  auto outInfo = dstInfo.makeIntersect(0, 0, srcInfo.width(), srcInfo.height());
+  if (outInfo.isEmpty() || dstPixels == nullptr) {
+    return false;
+  }
+  GLStateGuard stateGuard(context);
+  auto gl = GLContext::Unwrap(context);
+  gl->bindBuffer(GL::PIXEL_PACK_BUFFER, bufferID);
+  auto pixels = gl->mapBufferRange(GL::PIXEL_PACK_BUFFER, 0,
+                                   static_cast<GLsizeiptr>(srcInfo.byteSize()), GL::MAP_READ_BIT);
+  if (pixels != nullptr) {
+    CopyPixels(srcInfo, pixels, outInfo, dstPixels, flipY);
+    gl->unmapBuffer(GL::PIXEL_PACK_BUFFER);
+  }
+  gl->bindBuffer(GL::PIXEL_PACK_BUFFER, 0);
+  return pixels != nullptr;
+}
+
+void GLReadbackBuffer::computeRecycleKey(BytesKey* recycleKey) const {
+  ComputeRecycleKey(recycleKey, srcInfo);
+}
+
+void GLReadbackBuffer::onRelease(Context* context) {
+  if (bufferID > 0) {
+    GLContext::Unwrap(context)->deleteBuffers(1, &bufferID);
+    bufferID = 0;
+  }
+}
+}  // namespace pag
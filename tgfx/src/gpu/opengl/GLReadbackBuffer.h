@@ -0,0 +1,55 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "GLRenderTarget.h"
+#include "gpu/ReadbackBuffer.h"
+
+namespace pag {
+/**
+ * GLReadbackBuffer reads the pixels of a render target into a pixel pack buffer object. The
+ * glReadPixels() call returns without waiting for the GPU, and the pixels are mapped to the CPU
+ * later in readPixels().
+ */
+class GLReadbackBuffer : public ReadbackBuffer {
+ public:
+  /**
+   * Starts reading all pixels of the renderTarget into a pixel pack buffer. Returns nullptr if
+   * pixel buffer objects are not supported.
+   */
+  static std::shared_ptr<GLReadbackBuffer> Make(Context* context,
+                                                const GLRenderTarget* renderTarget);
+
+  bool readPixels(const ImageInfo& dstInfo, void* dstPixels) override;
+
+ protected:
+  void computeRecycleKey(BytesKey* recycleKey) const override;
+
+ private:
+  ImageInfo srcInfo = {};
+  bool flipY = false;
+  unsigned bufferID = 0;
+
+  explicit GLReadbackBuffer(const ImageInfo& srcInfo)
+      : ReadbackBuffer(srcInfo.width(), srcInfo.height()), srcInfo(srcInfo) {
+  }
+
+  void onRelease(Context* context) override;
+};
+}  // namespace pag
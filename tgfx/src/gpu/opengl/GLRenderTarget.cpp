@@ -20,7 +20,6 @@
 #include "GLContext.h"
 #include "GLState.h"
 #include "GLUtil.h"
-#include "image/Bitmap.h"
 
 namespace pag {
 std::shared_ptr<GLRenderTarget> GLRenderTarget::MakeFrom(Context* context,
@@ -35,27 +34,6 @@ std::shared_ptr<GLRenderTarget> GLRenderTarget::MakeFrom(Context* context,
   return Resource::Wrap(context, target);
 }
 
-static bool RenderbufferStorageMSAA(const GLInterface* gl, int sampleCount, unsigned format,
-                                    int width, int height) {
-  CheckGLError(gl);
-  switch (gl->caps->msFBOType) {
-    case MSFBOType::Standard:
-      gl->renderbufferStorageMultisample(GL::RENDERBUFFER, sampleCount, format, width, height);
-      break;
-    case MSFBOType::ES_Apple:
-      gl->renderbufferStorageMultisampleAPPLE(GL::RENDERBUFFER, sampleCount, format, width, height);
-      break;
-    case MSFBOType::ES_EXT_MsToTexture:
-    case MSFBOType::ES_IMG_MsToTexture:
-      gl->renderbufferStorageMultisampleEXT(GL::RENDERBUFFER, sampleCount, format, width, height);
-      break;
-    case MSFBOType::None:
-      LOGE("Shouldn't be here if we don't support multisampled renderbuffers.");
-      break;
-  }
-  return CheckGLError(gl);
-}
-
 static void FrameBufferTexture2D(const GLInterface* gl, unsigned textureTarget, unsigned textureID,
                                  int sampleCount) {
   // 解绑的时候framebufferTexture2DMultisample在华为手机上会出现crash，统一走framebufferTexture2D解绑
@@ -178,6 +156,31 @@ void GLRenderTarget::clear(const GLInterface* gl) const {
   gl->bindFramebuffer(GL::FRAMEBUFFER, oldFb);
 }
 
+void GLRenderTarget::clear(const GLInterface* gl, const Rect& rect) const {
+  auto bounds = rect;
+  bounds.roundOut();
+  if (!bounds.intersect(Rect::MakeWH(static_cast<float>(_width), static_cast<float>(_height)))) {
+    return;
+  }
+  auto x = static_cast<int>(bounds.x());
+  auto y = static_cast<int>(bounds.y());
+  auto width = static_cast<int>(bounds.width());
+  auto height = static_cast<int>(bounds.height());
+  if (_origin == ImageOrigin::BottomLeft) {
+    y = _height - y - height;
+  }
+  int oldFb = 0;
+  gl->getIntegerv(GL::FRAMEBUFFER_BINDING, &oldFb);
+  gl->bindFramebuffer(GL::FRAMEBUFFER, renderTargetFBInfo.id);
+  gl->viewport(0, 0, _width, _height);
+  gl->enable(GL::SCISSOR_TEST);
+  gl->scissor(x, y, width, height);
+  gl->clearColor(0.0f, 0.0f, 0.0f, 0.0f);
+  gl->clear(GL::COLOR_BUFFER_BIT | GL::STENCIL_BUFFER_BIT | GL::DEPTH_BUFFER_BIT);
+  gl->disable(GL::SCISSOR_TEST);
+  gl->bindFramebuffer(GL::FRAMEBUFFER, oldFb);
+}
+
 static bool CanReadDirectly(const GLInterface* gl, ImageOrigin origin, const ImageInfo& srcInfo,
                             const ImageInfo& dstInfo) {
   if (origin != ImageOrigin::TopLeft || dstInfo.alphaType() != srcInfo.alphaType() ||
@@ -190,27 +193,6 @@ static bool CanReadDirectly(const GLInterface* gl, ImageOrigin origin, const Ima
   return true;
 }
 
-static void CopyPixels(const ImageInfo& srcInfo, const void* srcPixels, const ImageInfo& dstInfo,
-                       void* dstPixels, bool flipY) {
-  auto pixels = srcPixels;
-  uint8_t* tempPixels = nullptr;
-  if (flipY) {
-    tempPixels = new uint8_t[srcInfo.byteSize()];
-    auto rowCount = srcInfo.height();
-    auto rowBytes = srcInfo.rowBytes();
-    auto dst = tempPixels;
-    for (int i = 0; i < rowCount; i++) {
-      auto src = reinterpret_cast<const uint8_t*>(srcPixels) + (rowCount - i - 1) * rowBytes;
-      memcpy(dst, src, rowBytes);
-      dst += rowBytes;
-    }
-    pixels = tempPixels;
-  }
-  Bitmap bitmap(srcInfo, pixels);
-  bitmap.readPixels(dstInfo, dstPixels);
-  delete[] tempPixels;
-}
-
 bool GLRenderTarget::readPixels(Context* context, const ImageInfo& dstInfo, void* dstPixels,
                                 int srcX, int srcY) const {
   dstPixels = dstInfo.computeOffset(dstPixels, -srcX, -srcY);
@@ -82,6 +82,12 @@ class GLRenderTarget : public Resource {
    */
   void clear(const GLInterface* gl) const;
 
+  /**
+   * Replacing all pixels inside the rect with transparent color. The rect is rounded out to pixel
+   * boundaries.
+   */
+  void clear(const GLInterface* gl, const Rect& rect) const;
+
   /**
    * Copies a rect of pixels to dstPixels with specified color type, alpha type and row bytes. Copy
    * starts at (srcX, srcY), and does not exceed Surface (width(), height()). Pixels are copied
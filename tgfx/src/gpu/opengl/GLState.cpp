@@ -749,6 +749,27 @@ class VertexBufferBinding : public GLAttribute {
   int buffer = 0;
 };
 
+class PixelPackBufferBinding : public GLAttribute {
+ public:
+  explicit PixelPackBufferBinding(const GLInterface* gl) {
+    gl->getIntegerv(GL::PIXEL_PACK_BUFFER_BINDING, &buffer);
+  }
+
+  GLAttributeType type() const override {
+    return GLAttributeType::PixelPackBufferBinding;
+  }
+
+  int priority() const override {
+    return PRIORITY_LOW;
+  }
+
+  void apply(GLState* state) const override {
+    state->gl->bindBuffer(GL::PIXEL_PACK_BUFFER, buffer);
+  }
+
+  int buffer = 0;
+};
+
 class DepthMask : public GLAttribute {
  public:
   explicit DepthMask(const GLInterface* gl) {
@@ -770,6 +791,137 @@ class DepthMask : public GLAttribute {
   unsigned char flag = false;
 };
 
+class ClearStencil : public GLAttribute {
+ public:
+  explicit ClearStencil(const GLInterface* gl) {
+    gl->getIntegerv(GL::STENCIL_CLEAR_VALUE, &value);
+  }
+
+  GLAttributeType type() const override {
+    return GLAttributeType::ClearStencil;
+  }
+
+  int priority() const override {
+    return PRIORITY_LOW;
+  }
+
+  void apply(GLState* state) const override {
+    state->gl->clearStencil(value);
+  }
+
+  int value = 0;
+};
+
+class ColorMask : public GLAttribute {
+ public:
+  explicit ColorMask(const GLInterface* gl) {
+    gl->getBooleanv(GL::COLOR_WRITEMASK, mask);
+  }
+
+  GLAttributeType type() const override {
+    return GLAttributeType::ColorMask;
+  }
+
+  int priority() const override {
+    return PRIORITY_LOW;
+  }
+
+  void apply(GLState* state) const override {
+    state->gl->colorMask(mask[0], mask[1], mask[2], mask[3]);
+  }
+
+  unsigned char mask[4] = {};
+};
+
+class StencilFunc : public GLAttribute {
+ public:
+  explicit StencilFunc(const GLInterface* gl) {
+    gl->getIntegerv(GL::STENCIL_FUNC, &frontFunc);
+    gl->getIntegerv(GL::STENCIL_REF, &frontRef);
+    gl->getIntegerv(GL::STENCIL_VALUE_MASK, &frontMask);
+    gl->getIntegerv(GL::STENCIL_BACK_FUNC, &backFunc);
+    gl->getIntegerv(GL::STENCIL_BACK_REF, &backRef);
+    gl->getIntegerv(GL::STENCIL_BACK_VALUE_MASK, &backMask);
+  }
+
+  GLAttributeType type() const override {
+    return GLAttributeType::StencilFunc;
+  }
+
+  int priority() const override {
+    return PRIORITY_LOW;
+  }
+
+  void apply(GLState* state) const override {
+    state->gl->stencilFuncSeparate(GL::FRONT, frontFunc, frontRef,
+                                   static_cast<unsigned>(frontMask));
+    state->gl->stencilFuncSeparate(GL::BACK, backFunc, backRef, static_cast<unsigned>(backMask));
+  }
+
+  int frontFunc = 0;
+  int frontRef = 0;
+  int frontMask = 0;
+  int backFunc = 0;
+  int backRef = 0;
+  int backMask = 0;
+};
+
+class StencilMask : public GLAttribute {
+ public:
+  explicit StencilMask(const GLInterface* gl) {
+    gl->getIntegerv(GL::STENCIL_WRITEMASK, &frontMask);
+    gl->getIntegerv(GL::STENCIL_BACK_WRITEMASK, &backMask);
+  }
+
+  GLAttributeType type() const override {
+    return GLAttributeType::StencilMask;
+  }
+
+  int priority() const override {
+    return PRIORITY_LOW;
+  }
+
+  void apply(GLState* state) const override {
+    state->gl->stencilMaskSeparate(GL::FRONT, static_cast<unsigned>(frontMask));
+    state->gl->stencilMaskSeparate(GL::BACK, static_cast<unsigned>(backMask));
+  }
+
+  int frontMask = 0;
+  int backMask = 0;
+};
+
+class StencilOp : public GLAttribute {
+ public:
+  explicit StencilOp(const GLInterface* gl) {
+    gl->getIntegerv(GL::STENCIL_FAIL, &frontFail);
+    gl->getIntegerv(GL::STENCIL_PASS_DEPTH_FAIL, &frontZFail);
+    gl->getIntegerv(GL::STENCIL_PASS_DEPTH_PASS, &frontZPass);
+    gl->getIntegerv(GL::STENCIL_BACK_FAIL, &backFail);
+    gl->getIntegerv(GL::STENCIL_BACK_PASS_DEPTH_FAIL, &backZFail);
+    gl->getIntegerv(GL::STENCIL_BACK_PASS_DEPTH_PASS, &backZPass);
+  }
+
+  GLAttributeType type() const override {
+    return GLAttributeType::StencilOp;
+  }
+
+  int priority() const override {
+    return PRIORITY_LOW;
+  }
+
+  void apply(GLState* state) const override {
+    state->gl->stencilOpSeparate(GL::FRONT, frontFail, frontZFail, frontZPass);
+    state->gl->stencilOpSeparate(GL::BACK, backFail, backZFail, backZPass);
+  }
+
+  int frontFail = 0;
+  int frontZFail = 0;
+  int frontZPass = 0;
+  int backFail = 0;
+  int backZFail = 0;
+  int backZPass = 0;
+};
+
 class Viewport : public GLAttribute {
  public:
   explicit Viewport(const GLInterface* gl) {
@@ -899,6 +1051,9 @@ void GLState::bindBuffer(unsigned target, unsigned buffer) {
         SAVE_DEFAULT(ElementBufferBinding)
       }
       break;
+    case GL::PIXEL_PACK_BUFFER:
+      SAVE_DEFAULT(PixelPackBufferBinding)
+      break;
     default:
       UNSUPPORTED_STATE_WARNING()
       break;
@@ -1064,6 +1219,37 @@ void GLState::depthMask(unsigned char flag) {
   gl->depthMask(flag);
 }
 
+void GLState::clearStencil(int s) {
+  SAVE_DEFAULT(ClearStencil)
+  gl->clearStencil(s);
+}
+
+void GLState::colorMask(unsigned char red, unsigned char green, unsigned char blue,
+                        unsigned char alpha) {
+  SAVE_DEFAULT(ColorMask)
+  gl->colorMask(red, green, blue, alpha);
+}
+
+void GLState::stencilFunc(unsigned func, int ref, unsigned mask) {
+  SAVE_DEFAULT(StencilFunc)
+  gl->stencilFunc(func, ref, mask);
+}
+
+void GLState::stencilMask(unsigned mask) {
+  SAVE_DEFAULT(StencilMask)
+  gl->stencilMask(mask);
+}
+
+void GLState::stencilOp(unsigned fail, unsigned zfail, unsigned zpass) {
+  SAVE_DEFAULT(StencilOp)
+  gl->stencilOp(fail, zfail, zpass);
+}
+
+void GLState::stencilOpSeparate(unsigned face, unsigned fail, unsigned zfail, unsigned zpass) {
+  SAVE_DEFAULT(StencilOp)
+  gl->stencilOpSeparate(face, fail, zfail, zpass);
+}
+
 void GLState::saveVertexAttribute(unsigned int index) {
   if (currentRecord && currentRecord->defaultVAO == currentVAO) {
     auto& vertexMap = currentRecord->vertexMap;
@@ -46,6 +46,7 @@ enum class GLAttributeType {
   RenderBufferBinding,
   PackAlignment,
   PackRowLength,
+  PixelPackBufferBinding,
   ScissorBox,
   TextureBinding,
   UnpackAlignment,
@@ -54,6 +55,11 @@ enum class GLAttributeType {
   VertexAttribute,
   VertexBufferBinding,
   DepthMask,
+  ClearStencil,
+  ColorMask,
+  StencilFunc,
+  StencilMask,
+  StencilOp,
   Viewport
 };
 
@@ -134,6 +140,18 @@ class GLState {
 
   void depthMask(unsigned char flag);
 
+  void clearStencil(int s);
+
+  void colorMask(unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha);
+
+  void stencilFunc(unsigned func, int ref, unsigned mask);
+
+  void stencilMask(unsigned mask);
+
+  void stencilOp(unsigned fail, unsigned zfail, unsigned zpass);
+
+  void stencilOpSeparate(unsigned face, unsigned fail, unsigned zfail, unsigned zpass);
+
   const GLInterface* gl = nullptr;
   unsigned currentVAO = 0;
   unsigned currentTextureUnit = 0;
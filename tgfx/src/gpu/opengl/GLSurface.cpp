@@ -19,6 +19,7 @@
 #include "GLSurface.h"
 #include "GLCaps.h"
 #include "GLContext.h"
+#include "GLReadbackBuffer.h"
 #include "GLUtil.h"
 
 namespace pag {
@@ -113,10 +114,10 @@ bool GLSurface::wait(const BackendSemaphore& semaphore) {
 }
 
 bool GLSurface::flush(BackendSemaphore* semaphore) {
+  if (canvas) {
+    canvas->flush();
+  }
   if (semaphore == nullptr) {
-    if (canvas) {
-      canvas->flush();
-    }
     return false;
   }
   const auto* gl = GLContext::Unwrap(getContext());
@@ -145,6 +146,15 @@ std::shared_ptr<Texture> GLSurface::getTexture() const {
   return texture;
 }
 
+std::shared_ptr<ReadbackBuffer> GLSurface::readPixelsAsync() {
+  if (canvas) {
+    canvas->flush();
+  }
+  auto context = getContext();
+  renderTarget->resolve(context);
+  return GLReadbackBuffer::Make(context, renderTarget.get());
+}
+
 bool GLSurface::onReadPixels(const ImageInfo& dstInfo, void* dstPixels, int srcX, int srcY) const {
   if (canvas) {
     canvas->flush();
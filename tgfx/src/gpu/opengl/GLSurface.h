@@ -55,6 +55,16 @@ class GLSurface : public Surface {
 
   std::shared_ptr<Texture> getTexture() const override;
 
+  /**
+   * Returns the texture backing this surface without flushing or resolving the pending draws.
+   * Returns nullptr if the surface is not backed by a texture.
+   */
+  std::shared_ptr<GLTexture> getBackingTexture() const {
+    return texture;
+  }
+
+  std::shared_ptr<ReadbackBuffer> readPixelsAsync() override;
+
  protected:
   bool onReadPixels(const ImageInfo& dstInfo, void* dstPixels, int srcX, int srcY) const override;
 
@@ -67,5 +77,7 @@ class GLSurface : public Surface {
             std::shared_ptr<GLTexture> texture = nullptr);
 
   friend class Surface;
+
+  friend class GLCanvas;
 };
 }  // namespace pag
@@ -17,6 +17,8 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GLUtil.h"
+#include "GLProgramBinaryCache.h"
+#include "image/Bitmap.h"
 
 namespace pag {
 GLVersion GetGLVersion(const char* versionString) {
@@ -149,12 +151,17 @@ void SubmitTexture(const GLInterface* gl, const GLTextureInfo& glInfo, const Tex
 
 unsigned CreateProgram(const GLInterface* gl, const std::string& vertex,
                        const std::string& fragment) {
+  auto cachedProgram = GLProgramBinaryCache::LoadProgram(gl, vertex, fragment);
+  if (cachedProgram != 0) {
+    return cachedProgram;
+  }
   auto vertexShader = LoadShader(gl, GL::VERTEX_SHADER, vertex);
   if (vertexShader == 0) {
     return 0;
   }
   auto fragmentShader = LoadShader(gl, GL::FRAGMENT_SHADER, fragment);
   if (fragmentShader == 0) {
+    gl->deleteShader(vertexShader);
     return 0;
   }
   auto programHandle = gl->createProgram();
@@ -166,7 +173,11 @@ unsigned CreateProgram(const GLInterface* gl, const std::string& vertex,
   if (!success) {
     char infoLog[512];
     gl->getProgramInfoLog(programHandle, 512, nullptr, infoLog);
+    LOGE("Could not link program: %s", infoLog);
     gl->deleteProgram(programHandle);
+    programHandle = 0;
+  } else {
+    GLProgramBinaryCache::SaveProgram(gl, programHandle, vertex, fragment);
   }
   gl->deleteShader(vertexShader);
   gl->deleteShader(fragmentShader);
@@ -200,6 +211,48 @@ bool CheckGLError(const GLInterface* gl) {
   return success;
 }
 
+bool RenderbufferStorageMSAA(const GLInterface* gl, int sampleCount, unsigned format, int width,
+                             int height) {
+  CheckGLError(gl);
+  switch (gl->caps->msFBOType) {
+    case MSFBOType::Standard:
+      gl->renderbufferStorageMultisample(GL::RENDERBUFFER, sampleCount, format, width, height);
+      break;
+    case MSFBOType::ES_Apple:
+      gl->renderbufferStorageMultisampleAPPLE(GL::RENDERBUFFER, sampleCount, format, width, height);
+      break;
+    case MSFBOType::ES_EXT_MsToTexture:
+    case MSFBOType::ES_IMG_MsToTexture:
+      gl->renderbufferStorageMultisampleEXT(GL::RENDERBUFFER, sampleCount, format, width, height);
+      break;
+    case MSFBOType::None:
+      LOGE("Shouldn't be here if we don't support multisampled renderbuffers.");
+      break;
+  }
+  return CheckGLError(gl);
+}
+
+void CopyPixels(const ImageInfo& srcInfo, const void* srcPixels, const ImageInfo& dstInfo,
+                void* dstPixels, bool flipY) {
+  auto pixels = srcPixels;
+  uint8_t* tempPixels = nullptr;
+  if (flipY) {
+    tempPixels = new uint8_t[srcInfo.byteSize()];
+    auto rowCount = srcInfo.height();
+    auto rowBytes = srcInfo.rowBytes();
+    auto dst = tempPixels;
+    for (int i = 0; i < rowCount; i++) {
+      auto src = reinterpret_cast<const uint8_t*>(srcPixels) + (rowCount - i - 1) * rowBytes;
+      memcpy(dst, src, rowBytes);
+      dst += rowBytes;
+    }
+    pixels = tempPixels;
+  }
+  Bitmap bitmap(srcInfo, pixels);
+  bitmap.readPixels(dstInfo, dstPixels);
+  delete[] tempPixels;
+}
+
 std::array<float, 9> ToGLMatrix(const Matrix& matrix) {
   float values[9];
   matrix.get9(values);
@@ -23,6 +23,7 @@
 
 #include "GLInterface.h"
 #include "gpu/opengl/GLContext.h"
+#include "image/ImageInfo.h"
 #include "pag/gpu.h"
 #include "pag/types.h"
 
@@ -54,6 +55,20 @@ void ActiveTexture(const GLInterface* gl, unsigned textureUnit, unsigned target,
 void SubmitTexture(const GLInterface* gl, const GLTextureInfo& glInfo, const TextureFormat& format,
                    int width, int height, size_t rowBytes, int bytesPerPixel, void* pixels);
 
+/**
+ * Allocates the storage of the currently bound renderbuffer with the multisample function the
+ * GL implementation supports.
+ */
+bool RenderbufferStorageMSAA(const GLInterface* gl, int sampleCount, unsigned format, int width,
+                             int height);
+
+/**
+ * Copies the pixels read from a frame buffer to dstPixels, converting them to the dstInfo and
+ * flipping the rows vertically if flipY is true.
+ */
+void CopyPixels(const ImageInfo& srcInfo, const void* srcPixels, const ImageInfo& dstInfo,
+                void* dstPixels, bool flipY);
+
 std::array<float, 9> ToGLMatrix(const Matrix& matrix);
 std::array<float, 9> ToGLVertexMatrix(const Matrix& matrix, int width, int height,
                                       ImageOrigin origin);
@@ -97,6 +97,12 @@ void* WebGLProcGetter::getProcAddress(const char* name) const {
   N(glRenderbufferStorage)
   N(glScissor)
   N(glShaderSource)
+  N(glStencilFunc)
+  N(glStencilFuncSeparate)
+  N(glStencilMask)
+  N(glStencilMaskSeparate)
+  N(glStencilOp)
+  N(glStencilOpSeparate)
   N(glTexImage2D)
   N(glTexParameterf)
   N(glTexParameterfv)
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "Bitmap.h"
+#include <vector>
 #include "Image.h"
 #include "platform/Platform.h"
 #include "skcms.h"
@@ -187,6 +188,81 @@ bool Bitmap::writePixels(const ImageInfo& srcInfo, const void* srcPixels, int ds
   return true;
 }
 
+static void AreaAverageRow(const uint8_t* src, int srcWidth, float scaleX, int bytesPerPixel,
+                           float* dst, int dstWidth) {
+  for (int x = 0; x < dstWidth; x++) {
+    auto left = static_cast<float>(x) * scaleX;
+    auto right = std::min(left + scaleX, static_cast<float>(srcWidth));
+    auto output = dst + x * bytesPerPixel;
+    for (int i = 0; i < bytesPerPixel; i++) {
+      output[i] = 0;
+    }
+    for (auto srcX = static_cast<int>(left); srcX < right; srcX++) {
+      auto weight = std::min(right, static_cast<float>(srcX + 1)) -
+                    std::max(left, static_cast<float>(srcX));
+      auto input = src + srcX * bytesPerPixel;
+      for (int i = 0; i < bytesPerPixel; i++) {
+        output[i] += weight * input[i];
+      }
+    }
+  }
+}
+
+static void AreaAverage(const ImageInfo& srcInfo, const void* srcPixels, const ImageInfo& dstInfo,
+                        void* dstPixels) {
+  auto bytesPerPixel = srcInfo.bytesPerPixel();
+  auto scaleX = static_cast<float>(srcInfo.width()) / static_cast<float>(dstInfo.width());
+  auto scaleY = static_cast<float>(srcInfo.height()) / static_cast<float>(dstInfo.height());
+  auto area = scaleX * scaleY;
+  auto count = static_cast<size_t>(dstInfo.width() * bytesPerPixel);
+  std::vector<float> row(count);
+  std::vector<float> sum(count);
+  for (int y = 0; y < dstInfo.height(); y++) {
+    auto top = static_cast<float>(y) * scaleY;
+    auto bottom = std::min(top + scaleY, static_cast<float>(srcInfo.height()));
+    std::fill(sum.begin(), sum.end(), 0.0f);
+    for (auto srcY = static_cast<int>(top); srcY < bottom; srcY++) {
+      auto weight = std::min(bottom, static_cast<float>(srcY + 1)) -
+                    std::max(top, static_cast<float>(srcY));
+      auto src = static_cast<const uint8_t*>(AddOffset(srcPixels, srcInfo.rowBytes() * srcY));
+      AreaAverageRow(src, srcInfo.width(), scaleX, bytesPerPixel, row.data(), dstInfo.width());
+      for (size_t i = 0; i < count; i++) {
+        sum[i] += weight * row[i];
+      }
+    }
+    auto dst = static_cast<uint8_t*>(AddOffset(dstPixels, dstInfo.rowBytes() * y));
+    for (size_t i = 0; i < count; i++) {
+      auto value = sum[i] / area + 0.5f;
+      dst[i] = static_cast<uint8_t>(std::min(value, 255.0f));
+    }
+  }
+}
+
+bool Bitmap::scalePixels(const ImageInfo& dstInfo, void* dstPixels) const {
+  if (_pixels == nullptr || dstPixels == nullptr || dstInfo.isEmpty() ||
+      dstInfo.width() > _info.width() || dstInfo.height() > _info.height()) {
+    return false;
+  }
+  if (dstInfo.width() == _info.width() && dstInfo.height() == _info.height()) {
+    return readPixels(dstInfo, dstPixels);
+  }
+  if (dstInfo.colorType() == _info.colorType() && dstInfo.alphaType() == _info.alphaType()) {
+    AreaAverage(_info, _pixels, dstInfo, dstPixels);
+    return true;
+  }
+  // Downsample in the source format first, then convert to the destination format.
+  auto tempInfo = ImageInfo::Make(dstInfo.width(), dstInfo.height(), _info.colorType(),
+                                  _info.alphaType());
+  auto tempPixels = new (std::nothrow) uint8_t[tempInfo.byteSize()];
+  if (tempPixels == nullptr) {
+    return false;
+  }
+  AreaAverage(_info, _pixels, tempInfo, tempPixels);
+  ConvertPixels(tempInfo, tempPixels, dstInfo, dstPixels);
+  delete[] tempPixels;
+  return true;
+}
+
 bool Bitmap::eraseAll() {
   if (_writablePixels == nullptr) {
     return false;
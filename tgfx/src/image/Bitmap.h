@@ -135,6 +135,13 @@ class Bitmap {
    */
   bool writePixels(const ImageInfo& srcInfo, const void* srcPixels, int dstX = 0, int dstY = 0);
 
+  /**
+   * Copies all pixels to dstPixels with specified ImageInfo, downsampling them to the dimensions of
+   * dstInfo by area averaging. The dimensions of dstInfo must not be larger than the Bitmap.
+   * Returns true if pixels are copied to dstPixels.
+   */
+  bool scalePixels(const ImageInfo& dstInfo, void* dstPixels) const;
+
   /**
    * Replaces all pixel values with transparent colors. Returns false if the bitmap is constructed
    * from read-only pixels.
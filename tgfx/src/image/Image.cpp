@@ -141,4 +141,46 @@ std::shared_ptr<TextureBuffer> Image::makeBuffer() const {
   auto result = readPixels(pixelBuffer->info(), bitmap.writablePixels());
   return result ? pixelBuffer : nullptr;
 }
-}  // namespace pag
\ No newline at end of file
+
+static int ScaleSize(int size, float scaleFactor) {
+  return std::max(static_cast<int>(ceilf(static_cast<float>(size) * scaleFactor)), 1);
+}
+
+std::shared_ptr<TextureBuffer> Image::makeBuffer(float scaleFactor) const {
+  if (scaleFactor <= 0 || scaleFactor >= 1.0f) {
+    return makeBuffer();
+  }
+  auto scaledWidth = ScaleSize(width(), scaleFactor);
+  auto scaledHeight = ScaleSize(height(), scaleFactor);
+  if (scaledWidth >= width() && scaledHeight >= height()) {
+    return makeBuffer();
+  }
+  auto pixelBuffer = PixelBuffer::Make(scaledWidth, scaledHeight, false);
+  if (pixelBuffer == nullptr) {
+    return nullptr;
+  }
+  Bitmap bitmap(pixelBuffer);
+  auto result = readScaledPixels(pixelBuffer->info(), bitmap.writablePixels());
+  return result ? pixelBuffer : nullptr;
+}
+
+bool Image::readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const {
+  if (dstPixels == nullptr || dstInfo.isEmpty()) {
+    return false;
+  }
+  if (dstInfo.width() == width() && dstInfo.height() == height()) {
+    return readPixels(dstInfo, dstPixels);
+  }
+  auto info = ImageInfo::Make(width(), height(), dstInfo.colorType(), dstInfo.alphaType());
+  auto pixels = new (std::nothrow) uint8_t[info.byteSize()];
+  if (pixels == nullptr) {
+    return false;
+  }
+  auto result = readPixels(info, pixels);
+  if (result) {
+    result = Bitmap(info, pixels).scalePixels(dstInfo, dstPixels);
+  }
+  delete[] pixels;
+  return result;
+}
+}  // namespace pag
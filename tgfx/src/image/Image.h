@@ -76,6 +76,14 @@ class Image {
    */
   virtual std::shared_ptr<TextureBuffer> makeBuffer() const;
 
+  /**
+   * Creates a new texture buffer capturing the pixels in this image, downscaled by the specified
+   * scale factor. The scale factor is clamped to (0, 1], the size of the returned buffer is the
+   * size of the image multiplied by the scale factor and rounded up. Decoders that support scaled
+   * decoding decode the image directly at the reduced size, which saves both time and memory.
+   */
+  virtual std::shared_ptr<TextureBuffer> makeBuffer(float scaleFactor) const;
+
   /**
    * Decodes the image with the specified image info into the given pixels. Returns true if the
    * decoding was successful.
@@ -89,6 +97,13 @@ class Image {
       : _width(width), _height(height), _orientation(orientation) {
   }
 
+  /**
+   * Decodes the image into the given pixels, downscaling it to the dimensions of dstInfo, which
+   * are never larger than the image. The default implementation decodes the image at full size and
+   * then downsamples it by area averaging. Returns true if the decoding was successful.
+   */
+  virtual bool readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const;
+
  private:
   int _width = 0;
   int _height = 0;
@@ -107,12 +107,55 @@ std::shared_ptr<Image> JpegImage::MakeFromData(const std::string& filePath,
                                               filePath, std::move(byteData)));
 }
 
+// libjpeg-turbo supports decoding at any scale of M/8, where M is from 1 to 16.
+static constexpr unsigned JPEG_SCALE_DENOM = 8;
+
+static int ScaledJpegSize(int size, unsigned scaleNum) {
+  return static_cast<int>((size * scaleNum + JPEG_SCALE_DENOM - 1) / JPEG_SCALE_DENOM);
+}
+
 bool JpegImage::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
+  return decode(dstInfo, dstPixels, JPEG_SCALE_DENOM);
+}
+
+bool JpegImage::readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const {
+  if (dstPixels == nullptr || dstInfo.isEmpty()) {
+    return false;
+  }
+  if (dstInfo.colorType() == ColorType::ALPHA_8) {
+    memset(dstPixels, 255, dstInfo.rowBytes() * dstInfo.height());
+    return true;
+  }
+  // Finds the smallest scale that is still no less than the requested size.
+  unsigned scaleNum = 1;
+  while (scaleNum < JPEG_SCALE_DENOM && (ScaledJpegSize(width(), scaleNum) < dstInfo.width() ||
+                                         ScaledJpegSize(height(), scaleNum) < dstInfo.height())) {
+    scaleNum++;
+  }
+  auto info = ImageInfo::Make(ScaledJpegSize(width(), scaleNum),
+                              ScaledJpegSize(height(), scaleNum), dstInfo.colorType(),
+                              dstInfo.alphaType());
+  if (info.width() == dstInfo.width() && info.height() == dstInfo.height()) {
+    return decode(dstInfo, dstPixels, scaleNum);
+  }
+  auto pixels = new (std::nothrow) uint8_t[info.byteSize()];
+  if (pixels == nullptr) {
+    return false;
+  }
+  auto result = decode(info, pixels, scaleNum);
+  if (result) {
+    result = Bitmap(info, pixels).scalePixels(dstInfo, dstPixels);
+  }
+  delete[] pixels;
+  return result;
+}
+
+bool JpegImage::decode(const ImageInfo& dstInfo, void* dstPixels, unsigned scaleNum) const {
   if (dstPixels == nullptr || dstInfo.isEmpty()) {
     return false;
   }
   if (dstInfo.colorType() == ColorType::ALPHA_8) {
-    memset(dstPixels, 255, dstInfo.rowBytes() * height());
+    memset(dstPixels, 255, dstInfo.rowBytes() * dstInfo.height());
     return true;
   }
   FILE* infile = nullptr;
@@ -137,10 +180,17 @@ bool JpegImage::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
     } else if (dstInfo.colorType() == ColorType::BGRA_8888) {
       cinfo.out_color_space = JCS_EXT_BGRA;
     }
+    cinfo.scale_num = scaleNum;
+    cinfo.scale_denom = JPEG_SCALE_DENOM;
     if (!jpeg_start_decompress(&cinfo)) break;
+    if (cinfo.output_width > static_cast<JDIMENSION>(dstInfo.width()) ||
+        cinfo.output_height > static_cast<JDIMENSION>(dstInfo.height())) {
+      jpeg_abort_decompress(&cinfo);
+      break;
+    }
     JSAMPROW pRow[1];
     int line = 0;
-    JDIMENSION h = height();
+    JDIMENSION h = cinfo.output_height;
     while (cinfo.output_scanline < h) {
       pRow[0] = (JSAMPROW)(static_cast<unsigned char*>(dstPixels) + dstInfo.rowBytes() * line);
       jpeg_read_scanlines(&cinfo, pRow, 1);
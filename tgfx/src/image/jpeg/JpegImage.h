@@ -35,12 +35,17 @@ class JpegImage : public Image {
  protected:
   bool readPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
 
+  bool readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
+
  private:
   std::shared_ptr<Data> fileData;
   const std::string filePath;
 
   static std::shared_ptr<Image> MakeFromData(const std::string& filePath,
                                              std::shared_ptr<Data> byteData);
+
+  bool decode(const ImageInfo& dstInfo, void* dstPixels, unsigned scaleNum) const;
+
   explicit JpegImage(int width, int height, Orientation orientation, std::string filePath,
                      std::shared_ptr<Data> fileData)
       : Image(width, height, orientation),
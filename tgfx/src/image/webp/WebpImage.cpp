@@ -80,12 +80,21 @@ bool WebpImage::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
     return false;
   }
   config.output.is_external_memory = 1;
+  auto dstWidth = dstInfo.width();
+  auto dstHeight = dstInfo.height();
+  if (dstWidth != width() || dstHeight != height()) {
+    // Lets libwebp downsample the image while decoding, which is much cheaper than decoding at full
+    // size and scaling it afterwards.
+    config.options.use_scaling = 1;
+    config.options.scaled_width = dstWidth;
+    config.options.scaled_height = dstHeight;
+  }
   bool decodeSuccess = true;
   if (dstInfo.colorType() == ColorType::ALPHA_8) {
     // decode to RGBA_8888
     config.output.colorspace = webp_decode_mode(ColorType::RGBA_8888, false);
-    config.output.u.RGBA.stride = width() * ImageInfo::GetBytesPerPixel(ColorType::RGBA_8888);
-    config.output.u.RGBA.size = config.output.u.RGBA.stride * height();
+    config.output.u.RGBA.stride = dstWidth * ImageInfo::GetBytesPerPixel(ColorType::RGBA_8888);
+    config.output.u.RGBA.size = config.output.u.RGBA.stride * dstHeight;
     auto pixels = new (std::nothrow) uint8_t[config.output.u.RGBA.size];
     if (pixels) {
       config.output.u.RGBA.rgba = pixels;
@@ -93,7 +102,7 @@ bool WebpImage::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
       // convert to ALPHA_8
       if (decodeSuccess) {
         auto info =
-            ImageInfo::Make(width(), height(), ColorType::RGBA_8888, AlphaType::Unpremultiplied);
+            ImageInfo::Make(dstWidth, dstHeight, ColorType::RGBA_8888, AlphaType::Unpremultiplied);
         Bitmap bitmap(info, pixels);
         decodeSuccess = bitmap.readPixels(dstInfo, dstPixels);
       }
@@ -104,7 +113,7 @@ bool WebpImage::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
         webp_decode_mode(dstInfo.colorType(), dstInfo.alphaType() == AlphaType::Premultiplied);
     config.output.u.RGBA.rgba = reinterpret_cast<uint8_t*>(dstPixels);
     config.output.u.RGBA.stride = static_cast<int>(dstInfo.rowBytes());
-    config.output.u.RGBA.size = dstInfo.rowBytes() * height();
+    config.output.u.RGBA.size = dstInfo.rowBytes() * dstHeight;
     auto code = WebPDecode(byteData->bytes(), byteData->size(), &config);
     decodeSuccess = code == VP8_STATUS_OK;
   }
@@ -112,6 +121,11 @@ bool WebpImage::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
   return decodeSuccess;
 }
 
+bool WebpImage::readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const {
+  // readPixels() decodes the image at the size of dstInfo.
+  return readPixels(dstInfo, dstPixels);
+}
+
 #ifdef TGFX_USE_WEBP_ENCODE
 struct WebpWriter {
   unsigned char* data = nullptr;
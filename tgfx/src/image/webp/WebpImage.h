@@ -38,6 +38,8 @@ class WebpImage : public Image {
  protected:
   bool readPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
 
+  bool readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
+
  private:
   std::shared_ptr<Data> fileData;
   std::string filePath;
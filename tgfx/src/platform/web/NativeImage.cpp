@@ -55,4 +55,10 @@ std::shared_ptr<NativeImage> NativeImage::MakeFrom(emscripten::val nativeImage)
 std::shared_ptr<TextureBuffer> NativeImage::makeBuffer() const {
   return NativeTextureBuffer::Make(width(), height(), nativeImage);
 }
+
+std::shared_ptr<TextureBuffer> NativeImage::makeBuffer(float) const {
+  // The pixels of a native image are uploaded by the browser, they can not be decoded at a reduced
+  // size.
+  return makeBuffer();
+}
 }  // namespace pag
@@ -29,6 +29,8 @@ class NativeImage : public Image {
 
   std::shared_ptr<TextureBuffer> makeBuffer() const override;
 
+  std::shared_ptr<TextureBuffer> makeBuffer(float scaleFactor) const override;
+
   bool readPixels(const ImageInfo& /*dstInfo*/, void* /*dstPixels*/) const override {
     return false;
   }
@@ -175,6 +175,14 @@ bool Path::isEmpty() const {
   return pathRef->path.isEmpty();
 }
 
+int Path::countVerbs() const {
+  return pathRef->path.countVerbs();
+}
+
+int Path::countPoints() const {
+  return pathRef->path.countPoints();
+}
+
 bool Path::contains(float x, float y) const {
   return pathRef->path.contains(x, y);
 }
@@ -387,9 +395,46 @@ void Path::decompose(const PathIterator& iterator, void* info) const {
   }
 }
 
+struct ContentHash {
+  uint64_t value = 14695981039346656037ULL;
+
+  void write(const void* bytes, size_t length) {
+    auto data = static_cast<const uint8_t*>(bytes);
+    for (size_t i = 0; i < length; i++) {
+      value ^= data[i];
+      value *= 1099511628211ULL;
+    }
+  }
+};
+
+static void HashIterator(PathVerb verb, const Point points[4], void* info) {
+  static const int PointCounts[] = {1, 2, 3, 4, 0};
+  auto hash = reinterpret_cast<ContentHash*>(info);
+  auto verbValue = static_cast<uint8_t>(verb);
+  hash->write(&verbValue, sizeof(verbValue));
+  hash->write(points, sizeof(Point) * PointCounts[verbValue]);
+}
+
+uint64_t Path::getContentHash() const {
+  auto value = pathRef->contentHash.load(std::memory_order_relaxed);
+  if (value != 0) {
+    return value;
+  }
+  ContentHash hash = {};
+  auto fillType = static_cast<uint8_t>(pathRef->path.getFillType());
+  hash.write(&fillType, sizeof(fillType));
+  decompose(HashIterator, &hash);
+  // 0 is reserved for the hash that is not computed yet.
+  value = hash.value == 0 ? 1 : hash.value;
+  pathRef->contentHash.store(value, std::memory_order_relaxed);
+  return value;
+}
+
 PathRef* Path::writableRef() {
   if (!pathRef.unique()) {
     pathRef = std::make_shared<PathRef>(pathRef->path);
+  } else {
+    pathRef->contentHash = 0;
   }
   return pathRef.get();
 }
@@ -90,6 +90,16 @@ class Path {
    */
   bool isEmpty() const;
 
+  /**
+   * Returns the number of verbs in the path, including move, line, quad, cubic and close verbs.
+   */
+  int countVerbs() const;
+
+  /**
+   * Returns the number of points in the path.
+   */
+  int countPoints() const;
+
   /**
    * Returns true if the point (x, y) is contained by Path, taking into account PathFillType.
    */
@@ -238,6 +248,12 @@ class Path {
    */
   void decompose(const PathIterator& iterator, void* info = nullptr) const;
 
+  /**
+   * Returns a hash of the fill type, verbs and points of the path. The hash is computed on the
+   * first call and cached until the path is modified. Equal paths always have the same hash.
+   */
+  uint64_t getContentHash() const;
+
  private:
   std::shared_ptr<PathRef> pathRef = nullptr;
 
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <atomic>
 #include "pathkit.h"
 
 namespace pag {
@@ -36,6 +37,8 @@ class PathRef {
 
  private:
   pk::SkPath path = {};
+  // The hash of the path content, 0 if it is not computed yet.
+  std::atomic<uint64_t> contentHash = {0};
 
   friend class Path;
   friend bool operator==(const Path& a, const Path& b);
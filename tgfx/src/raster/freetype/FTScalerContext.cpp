@@ -180,8 +180,9 @@ static FT_Int ChooseBitmapStrike(FT_Face face, FT_F26Dot6 scaleY) {
 
 FTScalerContext::FTScalerContext(std::shared_ptr<Typeface> typeFace, FTScalerContextRec rec)
     : typeface(std::move(typeFace)), rec(rec) {
-  std::lock_guard<std::mutex> lockGuard(FTMutex());
-  _face = static_cast<FTTypeface*>(typeface.get())->_face.get();
+  // The face is owned by this context until it is destroyed, so the FreeType calls below need no
+  // locking. Only opening and closing faces have to hold the library-wide FTMutex().
+  _face = static_cast<FTTypeface*>(typeface.get())->acquireFace();
   loadGlyphFlags |= FT_LOAD_NO_BITMAP;
   // Always using FT_LOAD_IGNORE_GLOBAL_ADVANCE_WIDTH to get correct
   // advances, as fontconfig and cairo do.
@@ -261,9 +262,9 @@ FTScalerContext::FTScalerContext(std::shared_ptr<Typeface> typeFace, FTScalerCon
 
 FTScalerContext::~FTScalerContext() {
   if (ftSize) {
-    std::lock_guard<std::mutex> lockGuard(FTMutex());
     FT_Done_Size(ftSize);
   }
+  static_cast<FTTypeface*>(typeface.get())->releaseFace(_face);
 }
 
 int FTScalerContext::setupSize() {
@@ -276,7 +277,6 @@ int FTScalerContext::setupSize() {
 }
 
 FontMetrics FTScalerContext::generateFontMetrics() {
-  std::lock_guard<std::mutex> lockGuard(FTMutex());
   FontMetrics metrics;
   if (setupSize()) {
     return metrics;
@@ -518,7 +518,6 @@ static bool GenerateGlyphPath(FT_Face face, Path* path) {
 }
 
 bool FTScalerContext::generatePath(GlyphID glyphID, Path* path) {
-  std::lock_guard<std::mutex> lockGuard(FTMutex());
   auto face = _face->face;
   // FT_IS_SCALABLE is documented to mean the face contains outline glyphs.
   if (!FT_IS_SCALABLE(face) || this->setupSize()) {
@@ -555,7 +554,6 @@ void FTScalerContext::getBBoxForCurrentGlyph(FT_BBox* bbox) {
 }
 
 GlyphMetrics FTScalerContext::generateGlyphMetrics(GlyphID glyphID) {
-  std::lock_guard<std::mutex> lockGuard(FTMutex());
   GlyphMetrics glyph;
   if (setupSize()) {
     return glyph;
@@ -645,7 +643,6 @@ void CopyFTBitmap(const FT_Bitmap& bitmap, std::shared_ptr<PixelBuffer> pixelBuf
 }
 
 std::shared_ptr<TextureBuffer> FTScalerContext::generateImage(GlyphID glyphId, Matrix* matrix) {
-  std::lock_guard<std::mutex> lockGuard(FTMutex());
   if (setupSize()) {
     return nullptr;
   }
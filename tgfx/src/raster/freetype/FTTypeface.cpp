@@ -111,15 +111,44 @@ std::shared_ptr<FTTypeface> FTTypeface::Make(FTFontData data) {
   return typeface;
 }
 
+// A FT_Face can only be used by one thread at a time, so each typeface keeps a few faces opened
+// from the same font data to let different threads rasterize it in parallel.
+static constexpr size_t MAX_FACE_COUNT = 4;
+
 FTTypeface::FTTypeface(FTFontData data, std::unique_ptr<FTFace> face)
     : _uniqueID(UniqueID::Next()), data(std::move(data)), _face(std::move(face)) {
+  idleFaces.push_back(_face.get());
 }
 
 FTTypeface::~FTTypeface() {
   std::lock_guard<std::mutex> lockGuard(FTMutex());
+  extraFaces.clear();
   _face = nullptr;
 }
 
+FTFace* FTTypeface::acquireFace() {
+  std::unique_lock<std::mutex> autoLock(locker);
+  if (idleFaces.empty() && extraFaces.size() + 1 < MAX_FACE_COUNT) {
+    auto face = FTFace::Make(data);
+    if (face != nullptr) {
+      idleFaces.push_back(face.get());
+      extraFaces.push_back(std::move(face));
+    }
+  }
+  condition.wait(autoLock, [this] { return !idleFaces.empty(); });
+  auto face = idleFaces.back();
+  idleFaces.pop_back();
+  return face;
+}
+
+void FTTypeface::releaseFace(FTFace* face) {
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    idleFaces.push_back(face);
+  }
+  condition.notify_one();
+}
+
 int FTTypeface::GetUnitsPerEm(FT_Face face) {
   auto unitsPerEm = face->units_per_EM;
   // At least some versions of FreeType set face->units_per_EM to 0 for bitmap only fonts.
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
 #include "ft2build.h"
 #include FT_FREETYPE_H
 
@@ -75,10 +77,25 @@ class FTTypeface : public Typeface {
  private:
   FTTypeface(FTFontData data, std::unique_ptr<FTFace> face);
 
+  /**
+   * Takes an idle FTFace for exclusive use by the calling thread. A new FTFace is opened from the
+   * font data if all existing ones are busy, up to MAX_FACE_COUNT, after which the caller waits.
+   */
+  FTFace* acquireFace();
+
+  /**
+   * Returns a face previously taken by acquireFace().
+   */
+  void releaseFace(FTFace* face);
+
   ID _uniqueID;
   FTFontData data;
   std::unique_ptr<FTFace> _face;
   std::weak_ptr<FTTypeface> weakThis;
+  std::mutex locker = {};
+  std::condition_variable condition = {};
+  std::vector<std::unique_ptr<FTFace>> extraFaces = {};
+  std::vector<FTFace*> idleFaces = {};
 
   friend class FTScalerContext;
 };